@@ -0,0 +1,56 @@
+#include "allocation_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<size_t> allocations{0};
+std::atomic<size_t> allocated_bytes{0};
+
+/**
+ * @brief Allocate memory and count the allocation.
+ * @param size The size of the allocation in bytes.
+ * @return The allocated memory.
+ */
+void *counted_allocate(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    void *memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+} // namespace
+
+AllocationCount get_allocation_count() {
+    return {allocations.load(std::memory_order_relaxed),
+            allocated_bytes.load(std::memory_order_relaxed)};
+}
+
+// Replace the global allocation functions, so that every allocation made by the interpreter is
+// counted
+void *operator new(size_t size) {
+    return counted_allocate(size);
+}
+
+void *operator new[](size_t size) {
+    return counted_allocate(size);
+}
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, [[maybe_unused]] size_t size) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void *memory, [[maybe_unused]] size_t size) noexcept {
+    std::free(memory);
+}
@@ -0,0 +1,24 @@
+#ifndef SYNTHSCRIPT_ALLOCATIONCOUNTER_H
+#define SYNTHSCRIPT_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+/**
+ * @struct AllocationCount
+ * @brief The number of heap allocations made by the process, and their total size.
+ *
+ * @note
+ * Only allocations made through the global operator new are counted.
+ */
+struct AllocationCount {
+    size_t allocations = 0;
+    size_t bytes = 0;
+};
+
+/**
+ * @brief Get the number of heap allocations made since the program started.
+ * @return The allocation count.
+ */
+AllocationCount get_allocation_count();
+
+#endif // SYNTHSCRIPT_ALLOCATIONCOUNTER_H
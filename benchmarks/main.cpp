@@ -0,0 +1,294 @@
+#include "allocation_counter.h"
+#include "error_manager.h"
+#include "lexer.h"
+#include "parser.h"
+#include "reader.h"
+#include "visitor/compiler_visitor.h"
+#include "visitor/interpreter_visitor.h"
+#include "visitor/semantic_analysis_visitor.h"
+#include "vm/virtual_machine.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+#ifdef _WIN32
+// clang-format off
+#include <windows.h>
+#include <psapi.h>
+// clang-format on
+#else
+#include <sys/resource.h>
+#endif
+
+/**
+ * @struct StageResult
+ * @brief The measurements of one stage of the pipeline, over every iteration.
+ */
+struct StageResult {
+    std::string name;
+    std::vector<double> times_ms;
+
+    /**
+     * @brief The allocations made by the stage (in the last iteration).
+     */
+    AllocationCount allocation_count;
+
+    /**
+     * @brief The peak resident set size of the process after the stage, in kilobytes.
+     */
+    long peak_rss_kb = 0;
+};
+
+/**
+ * @struct BenchmarkResult
+ * @brief The measurements of a benchmark program.
+ */
+struct BenchmarkResult {
+    std::string name;
+    std::string status = "success";
+    std::vector<StageResult> stages;
+};
+
+/**
+ * @struct BenchmarkOptions
+ * @brief The command line options of the benchmark runner.
+ */
+struct BenchmarkOptions {
+    int iterations = 3;
+    std::string programs_directory = SYNTHSCRIPT_BENCHMARK_DIR;
+    std::string output_path;
+    std::vector<std::string> names;
+};
+
+long get_peak_rss_kb();
+void write_data_files(const std::filesystem::path &directory);
+BenchmarkResult run_benchmark(const std::filesystem::path &path, int iterations);
+void write_json(std::ostream &stream, const std::vector<BenchmarkResult> &results, int iterations);
+void print_usage();
+
+int main(int argc, char *argv[]) {
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument.rfind("--iterations=", 0) == 0) {
+            options.iterations = std::max(1, std::atoi(argument.c_str() + 13));
+        } else if (argument.rfind("--programs=", 0) == 0) {
+            options.programs_directory = argument.substr(11);
+        } else if (argument.rfind("--output=", 0) == 0) {
+            options.output_path = argument.substr(9);
+        } else if (argument.rfind("--", 0) != 0) {
+            options.names.push_back(argument);
+        } else {
+            print_usage();
+            return 127;
+        }
+    }
+
+    // The benchmark programs, sorted by name
+    std::vector<std::filesystem::path> programs;
+    for (auto &entry : std::filesystem::directory_iterator(options.programs_directory)) {
+        std::string name = entry.path().stem().string();
+        bool selected = options.names.empty() || std::find(options.names.begin(),
+                                                           options.names.end(),
+                                                           name) != options.names.end();
+        if (entry.path().extension() == ".ss" && selected) {
+            programs.push_back(std::filesystem::absolute(entry.path()));
+        }
+    }
+    std::sort(programs.begin(), programs.end());
+
+    // The programs read their input files from the working directory
+    std::filesystem::path data_directory =
+        std::filesystem::temp_directory_path() / "synthscript_benchmarks";
+    write_data_files(data_directory);
+    std::filesystem::path original_directory = std::filesystem::current_path();
+    std::filesystem::current_path(data_directory);
+
+    std::vector<BenchmarkResult> results;
+    for (auto &program : programs) {
+        std::cerr << "Running " << program.stem().string() << "..." << std::endl;
+        results.push_back(run_benchmark(program, options.iterations));
+    }
+
+    std::filesystem::current_path(original_directory);
+
+    if (options.output_path.empty()) {
+        write_json(std::cout, results, options.iterations);
+    } else {
+        std::ofstream stream(options.output_path);
+        write_json(stream, results, options.iterations);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+long get_peak_rss_kb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return (long)(counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    // Reported in bytes on macOS, and in kilobytes elsewhere
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+void write_data_files(const std::filesystem::path &directory) {
+    std::filesystem::create_directories(directory);
+
+    // Words for the word count (about 200 KB)
+    std::ofstream words(directory / "words.txt");
+    for (int i = 0; i < 40000; i++) {
+        words << "word" << i % 97 << (i % 13 == 0 ? "  " : " ");
+    }
+
+    // A large text file (about 16 MB)
+    std::ofstream large(directory / "large.txt");
+    std::string line = "The quick brown fox jumps over the lazy dog, again and again and again.\n";
+    for (size_t size = 0; size < 16 * 1024 * 1024; size += line.size()) {
+        large << line;
+    }
+}
+
+BenchmarkResult run_benchmark(const std::filesystem::path &path, int iterations) {
+    BenchmarkResult result;
+    result.name = path.stem().string();
+
+    // Discard the output of the program (and any errors)
+    std::ostringstream discarded;
+    std::streambuf *cout_buffer = std::cout.rdbuf(discarded.rdbuf());
+
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        size_t stage = 0;
+        auto measure = [&](const std::string &name, auto &&function) {
+            if (result.stages.size() <= stage) {
+                result.stages.push_back({name, {}, {}, 0});
+            }
+            StageResult &stage_result = result.stages[stage++];
+
+            AllocationCount start_count = get_allocation_count();
+            auto start_time = std::chrono::steady_clock::now();
+            function();
+            auto end_time = std::chrono::steady_clock::now();
+            AllocationCount end_count = get_allocation_count();
+
+            stage_result.times_ms.push_back(
+                std::chrono::duration<double, std::milli>(end_time - start_time).count());
+            stage_result.allocation_count = {end_count.allocations - start_count.allocations,
+                                             end_count.bytes - start_count.bytes};
+            stage_result.peak_rss_kb = get_peak_rss_kb();
+        };
+
+        ErrorManager error_manager;
+        Reader reader(path.string(), &error_manager);
+        std::string_view code;
+        std::vector<Token> tokens;
+        ProgramNode *program = nullptr;
+
+        measure("reader", [&]() {
+            code = reader.read_file();
+            error_manager.set_source(&reader.get_source());
+        });
+        measure("lexer", [&]() {
+            Lexer lexer(code, &error_manager);
+            tokens = lexer.parse_tokens();
+        });
+        measure("parser", [&]() {
+            Parser parser(tokens, &error_manager);
+            program = parser.parse_program();
+        });
+        measure("semantic_analysis", [&]() {
+            SemanticAnalysisVisitor semantic_analysis_visitor(program, &error_manager);
+            semantic_analysis_visitor.analyze();
+        });
+
+        if (error_manager.get_status() == ErrorManager::BuildStatus::FAILURE) {
+            result.status = "build_failure";
+            delete program;
+            break;
+        }
+
+        // Run the program on both engines
+        measure("interpreter", [&]() {
+            try {
+                InterpreterVisitor interpreter_visitor(program, &error_manager);
+                interpreter_visitor.interpret();
+            } catch (const std::runtime_error &e) {
+                result.status = "runtime_error";
+            }
+        });
+
+        std::unique_ptr<BytecodeProgram> bytecode;
+        measure("compiler", [&]() {
+            CompilerVisitor compiler_visitor(program, &error_manager);
+            bytecode.reset(compiler_visitor.compile());
+        });
+        measure("virtual_machine", [&]() {
+            try {
+                VirtualMachine virtual_machine(bytecode.get(), &error_manager);
+                virtual_machine.run();
+            } catch (const std::runtime_error &e) {
+                result.status = "runtime_error";
+            }
+        });
+
+        delete program;
+    }
+
+    std::cout.rdbuf(cout_buffer);
+    return result;
+}
+
+void write_json(std::ostream &stream, const std::vector<BenchmarkResult> &results, int iterations) {
+    stream << "{\n";
+    stream << "  \"iterations\": " << iterations << ",\n";
+    stream << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult &result = results[i];
+        stream << (i == 0 ? "\n" : ",\n");
+        stream << "    {\n";
+        stream << "      \"name\": \"" << result.name << "\",\n";
+        stream << "      \"status\": \"" << result.status << "\",\n";
+        stream << "      \"stages\": [";
+
+        for (size_t j = 0; j < result.stages.size(); j++) {
+            const StageResult &stage = result.stages[j];
+            double min_ms = *std::min_element(stage.times_ms.begin(), stage.times_ms.end());
+            double total_ms = 0;
+            for (double time_ms : stage.times_ms) {
+                total_ms += time_ms;
+            }
+
+            stream << (j == 0 ? "\n" : ",\n");
+            stream << "        {\"name\": \"" << stage.name << "\", \"min_ms\": " << min_ms
+                   << ", \"mean_ms\": " << total_ms / (double)stage.times_ms.size()
+                   << ", \"allocations\": " << stage.allocation_count.allocations
+                   << ", \"allocated_bytes\": " << stage.allocation_count.bytes
+                   << ", \"peak_rss_kb\": " << stage.peak_rss_kb << "}";
+        }
+
+        stream << "\n      ]\n";
+        stream << "    }";
+    }
+    stream << "\n  ]\n";
+    stream << "}\n";
+}
+
+void print_usage() {
+    std::cout << "Usage: benchmarks [options] [names...]" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --iterations=<n>   Run each program n times (default 3)" << std::endl;
+    std::cout << "  --programs=<dir>   Run the .ss programs in a directory" << std::endl;
+    std::cout << "  --output=<path>    Write the JSON report to a file instead of stdout"
+              << std::endl;
+}
@@ -1,7 +1,10 @@
 #ifndef SYNTHSCRIPT_ASTNODE_H
 #define SYNTHSCRIPT_ASTNODE_H
 
+#include "visitor/closure_compiler_visitor.h"
+#include "visitor/compiler_visitor.h"
 #include "visitor/interpreter_visitor.h"
+#include "visitor/optimizer_visitor.h"
 #include "visitor/print_visitor.h"
 #include "visitor/semantic_analysis_visitor.h"
 
@@ -10,6 +13,7 @@ typedef enum {
     CALL_NODE,
     CAST_OP_NODE,
     SUBSCRIPT_OP_NODE,
+    SLICE_OP_NODE,
     UNARY_OP_NODE,
     ARRAY_LITERAL_NODE,
     RANGE_LITERAL_NODE,
@@ -41,8 +45,20 @@ public:
 
     virtual void accept(PrintVisitor *visitor, int arg) = 0;
     virtual void analyze(SemanticAnalysisVisitor *visitor, class SymbolTable *table) = 0;
-    virtual std::shared_ptr<Object> evaluate(InterpreterVisitor *visitor,
-                                             class SymbolTable *table) = 0;
+    virtual Value evaluate(InterpreterVisitor *visitor, class SymbolTable *table) = 0;
+    virtual int compile(CompilerVisitor *visitor, int dest) = 0;
+
+    /**
+     * @brief Optimize the node and its children.
+     * @return The node to replace this node with (the node itself if it is kept).
+     */
+    virtual ASTNode *optimize(OptimizerVisitor *visitor, int arg) = 0;
+
+    /**
+     * @brief Compile the node and its children into a closure.
+     * @return The closure, which evaluates the node in a scope.
+     */
+    virtual Closure bind(ClosureCompilerVisitor *visitor, int arg) = 0;
 
 private:
     int line;
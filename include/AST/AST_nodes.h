@@ -1,5 +1,6 @@
 #include "AST/operators/bin_op_node.h"
 #include "AST/operators/cast_op_node.h"
+#include "AST/operators/slice_op_node.h"
 #include "AST/operators/subscript_op_node.h"
 #include "AST/operators/unary_op_node.h"
 #include "AST/operators/call_op_node.h"
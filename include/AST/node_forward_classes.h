@@ -1,9 +1,11 @@
 #ifndef SYNTHSCRIPT_NODEFORWARDCLASSES_H
 #define SYNTHSCRIPT_NODEFORWARDCLASSES_H
 
+class ASTNode;
 class BinOpNode;
 class CastOpNode;
 class SubscriptOpNode;
+class SliceOpNode;
 class UnaryOpNode;
 class ArrayLiteralNode;
 class RangeLiteralNode;
@@ -2,12 +2,15 @@
 #define SYNTHSCRIPT_BINOPNODE_H
 
 #include "AST/AST_node.h"
+#include "AST/type_feedback.h"
 #include "AST/visit_functions_macro.h"
+#include "operators.h"
 
 class BinOpNode : public ASTNode {
 public:
     BinOpNode(TokenType op, ASTNode *left, ASTNode *right, int line, int col)
-        : ASTNode(line, col), op(op), left(left), right(right) {}
+        : ASTNode(line, col), op(op), binary_operator(to_binary_operator(op)), left(left),
+          right(right) {}
     ~BinOpNode() override {
         delete left;
         delete right;
@@ -17,15 +20,35 @@ public:
     static NodeType get_node_type_static() { return BIN_OP_NODE; }
 
     TokenType get_op() { return op; }
+    BinaryOperator get_binary_operator() const { return binary_operator; }
     ASTNode *get_left_node() { return left; }
     ASTNode *get_right_node() { return right; }
+    void set_left_node(ASTNode *left) { this->left = left; }
+    void set_right_node(ASTNode *right) { this->right = right; }
+
+    TypeFeedback &get_feedback() { return feedback; }
+    BinaryKernel get_kernel() const { return kernel; }
+    void set_kernel(BinaryKernel kernel) { this->kernel = kernel; }
 
     DECLARE_VISITOR_FUNCTIONS
 
 private:
     TokenType op;
+
+    /**
+     * @brief The operator of the token, resolved once for the kernel table.
+     */
+    BinaryOperator binary_operator;
+
     ASTNode *left;
     ASTNode *right;
+
+    /**
+     * @brief The operand types seen by the interpreter, and the kernel for them once the node is
+     * monomorphic.
+     */
+    TypeFeedback feedback;
+    BinaryKernel kernel = nullptr;
 };
 
 #endif // SYNTHSCRIPT_BINOPNODE_H
@@ -3,6 +3,7 @@
 
 #include "AST/AST_node.h"
 #include "AST/visit_functions_macro.h"
+#include "symbol/variable_slot.h"
 #include <utility>
 #include <vector>
 
@@ -19,17 +20,43 @@ public:
     NodeType get_node_type() const override { return CALL_NODE; }
     static NodeType get_node_type_static() { return CALL_NODE; }
 
-    std::string get_identifier() const { return identifier; }
+    const std::string &get_identifier() const { return identifier; }
 
     std::vector<ASTNode *> *get_arguments() { return &arguments; }
     size_t get_arguments_size() { return arguments.size(); }
     ASTNode *get_argument(size_t index) { return arguments[index]; }
 
+    const VariableSlot &get_slot() const { return slot; }
+    void set_slot(const VariableSlot &slot) { this->slot = slot; }
+
+    int get_built_in_id() const { return built_in_id; }
+    void set_built_in_id(int built_in_id) { this->built_in_id = built_in_id; }
+
+    bool is_tail_call() const { return tail_call; }
+    void set_tail_call(bool tail_call) { this->tail_call = tail_call; }
+
     DECLARE_VISITOR_FUNCTIONS
 
 private:
     std::string identifier;
     std::vector<ASTNode *> arguments;
+
+    /**
+     * @brief The location of the called function (set by semantic analysis).
+     */
+    VariableSlot slot;
+
+    /**
+     * @brief The id of the called built-in function, or -1 if the function is declared in the
+     * program (set by semantic analysis).
+     */
+    int built_in_id = -1;
+
+    /**
+     * @brief If the call is the value of a return statement, so that its result is returned
+     * directly (set by semantic analysis).
+     */
+    bool tail_call = false;
 };
 
 #endif // SYNTHSCRIPT_CALLOPNODE_H
@@ -2,6 +2,7 @@
 #define SYNTHSCRIPT_CASTOPNODE_H
 
 #include "AST/AST_node.h"
+#include "AST/type_feedback.h"
 #include "AST/visit_functions_macro.h"
 #include <utility>
 
@@ -16,12 +17,19 @@ public:
 
     Type get_type() const { return type; }
     ASTNode *get_operand() const { return operand; }
+    void set_operand(ASTNode *operand) { this->operand = operand; }
+    TypeFeedback &get_feedback() { return feedback; }
 
     DECLARE_VISITOR_FUNCTIONS
 
 private:
     Type type;
     ASTNode *operand;
+
+    /**
+     * @brief The type of the operand seen by the interpreter.
+     */
+    TypeFeedback feedback;
 };
 
 #endif // SYNTHSCRIPT_CASTOPNODE_H
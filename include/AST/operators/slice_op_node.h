@@ -0,0 +1,38 @@
+#ifndef SYNTHSCRIPT_SLICEOPNODE_H
+#define SYNTHSCRIPT_SLICEOPNODE_H
+
+#include "AST/AST_node.h"
+#include "AST/visit_functions_macro.h"
+
+/**
+ * @class SliceOpNode
+ * @brief A slice of an array or string, such as arr[start..end] (inclusive of both).
+ */
+class SliceOpNode : public ASTNode {
+public:
+    SliceOpNode(ASTNode *identifier, ASTNode *start, ASTNode *end, int line, int col)
+        : ASTNode(line, col), identifier(identifier), start(start), end(end) {}
+    ~SliceOpNode() override {
+        delete identifier;
+        delete start;
+        delete end;
+    }
+
+    NodeType get_node_type() const override { return SLICE_OP_NODE; }
+    static NodeType get_node_type_static() { return SLICE_OP_NODE; }
+
+    ASTNode *get_identifier() { return identifier; }
+    ASTNode *get_start() { return start; }
+    ASTNode *get_end() { return end; }
+    void set_identifier(ASTNode *identifier) { this->identifier = identifier; }
+    void set_start(ASTNode *start) { this->start = start; }
+    void set_end(ASTNode *end) { this->end = end; }
+    DECLARE_VISITOR_FUNCTIONS
+
+private:
+    ASTNode *identifier;
+    ASTNode *start;
+    ASTNode *end;
+};
+
+#endif // SYNTHSCRIPT_SLICEOPNODE_H
@@ -2,6 +2,7 @@
 #define SYNTHSCRIPT_SUBSCRIPTOPNODE_H
 
 #include "AST/AST_node.h"
+#include "AST/type_feedback.h"
 #include "AST/visit_functions_macro.h"
 
 class SubscriptOpNode : public ASTNode {
@@ -18,11 +19,20 @@ public:
 
     ASTNode *get_identifier() { return identifier; }
     ASTNode *get_index() { return index; }
+    void set_identifier(ASTNode *identifier) { this->identifier = identifier; }
+    void set_index(ASTNode *index) { this->index = index; }
+    TypeFeedback &get_feedback() { return feedback; }
+
     DECLARE_VISITOR_FUNCTIONS
 
 private:
     ASTNode *identifier;
     ASTNode *index;
+
+    /**
+     * @brief The types of the subscripted value and the index seen by the interpreter.
+     */
+    TypeFeedback feedback;
 };
 
 #endif // SYNTHSCRIPT_SUBSCRIPTOPNODE_H
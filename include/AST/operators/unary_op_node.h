@@ -3,23 +3,32 @@
 
 #include "AST/AST_node.h"
 #include "AST/visit_functions_macro.h"
+#include "operators.h"
 
 class UnaryOpNode : public ASTNode {
 public:
     UnaryOpNode(TokenType op, ASTNode *operand, int line, int col)
-        : ASTNode(line, col), op(op), operand(operand) {}
+        : ASTNode(line, col), op(op), unary_operator(to_unary_operator(op)), operand(operand) {}
     ~UnaryOpNode() override { delete operand; }
 
     NodeType get_node_type() const override { return UNARY_OP_NODE; }
     static NodeType get_node_type_static() { return UNARY_OP_NODE; }
 
     TokenType get_op() { return op; }
+    UnaryOperator get_unary_operator() const { return unary_operator; }
     ASTNode *get_operand() { return operand; }
+    void set_operand(ASTNode *operand) { this->operand = operand; }
 
     DECLARE_VISITOR_FUNCTIONS
 
 private:
     TokenType op;
+
+    /**
+     * @brief The operator of the token, resolved once for the kernel table.
+     */
+    UnaryOperator unary_operator;
+
     ASTNode *operand;
 };
 
@@ -23,10 +23,20 @@ public:
     size_t get_statements_size() { return statements.size(); }
     ASTNode *get_statement(size_t index) { return statements[index]; }
 
+    const std::vector<std::string> &get_global_names() const { return global_names; }
+    void set_global_names(std::vector<std::string> global_names) {
+        this->global_names = std::move(global_names);
+    }
+
     DECLARE_VISITOR_FUNCTIONS
 
 private:
     std::vector<ASTNode *> statements;
+
+    /**
+     * @brief The name of each global variable slot (set by semantic analysis).
+     */
+    std::vector<std::string> global_names;
 };
 
 #endif // SYNTHSCRIPT_PROGRAMNODE_H
@@ -18,6 +18,8 @@ public:
 
     ASTNode *get_start() { return start; }
     ASTNode *get_end() { return end; }
+    void set_start(ASTNode *start) { this->start = start; }
+    void set_end(ASTNode *end) { this->end = end; }
 
     DECLARE_VISITOR_FUNCTIONS
 
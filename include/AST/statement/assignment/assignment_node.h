@@ -3,6 +3,7 @@
 
 #include "AST/AST_node.h"
 #include "AST/visit_functions_macro.h"
+#include "symbol/variable_slot.h"
 
 class AssignmentNode : public ASTNode {
 public:
@@ -18,12 +19,25 @@ public:
 
     ASTNode *get_identifier() { return identifier; }
     ASTNode *get_value() { return value; }
+    void set_identifier(ASTNode *identifier) { this->identifier = identifier; }
+    void set_value(ASTNode *value) { this->value = value; }
+
+    const VariableSlot &get_slot() const { return slot; }
+    void set_slot(const VariableSlot &slot) { this->slot = slot; }
 
     DECLARE_VISITOR_FUNCTIONS
 
 private:
     ASTNode *identifier;
     ASTNode *value;
+
+    /**
+     * @brief The location of the assigned variable (set by semantic analysis).
+     *
+     * @note
+     * Only resolved if the assignment is to an identifier (not to an array element).
+     */
+    VariableSlot slot;
 };
 
 #endif // SYNTHSCRIPT_ASSIGNMENTNODE_H
@@ -20,6 +20,8 @@ public:
     std::string get_identifier() const { return identifier; }
     ASTNode *get_iterable() const { return iterable; }
     ASTNode *get_body() const { return body; }
+    void set_iterable(ASTNode *iterable) { this->iterable = iterable; }
+    void set_body(ASTNode *body) { this->body = body; }
 
     DECLARE_VISITOR_FUNCTIONS
 
@@ -23,6 +23,10 @@ public:
     bool has_else_body() { return else_body != nullptr; }
     ASTNode *get_else_body() { return else_body; }
 
+    void set_condition(ASTNode *condition) { this->condition = condition; }
+    void set_if_body(ASTNode *if_body) { this->if_body = if_body; }
+    void set_else_body(ASTNode *else_body) { this->else_body = else_body; }
+
     DECLARE_VISITOR_FUNCTIONS
 
 private:
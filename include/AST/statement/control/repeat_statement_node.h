@@ -18,6 +18,8 @@ public:
 
     ASTNode *get_count() { return count; }
     ASTNode *get_body() { return body; }
+    void set_count(ASTNode *count) { this->count = count; }
+    void set_body(ASTNode *body) { this->body = body; }
 
     DECLARE_VISITOR_FUNCTIONS
 
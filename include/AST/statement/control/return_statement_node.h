@@ -14,6 +14,7 @@ public:
 
     bool has_value() { return value != nullptr; }
     ASTNode *get_value() { return value; }
+    void set_value(ASTNode *value) { this->value = value; }
 
     DECLARE_VISITOR_FUNCTIONS
 
@@ -18,6 +18,8 @@ public:
 
     ASTNode *get_condition() { return condition; }
     ASTNode *get_body() { return body; }
+    void set_condition(ASTNode *condition) { this->condition = condition; }
+    void set_body(ASTNode *body) { this->body = body; }
 
     DECLARE_VISITOR_FUNCTIONS
 
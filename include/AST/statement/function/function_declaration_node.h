@@ -19,6 +19,7 @@ public:
     size_t get_parameters_size() { return parameters.size(); }
     std::string get_parameter(size_t index) { return parameters[index]; }
     ASTNode *get_body() { return body; }
+    void set_body(ASTNode *body) { this->body = body; }
 
     DECLARE_VISITOR_FUNCTIONS
 
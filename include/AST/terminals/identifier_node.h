@@ -3,6 +3,7 @@
 
 #include "AST/AST_node.h"
 #include "AST/visit_functions_macro.h"
+#include "symbol/variable_slot.h"
 #include <utility>
 
 class IdentifierNode : public ASTNode {
@@ -16,10 +17,18 @@ public:
 
     std::string get_name() const { return name; }
 
+    const VariableSlot &get_slot() const { return slot; }
+    void set_slot(const VariableSlot &slot) { this->slot = slot; }
+
     DECLARE_VISITOR_FUNCTIONS
 
 private:
     std::string name;
+
+    /**
+     * @brief The location of the variable (set by semantic analysis).
+     */
+    VariableSlot slot;
 };
 
 #endif // SYNTHSCRIPT_IDENTIFIERNODE_H
@@ -8,6 +8,14 @@ class LiteralNode : public ASTNode {
 public:
     LiteralNode(Type type, std::string value, int line, int col)
         : ASTNode(line, col), type(type), value(std::move(value)) {}
+
+    /**
+     * @brief Construct a literal of a value computed at compile time.
+     * @param value The text of the value, as it would be written in the code.
+     * @param constant The value.
+     */
+    LiteralNode(Type type, std::string value, Value constant, int line, int col)
+        : ASTNode(line, col), type(type), value(std::move(value)), constant(std::move(constant)) {}
     ~LiteralNode() override = default;
 
     NodeType get_node_type() const override { return LITERAL_NODE; }
@@ -16,11 +24,20 @@ public:
     Type get_type() { return type; }
     std::string get_value() { return value; }
 
+    bool has_constant() const { return constant.is_defined(); }
+    const Value &get_constant() const { return constant; }
+    void set_constant(const Value &constant) { this->constant = constant; }
+
     DECLARE_VISITOR_FUNCTIONS
 
 private:
     Type type;
     std::string value;
+
+    /**
+     * @brief The value of the literal, if it was materialized by the optimizer.
+     */
+    Value constant;
 };
 
 #endif // SYNTHSCRIPT_LITERALNODE_H
@@ -0,0 +1,62 @@
+#ifndef SYNTHSCRIPT_TYPEFEEDBACK_H
+#define SYNTHSCRIPT_TYPEFEEDBACK_H
+
+#include "object/value.h"
+#include <cstdint>
+
+/**
+ * @brief The specialization an operator node has been quickened to by the tree-walking interpreter.
+ */
+enum Quickening : uint8_t {
+    QUICK_UNINITIALIZED, // Not evaluated yet
+    QUICK_INT,           // Int operands, evaluated inline
+    QUICK_FLOAT,         // Float operands, evaluated inline
+    QUICK_STRING,        // String operands, compared inline
+    QUICK_ARRAY_INT,     // An array subscripted with an int
+    QUICK_MONOMORPHIC,   // A single combination of other types, through the kernel recorded for it
+    QUICK_GENERIC        // Deoptimized after seeing more than one combination of types
+};
+
+/**
+ * @struct TypeFeedback
+ * @brief The operand types an operator node has seen, and the specialization chosen for them.
+ *
+ * A node starts uninitialized, and is quickened to a specialization for the types of its operands
+ * the first time it is evaluated. Later evaluations check the types against the recorded ones (the
+ * guard), and a mismatch deoptimizes the node to the generic operation for good, so a node whose
+ * types vary does not keep switching between specializations.
+ */
+struct TypeFeedback {
+    Quickening state = QUICK_UNINITIALIZED;
+    Type first = TYPE_UNDEF;
+    Type second = TYPE_UNDEF;
+
+    /**
+     * @brief Check if the types of the operands match the recorded ones.
+     * @param first The type of the first operand.
+     * @param second The type of the second operand (TYPE_UNDEF for a single operand).
+     * @return True if the specialization applies.
+     */
+    bool matches(Type first, Type second = TYPE_UNDEF) const {
+        return this->first == first && this->second == second;
+    }
+
+    /**
+     * @brief Record the types of the operands of the first evaluation.
+     * @param state The specialization for the types.
+     * @param first The type of the first operand.
+     * @param second The type of the second operand (TYPE_UNDEF for a single operand).
+     */
+    void quicken(Quickening state, Type first, Type second = TYPE_UNDEF) {
+        this->state = state;
+        this->first = first;
+        this->second = second;
+    }
+
+    /**
+     * @brief Fall back to the generic operation, after a guard has failed.
+     */
+    void deoptimize() { state = QUICK_GENERIC; }
+};
+
+#endif // SYNTHSCRIPT_TYPEFEEDBACK_H
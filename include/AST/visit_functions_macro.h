@@ -8,8 +8,17 @@
     void analyze(SemanticAnalysisVisitor *visitor, SymbolTable *table) override {                  \
         return visitor->visit(this, table);                                                        \
     }                                                                                              \
-    std::shared_ptr<Object> evaluate(InterpreterVisitor *visitor, SymbolTable *table) override {   \
+    Value evaluate(InterpreterVisitor *visitor, SymbolTable *table) override {                     \
         return visitor->visit(this, table);                                                        \
+    }                                                                                              \
+    int compile(CompilerVisitor *visitor, int dest) override {                                     \
+        return visitor->visit(this, dest);                                                         \
+    }                                                                                              \
+    ASTNode *optimize(OptimizerVisitor *visitor, int arg) override {                               \
+        return visitor->visit(this, arg);                                                          \
+    }                                                                                              \
+    Closure bind(ClosureCompilerVisitor *visitor, int arg) override {                              \
+        return visitor->visit(this, arg);                                                          \
     }
 
 #endif // SYNTHSCRIPT_VISITFUNCTIONSMACRO_H
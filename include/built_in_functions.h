@@ -2,8 +2,14 @@
 #define SYNTHSCRIPT_BUILTINFUNCTIONS_H
 
 #include "error_manager.h"
+#include "object/file_object.h"
+#include "source_buffer.h"
 #include "symbol/symbol_table.h"
-#include <functional>
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+
+class BuiltInFunctions;
 
 /**
  * @struct BuiltInFunction
@@ -11,13 +17,18 @@
  */
 struct BuiltInFunction {
     /**
-     * @brief The function that the built-in function calls.
-     * @param arguments The arguments to the function.
+     * @brief The name of the function.
+     */
+    const char *name;
+
+    /**
+     * @brief The member function that the built-in function calls.
+     * @param arguments The arguments to the function (param_count of them).
      * @param line The line number where the function was called.
      * @param col The column number where the function was called.
      * @return The result of the function.
      */
-    std::function<std::shared_ptr<Object>(std::vector<std::shared_ptr<Object>>, int, int)> function;
+    Value (BuiltInFunctions::*function)(const Value *arguments, int line, int col);
 
     /**
      * @brief The number of parameters the function takes.
@@ -25,17 +36,8 @@ struct BuiltInFunction {
     int param_count;
 };
 
-#define BUILT_IN_FUNCTION(name, param_count, instance)                                             \
-    {                                                                                              \
-        #name, {                                                                                   \
-            [instance](std::vector<std::shared_ptr<Object>> arguments,                             \
-                       int line,                                                                   \
-                       int col) -> std::shared_ptr<Object> {                                       \
-                return instance->built_in_##name(&arguments, line, col);                           \
-            },                                                                                     \
-                param_count                                                                        \
-        }                                                                                          \
-    }
+#define BUILT_IN_FUNCTION(name, param_count)                                                      \
+    { #name, &BuiltInFunctions::built_in_##name, param_count }
 
 /**
  * @class BuiltInFunctions
@@ -52,6 +54,11 @@ public:
      */
     BuiltInFunctions(ErrorManager *error_manager);
 
+    /**
+     * @brief Flush the buffered output and appends, also when the program ends with an error.
+     */
+    ~BuiltInFunctions();
+
     /**
      * @brief Register the built-in functions with the given symbol table.
      * @param symbol_table The symbol table to register the built-in functions with.
@@ -59,48 +66,107 @@ public:
     void register_built_in_functions(SymbolTable *symbol_table);
 
     /**
-     * @brief Handle a built-in function call.
-     * @param identifier The identifier of the built-in function.
-     * @param arguments The arguments to the function.
+     * @brief Create a function object for each built-in function.
+     * @return The name and function object of each built-in function, sorted by name.
+     */
+    std::vector<std::pair<std::string, Value>> create_function_objects();
+
+    /**
+     * @brief The maximum number of parameters of a built-in function.
+     */
+    static constexpr int MAX_PARAMETERS = 2;
+
+    /**
+     * @brief Get the number of built-in functions.
+     * @return The number of built-in functions, whose ids are 0 to the number - 1.
+     */
+    static int get_count();
+
+    /**
+     * @brief Get a built-in function.
+     * @param id The id of the function (its index in the order of the names).
+     * @return The built-in function.
+     */
+    static const BuiltInFunction &get(int id);
+
+    /**
+     * @brief Call a built-in function.
+     * @param id The id of the function.
+     * @param arguments The arguments to the function, which must be as many as its parameters.
      * @param line The line number where the function was called.
      * @param col The column number where the function was called.
      * @return The result of the function.
      */
-    std::shared_ptr<Object>
-    handle_built_in_function(const std::string &identifier,
-                             std::vector<std::shared_ptr<Object>> *arguments,
-                             int line,
-                             int col);
-
-    std::shared_ptr<Object>
-    built_in_output(std::vector<std::shared_ptr<Object>> *arguments, int line, int col);
-    std::shared_ptr<Object>
-    built_in_input(std::vector<std::shared_ptr<Object>> *arguments, int line, int col);
-    std::shared_ptr<Object>
-    built_in_read(std::vector<std::shared_ptr<Object>> *arguments, int line, int col);
-    std::shared_ptr<Object>
-    built_in_write(std::vector<std::shared_ptr<Object>> *arguments, int line, int col);
-    std::shared_ptr<Object>
-    built_in_append(std::vector<std::shared_ptr<Object>> *arguments, int line, int col);
-    std::shared_ptr<Object>
-    built_in_current_directory(std::vector<std::shared_ptr<Object>> *arguments, int line, int col);
-    std::shared_ptr<Object>
-    built_in_len(std::vector<std::shared_ptr<Object>> *arguments, int line, int col);
-    std::shared_ptr<Object>
-    built_in_sum(std::vector<std::shared_ptr<Object>> *arguments, int line, int col);
-    std::shared_ptr<Object>
-    built_in_product(std::vector<std::shared_ptr<Object>> *arguments, int line, int col);
+    Value call(int id, const Value *arguments, int line, int col) {
+        return (this->*get(id).function)(arguments, line, col);
+    }
 
-private:
     /**
-     * @brief Maps identifiers to their built-in function.
+     * @brief Write the buffered output and the buffered appends to files, which is done when the
+     * program ends, by the flush built-in function, and before files are read or written.
+     *
+     * @note
+     * The output is buffered by the standard output stream: it is written line by line to a
+     * terminal, and in large blocks otherwise. Errors are written unbuffered, after any output.
      */
-    std::unordered_map<std::string, BuiltInFunction> built_in_functions;
+    void flush();
+
+    Value built_in_output(const Value *arguments, int line, int col);
+    Value built_in_input(const Value *arguments, int line, int col);
+    Value built_in_read(const Value *arguments, int line, int col);
+    Value built_in_write(const Value *arguments, int line, int col);
+    Value built_in_append(const Value *arguments, int line, int col);
+    Value built_in_current_directory(const Value *arguments, int line, int col);
+    Value built_in_len(const Value *arguments, int line, int col);
+    Value built_in_sum(const Value *arguments, int line, int col);
+    Value built_in_product(const Value *arguments, int line, int col);
+    Value built_in_push(const Value *arguments, int line, int col);
+    Value built_in_replicate(const Value *arguments, int line, int col);
+    Value built_in_open(const Value *arguments, int line, int col);
+    Value built_in_lines(const Value *arguments, int line, int col);
+    Value built_in_read_line(const Value *arguments, int line, int col);
+    Value built_in_read_chunk(const Value *arguments, int line, int col);
+    Value built_in_close(const Value *arguments, int line, int col);
+    Value built_in_flush(const Value *arguments, int line, int col);
 
+private:
     /**
      * @brief The error manager to use for error handling.
      */
     ErrorManager *error_manager;
+
+    /**
+     * @brief The maximum number of files kept open by append.
+     */
+    static constexpr size_t MAX_APPEND_STREAMS = 16;
+
+    /**
+     * @brief The files opened by append, by canonical path, which are kept open for the next
+     * appends (so every spelling of a path appends through the same stream, in order).
+     */
+    std::unordered_map<std::string, std::ofstream> append_streams;
+
+    /**
+     * @brief The files mapped into memory by read, by canonical path.
+     */
+    std::unordered_map<std::string, std::weak_ptr<SourceBuffer>> mapped_files;
+
+    /**
+     * @brief Copy the text of a mapped file into memory before the file is overwritten, so the
+     * strings viewing it keep their characters (and never access truncated pages).
+     * @param file_path The path of the file.
+     */
+    void detach_mapped_file(const std::string &file_path);
+
+    /**
+     * @brief Get the file argument of a built-in function, which must be open.
+     * @param argument The argument.
+     * @param name The name of the built-in function, for error messages.
+     * @param line The line number where the function was called.
+     * @param col The column number where the function was called.
+     * @return The file.
+     */
+    FileObject *get_open_file(const Value &argument, const std::string &name, int line, int col);
 };
 
 #endif // SYNTHSCRIPT_BUILTINFUNCTIONS_H
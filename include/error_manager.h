@@ -1,8 +1,8 @@
 #ifndef SYNTHSCRIPT_ERRORMANAGER_H
 #define SYNTHSCRIPT_ERRORMANAGER_H
 
+#include "source_buffer.h"
 #include <string>
-#include <vector>
 
 class ErrorManager {
 public:
@@ -74,10 +74,13 @@ public:
     BuildStatus get_status();
 
     /**
-     * @brief Set the lines of the currently processed file.
-     * @param lines The lines of the file.
+     * @brief Set the source of the currently processed file, used to show error positions.
+     * @param source The source of the file.
+     *
+     * @note
+     * The error manager does not take ownership of the source.
      */
-    void set_file_lines(const std::vector<std::string> &lines);
+    void set_source(const SourceBuffer *source);
 
 private:
     /**
@@ -91,10 +94,9 @@ private:
     bool unhandled_error;
 
     /**
-     * @brief Stores the lines of the currently processed file.
-     * Newlines are preserved within each line entry.
+     * @brief The source of the currently processed file, if any.
      */
-    std::vector<std::string> file_lines;
+    const SourceBuffer *source = nullptr;
 
     /**
      * @brief Displays the position in the file based on the line and column number.
@@ -3,7 +3,7 @@
 
 #include "error_manager.h"
 #include "tokens.h"
-#include <utility>
+#include <string_view>
 
 /**
  * @class Lexer
@@ -17,9 +17,10 @@ public:
      * @param error_manager The error manager to use for error handling.
      *
      * @note
-     * The lexer does not take ownership of the error manager.
+     * The lexer does not take ownership of the code or error manager. The values of the tokens are
+     * views of the code, so the code must outlive the tokens.
      */
-    Lexer(const std::string &code, ErrorManager *error_manager);
+    Lexer(std::string_view code, ErrorManager *error_manager);
 
     /**
      * @brief Parse the input code into tokens.
@@ -37,46 +38,80 @@ private:
     /**
      * @brief The code to be parsed into tokens.
      */
-    std::string code;
+    std::string_view code;
 
     /**
-     * @brief Stores the line of each character in the code.
+     * @brief The line of the last position moved to, and the position where that line starts.
      */
-    std::vector<int> line_prefix;
+    int line = 1;
+    size_t line_start = 0;
 
     /**
-     * @brief Stores the beginning offset of the line for each character in the code.
+     * @brief The position up to which new lines have been counted.
      */
-    std::vector<int> line_offset_prefix;
+    size_t line_position = 0;
 
     /**
-     * @brief Combines all the regexes into one expression.
-     * @return The full regex expression.
+     * @brief The range of the last comment skipped.
      */
-    std::string combine_regex();
+    size_t comment_start = 0, comment_end = 0;
 
     /**
-     * @brief Prepare the line and column prefixes.
-     * @param code The code to be parsed.
+     * @brief The position of a backslash followed by a comment, which escapes the next new line if
+     * only comments and spaces come before it.
      */
-    void prepare_prefixes(std::string &code);
+    size_t escape_position = std::string_view::npos;
 
     /**
      * @brief Parse the code into tokens (lexical analysis).
+     */
+    std::vector<Token> get_tokens();
+
+    /**
+     * @brief Add the backslash at the escape position as an undefined token, since it doesn't
+     * escape a new line.
+     * @param tokens The tokens to add it to.
+     */
+    void add_undefined_escape(std::vector<Token> &tokens);
+
+    /**
+     * @brief Skip the comment that starts at a position in the code.
+     *
+     * A single comment character starts a comment that ends at the end of the line, and a double
+     * comment character starts a comment that ends after the next double comment character. The
+     * new lines within multi-line comments are added as tokens.
+     *
+     * @param start The position of the comment character.
+     * @param tokens The tokens to add the new lines to.
+     * @return The position after the comment.
+     */
+    size_t skip_comment(size_t start, std::vector<Token> &tokens);
+
+    /**
+     * @brief Scan the token that starts at a position in the code.
+     *
+     * The scanner matches the same tokens as `token_regexs`: at each position, the first token in
+     * `token_regexs` that matches is chosen.
+     *
      * @param code The code to be parsed.
-     * @param token_regex The combined regex for all the tokens.
+     * @param start The position of the first character of the token (not a space or tab).
+     * @param type Set to the type of the token.
+     * @return The position after the last character of the token.
      */
-    std::vector<Token> get_tokens(std::string &code, std::string &token_regex);
+    static size_t scan_token(std::string_view code, size_t start, TokenType &type);
 
     /**
-     * @brief Get the line of a character in the code.
-     * @param position The position of the character.
-     * @return The line of the character.
+     * @brief Count the lines up to a position in the code.
+     *
+     * Positions must be moved to in increasing order. A new line preceded by a backslash (outside
+     * a comment) doesn't start a new line.
+     *
+     * @param position The position to move to.
      */
-    int get_line(size_t position);
+    void move_to(size_t position);
 
     /**
-     * @brief Get the column of a character in the code.
+     * @brief Get the column of a character on the current line.
      * @param position The position of the character.
      * @return The column of the character, relative to the line.
      */
@@ -88,7 +123,7 @@ private:
      * @param line The line of the token.
      * @param column The column of the token.
      */
-    void lexer_error(const std::string &token, int line, int column);
+    void lexer_error(std::string_view token, int line, int column);
 };
 
 #endif // SYNTHSCRIPT_LEXER_H
@@ -0,0 +1,99 @@
+#ifndef SYNTHSCRIPT_ARRAYKERNELS_H
+#define SYNTHSCRIPT_ARRAYKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief The element-wise operations between arrays of packed numbers.
+ */
+enum ElementOp : uint8_t {
+    ELEMENT_ADD,
+    ELEMENT_SUBTRACT,
+    ELEMENT_MULTIPLY,
+    ELEMENT_DIVIDE,
+    ELEMENT_MODULO,
+    ELEMENT_BITWISE_AND,
+    ELEMENT_BITWISE_OR,
+    ELEMENT_BITWISE_XOR,
+    ELEMENT_LESS_THAN,
+    ELEMENT_GREATER_THAN,
+    ELEMENT_LESS_THAN_EQUAL,
+    ELEMENT_GREATER_THAN_EQUAL,
+};
+
+/**
+ * @brief The operand of an element-wise operation that is a single value, the same for every
+ * element.
+ */
+enum ScalarOperand : uint8_t {
+    SCALAR_NONE,  // Both operands are arrays
+    SCALAR_LEFT,  // A single left operand, such as 1 - array
+    SCALAR_RIGHT, // A single right operand, such as array - 1
+};
+
+/**
+ * @brief Check if an element-wise operation is a comparison, whose results are bools.
+ * @param op The operation.
+ * @return True for <, >, <= and >=.
+ */
+inline bool is_comparison(ElementOp op) {
+    return op >= ELEMENT_LESS_THAN;
+}
+
+/**
+ * @brief Apply an arithmetic or bitwise operation to ints, element by element.
+ *
+ * The loops are vectorized, and compiled for several instruction sets (such as AVX2) where the
+ * compiler supports it, with the best one for the CPU selected when the program starts.
+ * Arithmetic wraps around on overflow, as it does for single ints.
+ *
+ * @param op The operation, which must not be a comparison.
+ * @param left The left operands, or a single operand for every element.
+ * @param right The right operands, or a single operand for every element.
+ * @param scalar The operand that is a single value, if any.
+ * @param result Set to the results (which may alias the operands that are arrays).
+ * @param count The number of elements.
+ * @return False if an element is divided by zero (or the minimum int by -1), which leaves the
+ * results unspecified, otherwise true.
+ */
+bool int_kernel(ElementOp op, const int *left, const int *right, ScalarOperand scalar, int *result,
+                size_t count);
+
+/**
+ * @brief Apply an arithmetic operation to floats, element by element (see int_kernel).
+ * @param op The operation, which must be +, -, * or /.
+ * @param left The left operands, or a single operand for every element.
+ * @param right The right operands, or a single operand for every element.
+ * @param scalar The operand that is a single value, if any.
+ * @param result Set to the results (which may alias the operands that are arrays).
+ * @param count The number of elements.
+ */
+void float_kernel(ElementOp op, const float *left, const float *right, ScalarOperand scalar,
+                  float *result, size_t count);
+
+/**
+ * @brief Compare ints, element by element (see int_kernel).
+ * @param op The comparison.
+ * @param left The left operands, or a single operand for every element.
+ * @param right The right operands, or a single operand for every element.
+ * @param scalar The operand that is a single value, if any.
+ * @param result Set to 1 where the comparison holds, and 0 elsewhere.
+ * @param count The number of elements.
+ */
+void int_compare_kernel(ElementOp op, const int *left, const int *right, ScalarOperand scalar,
+                        uint8_t *result, size_t count);
+
+/**
+ * @brief Compare floats, element by element (see int_kernel).
+ * @param op The comparison.
+ * @param left The left operands, or a single operand for every element.
+ * @param right The right operands, or a single operand for every element.
+ * @param scalar The operand that is a single value, if any.
+ * @param result Set to 1 where the comparison holds, and 0 elsewhere.
+ * @param count The number of elements.
+ */
+void float_compare_kernel(ElementOp op, const float *left, const float *right, ScalarOperand scalar,
+                          uint8_t *result, size_t count);
+
+#endif // SYNTHSCRIPT_ARRAYKERNELS_H
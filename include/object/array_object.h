@@ -1,47 +1,240 @@
 #ifndef SYNTHSCRIPT_ARRAYOBJECT_H
 #define SYNTHSCRIPT_ARRAYOBJECT_H
 
+#include "array_kernels.h"
 #include "object.h"
+#include <cstdint>
 #include <utility>
+#include <vector>
 
+/**
+ * @class ArrayObject
+ * @brief An array of values, shared by reference.
+ *
+ * An array whose elements are all ints (or all floats) stores them packed in a std::vector<int>
+ * (or std::vector<float>), which takes a fraction of the memory of boxed values and lets len, sum,
+ * product, equality and string casts run as contiguous loops. Writing an element of another type
+ * converts the array to boxed values.
+ *
+ * The elements are stored in a buffer that copies of the array share (copy-on-write), so copying,
+ * reading or comparing an array never copies its elements. The buffer is only copied when an array
+ * that shares it is modified.
+ *
+ * Arithmetic, bitwise and ordering operators apply to the elements one by one, with an array of
+ * the same length or a single value as the right operand (so [1, 2] - 1 is [0, 1]). On packed
+ * numbers they run as vectorized loops. Adding two arrays concatenates them instead, and = and !=
+ * compare whole arrays. Arrays are repeated by repeat() (the replicate built-in function).
+ *
+ * An array created from a range (such as 1..10) only stores its bounds, so that its length,
+ * elements and sum are computed without allocating an element for each value. The elements are
+ * materialized in place the first time the array is mutated, so every reference to the array sees
+ * the change.
+ */
 class ArrayObject : public Object {
 public:
-    explicit ArrayObject(std::vector<std::shared_ptr<Object>> value) : value(std::move(value)) {}
+    /**
+     * @brief The ways the elements of an array are stored.
+     */
+    enum Storage : uint8_t {
+        STORAGE_RANGE,  // Computed from the bounds of a range
+        STORAGE_INTS,   // Packed ints
+        STORAGE_FLOATS, // Packed floats
+        STORAGE_VALUES, // Boxed values of any type
+    };
+
+    /**
+     * @brief Construct an array, packing the elements if they are all ints or all floats.
+     * @param values The elements.
+     */
+    explicit ArrayObject(std::vector<Value> values);
+    explicit ArrayObject(std::vector<int> values);
+    explicit ArrayObject(std::vector<float> values);
+    ArrayObject(const ArrayObject &other) = default;
+
+    /**
+     * @brief Create a lazy array of the ints from start to end (inclusive of both).
+     * @param start The first value.
+     * @param end The last value, which may be less than the start to count down.
+     * @return The array, or nullptr if the range has more elements than an array can hold
+     * (INT_MAX).
+     */
+    static std::shared_ptr<ArrayObject> from_range(int start, int end);
 
     Type get_type() override { return TYPE_ARRAY; }
 
-    std::shared_ptr<Object> add(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> subtract(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> positive() override;
-    std::shared_ptr<Object> negative() override;
-    std::shared_ptr<Object> multiply(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> divide(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> modulo(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> bitwise_and(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> bitwise_or(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> bitwise_xor(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> bitwise_not() override;
-    std::shared_ptr<Object> equal(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> not_equal(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> less_than(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> greater_than(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> less_than_equal(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> greater_than_equal(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> logical_and(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> logical_or(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> logical_not() override;
-    std::shared_ptr<Object> cast(Type type) override;
-    std::shared_ptr<Object> subscript(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> subscript_update(const std::shared_ptr<Object> &index,
-                                             const std::shared_ptr<Object> &val);
-    std::shared_ptr<Object> duplicate() override;
-    std::shared_ptr<Object> call(InterpreterVisitor *visitor, SymbolTable *table) override;
-
-    int get_len() const { return (int)value.size(); };
-    std::vector<std::shared_ptr<Object>> *get_value() { return &value; }
+    Value add(const Value &other) override;
+    Value subtract(const Value &other) override;
+    Value positive() override;
+    Value negative() override;
+    Value multiply(const Value &other) override;
+    Value divide(const Value &other) override;
+    Value modulo(const Value &other) override;
+    Value bitwise_and(const Value &other) override;
+    Value bitwise_or(const Value &other) override;
+    Value bitwise_xor(const Value &other) override;
+    Value bitwise_not() override;
+    Value equal(const Value &other) override;
+    Value not_equal(const Value &other) override;
+    Value less_than(const Value &other) override;
+    Value greater_than(const Value &other) override;
+    Value less_than_equal(const Value &other) override;
+    Value greater_than_equal(const Value &other) override;
+    Value logical_and(const Value &other) override;
+    Value logical_or(const Value &other) override;
+    Value logical_not() override;
+    Value cast(Type type) override;
+    Value subscript(const Value &other) override;
+    Value slice(const Value &start, const Value &end) override;
+    Value subscript_update(const Value &index, const Value &val);
+    Value duplicate() override;
+    Value call(InterpreterVisitor *visitor, SymbolTable *table) override;
+    int get_iteration_len() override;
+    bool iterate(int position, Value &element) override;
+
+    /**
+     * @brief Append an element to the array, in place.
+     * @param value The element.
+     */
+    void push(const Value &value);
+
+    /**
+     * @brief Create an array of the elements of this array, repeated.
+     * @param times The number of times to repeat the elements, which must not be negative.
+     * @return The new array.
+     */
+    Value repeat(int times);
+
+    /**
+     * @brief Sum the elements of an array of packed numbers (or a range) with a contiguous loop.
+     * @return The sum, or an undefined value if the elements are not packed numbers.
+     */
+    Value packed_sum() const;
+
+    /**
+     * @brief Multiply the elements of an array of packed numbers (or a range) with a contiguous
+     * loop.
+     * @return The product, or an undefined value if the elements are not packed numbers.
+     */
+    Value packed_product() const;
+
+    int get_len() const {
+        switch (storage) {
+        case STORAGE_RANGE:
+            return range_len;
+        case STORAGE_INTS:
+            return (int)ints->size();
+        case STORAGE_FLOATS:
+            return (int)floats->size();
+        default:
+            return (int)values->size();
+        }
+    }
+
+    /**
+     * @brief Get an element without materializing a range.
+     * @param index The index of the element, which must be in bounds.
+     * @return The element.
+     */
+    Value get_element(int index) const {
+        switch (storage) {
+        case STORAGE_RANGE:
+            return Value::from_int(range_start + index * range_step);
+        case STORAGE_INTS:
+            return Value::from_int((*ints)[index]);
+        case STORAGE_FLOATS:
+            return Value::from_float((*floats)[index]);
+        default:
+            return (*values)[index];
+        }
+    }
+
+    Storage get_storage() const { return storage; }
+
+    /**
+     * @brief Check if the array is a range that has not been materialized.
+     * @return True if the elements are computed from the bounds of a range.
+     */
+    bool is_range() const { return storage == STORAGE_RANGE; }
+
+    /**
+     * @brief Apply an operation element by element.
+     * @param other An array of the same length, or a value applied to every element.
+     * @param op The operation.
+     * @param other_left True if other is the left operand of the operation.
+     * @return The array of results, or an undefined value if the operation is invalid for an
+     * element (or the lengths differ).
+     */
+    Value elementwise(const Value &other, ElementOp op, bool other_left = false);
 
 private:
-    std::vector<std::shared_ptr<Object>> value;
+    Storage storage = STORAGE_VALUES;
+
+    /**
+     * @brief If the elements are range_start, range_start + range_step, ... (range_len of them).
+     */
+    int range_start = 0;
+    int range_step = 1;
+    int range_len = 0;
+
+    /**
+     * @brief The elements, in the buffer of the storage of the array (the others are nullptr).
+     * Buffers may be shared with other arrays.
+     */
+    std::shared_ptr<std::vector<int>> ints;
+    std::shared_ptr<std::vector<float>> floats;
+    std::shared_ptr<std::vector<Value>> values;
+
+    /**
+     * @brief Prepare the array to be modified: a range is materialized, and a shared buffer is
+     * copied.
+     */
+    void prepare_write();
+
+    /**
+     * @brief Convert the elements to boxed values, to store an element of another type.
+     */
+    void box();
+
+    /**
+     * @brief Copy an element for a deep copy of an array.
+     * @param element The element.
+     * @return A deep copy of the element if it is an array, or else the element itself.
+     */
+    static Value duplicate_element(const Value &element);
+
+    /**
+     * @brief Check if a value can be stored in the array without boxing it.
+     * @param value The value.
+     * @return True if the value matches the packed type of the elements (or the array is boxed).
+     */
+    bool fits(const Value &value) const;
+
+    /**
+     * @brief Append the elements of the array to a vector, without materializing a range.
+     * @tparam T The element type of the vector, which must match the storage unless it is Value.
+     * @param result The vector to append to.
+     */
+    template <typename T> void append_elements(std::vector<T> *result) const;
+
+    /**
+     * @brief Get the elements as packed ints.
+     * @param scratch A vector to materialize a range into.
+     * @return The elements, which must be ints (or a range).
+     */
+    const int *int_elements(std::vector<int> &scratch) const;
+
+    /**
+     * @brief Get the elements as packed floats, converting ints.
+     * @param scratch A vector to convert the elements into, unless they are packed floats.
+     * @return The elements, which must be ints (or a range) or floats.
+     */
+    const float *float_elements(std::vector<float> &scratch) const;
+
+    /**
+     * @brief Create an array that shares the elements of this array.
+     * @return The copy.
+     */
+    Value share() const;
 };
 
 #endif // SYNTHSCRIPT_ARRAYOBJECT_H
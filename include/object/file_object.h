@@ -0,0 +1,88 @@
+#ifndef SYNTHSCRIPT_FILEOBJECT_H
+#define SYNTHSCRIPT_FILEOBJECT_H
+
+#include "object.h"
+#include <fstream>
+#include <memory>
+#include <string>
+
+/**
+ * @class FileObject
+ * @brief A file opened for reading, which is read sequentially through a fixed size buffer.
+ *
+ * Only the buffer and the current line or chunk are held in memory, so a file of any size can be
+ * processed in constant memory. Iterating over a file (as in for line in lines(path)) reads it one
+ * line at a time, from the current position of the file to its end.
+ */
+class FileObject : public Object {
+public:
+    /**
+     * @brief Open a file for reading.
+     * @param path The path of the file.
+     */
+    explicit FileObject(std::string path);
+
+    Type get_type() override { return TYPE_FILE; }
+
+    Value add(const Value &other) override;
+    Value subtract(const Value &other) override;
+    Value positive() override;
+    Value negative() override;
+    Value multiply(const Value &other) override;
+    Value divide(const Value &other) override;
+    Value modulo(const Value &other) override;
+    Value bitwise_and(const Value &other) override;
+    Value bitwise_or(const Value &other) override;
+    Value bitwise_xor(const Value &other) override;
+    Value bitwise_not() override;
+    Value equal(const Value &other) override;
+    Value not_equal(const Value &other) override;
+    Value less_than(const Value &other) override;
+    Value greater_than(const Value &other) override;
+    Value less_than_equal(const Value &other) override;
+    Value greater_than_equal(const Value &other) override;
+    Value logical_and(const Value &other) override;
+    Value logical_or(const Value &other) override;
+    Value logical_not() override;
+    Value cast(Type type) override;
+    Value subscript(const Value &other) override;
+    Value slice(const Value &start, const Value &end) override;
+    Value duplicate() override;
+    Value call(InterpreterVisitor *visitor, SymbolTable *table) override;
+    int get_iteration_len() override;
+    bool iterate(int position, Value &element) override;
+
+    /**
+     * @brief Read the next line of the file.
+     * @return The line, ending with its newline unless it is the last line of the file, or an empty
+     * string at the end of the file.
+     */
+    Value read_line();
+
+    /**
+     * @brief Read the next bytes of the file.
+     * @param size The maximum number of bytes to read.
+     * @return The bytes, which are fewer than the size only at the end of the file.
+     */
+    Value read_chunk(int size);
+
+    /**
+     * @brief Close the file (which is also closed when the object is destroyed).
+     */
+    void close();
+
+    bool is_open() const { return stream.is_open(); }
+    const std::string &get_path() const { return path; }
+
+private:
+    /**
+     * @brief The size of the read buffer, in bytes.
+     */
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    std::string path;
+    std::unique_ptr<char[]> buffer;
+    std::ifstream stream;
+};
+
+#endif // SYNTHSCRIPT_FILEOBJECT_H
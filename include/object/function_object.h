@@ -3,50 +3,84 @@
 
 #include "AST/AST_node.h"
 #include "object.h"
+#include <vector>
+
+class BytecodeFunction;
 
 class FunctionObject : public Object {
 public:
-    FunctionObject(ASTNode *body, std::vector<std::string> parameters, bool built_in = false)
-        : body(body), parameters(std::move(parameters)), built_in(built_in) {}
+    FunctionObject(ASTNode *body, std::vector<std::string> parameters, int built_in_id = -1)
+        : body(body), parameters(std::move(parameters)), built_in_id(built_in_id) {}
+    FunctionObject(ASTNode *body, std::vector<std::string> parameters, BytecodeFunction *bytecode)
+        : body(body), parameters(std::move(parameters)), bytecode(bytecode) {}
+    FunctionObject(ASTNode *body, std::vector<std::string> parameters, const Closure *closure)
+        : body(body), parameters(std::move(parameters)), closure(closure) {}
 
     Type get_type() override { return TYPE_FUNCTION; }
 
-    std::shared_ptr<Object> add(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> subtract(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> positive() override;
-    std::shared_ptr<Object> negative() override;
-    std::shared_ptr<Object> multiply(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> divide(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> modulo(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> bitwise_and(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> bitwise_or(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> bitwise_xor(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> bitwise_not() override;
-    std::shared_ptr<Object> equal(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> not_equal(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> less_than(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> greater_than(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> less_than_equal(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> greater_than_equal(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> logical_and(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> logical_or(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> logical_not() override;
-    std::shared_ptr<Object> cast(Type type) override;
-    std::shared_ptr<Object> subscript(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> duplicate() override;
-    std::shared_ptr<Object> call(InterpreterVisitor *visitor, SymbolTable *table) override;
+    Value add(const Value &other) override;
+    Value subtract(const Value &other) override;
+    Value positive() override;
+    Value negative() override;
+    Value multiply(const Value &other) override;
+    Value divide(const Value &other) override;
+    Value modulo(const Value &other) override;
+    Value bitwise_and(const Value &other) override;
+    Value bitwise_or(const Value &other) override;
+    Value bitwise_xor(const Value &other) override;
+    Value bitwise_not() override;
+    Value equal(const Value &other) override;
+    Value not_equal(const Value &other) override;
+    Value less_than(const Value &other) override;
+    Value greater_than(const Value &other) override;
+    Value less_than_equal(const Value &other) override;
+    Value greater_than_equal(const Value &other) override;
+    Value logical_and(const Value &other) override;
+    Value logical_or(const Value &other) override;
+    Value logical_not() override;
+    Value cast(Type type) override;
+    Value subscript(const Value &other) override;
+    Value slice(const Value &start, const Value &end) override;
+    Value duplicate() override;
+    Value call(InterpreterVisitor *visitor, SymbolTable *table) override;
+    int get_iteration_len() override;
+    bool iterate(int position, Value &element) override;
 
     std::vector<std::string> *get_parameters() { return &parameters; }
     size_t get_parameters_size() { return parameters.size(); }
     std::string get_parameter(size_t index) { return parameters[index]; }
 
     ASTNode *get_body() { return body; }
-    bool is_built_in() const { return built_in; }
+    bool is_built_in() const { return built_in_id >= 0; }
+    int get_built_in_id() const { return built_in_id; }
+    BytecodeFunction *get_bytecode() const { return bytecode; }
+    const Closure *get_closure() const { return closure; }
 
 private:
     ASTNode *body;
     std::vector<std::string> parameters;
-    bool built_in;
+
+    /**
+     * @brief The id of the built-in function (see BuiltInFunctions::get), or -1 for a function
+     * declared in the program.
+     */
+    int built_in_id = -1;
+
+    /**
+     * @brief The compiled function, if the function was compiled for the virtual machine.
+     *
+     * @note
+     * The bytecode is owned by its BytecodeProgram.
+     */
+    BytecodeFunction *bytecode = nullptr;
+
+    /**
+     * @brief The compiled body, if the function was compiled into closures.
+     *
+     * @note
+     * The closure is owned by its ClosureCompilerVisitor.
+     */
+    const Closure *closure = nullptr;
 };
 
 #endif // SYNTHSCRIPT_FUNCTIONOBJECT_H
@@ -2,6 +2,7 @@
 #define SYNTHSCRIPT_OBJECT_H
 
 #include "types/types.h"
+#include "value.h"
 #include <memory>
 
 // Forward declarations, so we can add the call function, and include object.h in
@@ -9,36 +10,100 @@
 class InterpreterVisitor;
 class SymbolTable;
 
+/**
+ * @class Object
+ * @brief A heap allocated value (a string, array, function or file).
+ *
+ * Each operation is applied with the object as the left operand, and returns an undefined Value if
+ * the operation is invalid.
+ */
 class Object {
 public:
-    Object() = default;
+    Object() { created_count++; }
+    Object(const Object &) { created_count++; }
+    virtual ~Object() = default;
+
+    /**
+     * @brief Get the number of objects created so far, used by the profiler to count allocations.
+     * @return The number of objects created.
+     */
+    static size_t get_created_count() { return created_count; }
 
     virtual Type get_type() = 0;
 
-    virtual std::shared_ptr<Object> add(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> subtract(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> positive() = 0;
-    virtual std::shared_ptr<Object> negative() = 0;
-    virtual std::shared_ptr<Object> multiply(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> divide(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> modulo(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> bitwise_and(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> bitwise_or(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> bitwise_xor(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> bitwise_not() = 0;
-    virtual std::shared_ptr<Object> equal(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> not_equal(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> less_than(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> greater_than(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> less_than_equal(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> greater_than_equal(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> logical_and(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> logical_or(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> logical_not() = 0;
-    virtual std::shared_ptr<Object> cast(Type type) = 0;
-    virtual std::shared_ptr<Object> subscript(std::shared_ptr<Object> other) = 0;
-    virtual std::shared_ptr<Object> duplicate() = 0;
-    virtual std::shared_ptr<Object> call(InterpreterVisitor *visitor, SymbolTable *table) = 0;
+    virtual Value add(const Value &other) = 0;
+    virtual Value subtract(const Value &other) = 0;
+    virtual Value positive() = 0;
+    virtual Value negative() = 0;
+    virtual Value multiply(const Value &other) = 0;
+    virtual Value divide(const Value &other) = 0;
+    virtual Value modulo(const Value &other) = 0;
+    virtual Value bitwise_and(const Value &other) = 0;
+    virtual Value bitwise_or(const Value &other) = 0;
+    virtual Value bitwise_xor(const Value &other) = 0;
+    virtual Value bitwise_not() = 0;
+    virtual Value equal(const Value &other) = 0;
+    virtual Value not_equal(const Value &other) = 0;
+    virtual Value less_than(const Value &other) = 0;
+    virtual Value greater_than(const Value &other) = 0;
+    virtual Value less_than_equal(const Value &other) = 0;
+    virtual Value greater_than_equal(const Value &other) = 0;
+    virtual Value logical_and(const Value &other) = 0;
+    virtual Value logical_or(const Value &other) = 0;
+    virtual Value logical_not() = 0;
+    virtual Value cast(Type type) = 0;
+    virtual Value subscript(const Value &other) = 0;
+    virtual Value slice(const Value &start, const Value &end) = 0;
+    virtual Value duplicate() = 0;
+    virtual Value call(InterpreterVisitor *visitor, SymbolTable *table) = 0;
+
+    /**
+     * @brief Get the number of elements of an iteration over the object.
+     *
+     * A for loop takes the number when it starts, so changing the object in the body of the loop
+     * does not change how many times it runs.
+     *
+     * @return The number of elements, or INT_MAX if the iteration runs until the object is
+     * exhausted (as it does for the lines of a file).
+     */
+    virtual int get_iteration_len() = 0;
+
+    /**
+     * @brief Get an element of an iteration over the object, as done by a for loop.
+     *
+     * The loop keeps the position itself, so iterating needs no iterator object. The position is
+     * still checked against the current length (the body of the loop may shrink the object).
+     *
+     * @param position The position of the element, starting at 0.
+     * @param element Set to the element, if there is one at the position.
+     * @return True if there is an element, or false once the iteration is exhausted (and always
+     * false if the object is not iterable).
+     */
+    virtual bool iterate(int position, Value &element) = 0;
+
+protected:
+    /**
+     * @brief Get the indices of a slice, which are inclusive and may count down.
+     * @param start The index of the first element.
+     * @param end The index of the last element.
+     * @param length The number of elements of the object.
+     * @param first Set to the index of the first element.
+     * @param last Set to the index of the last element.
+     * @return True if both indices are ints in bounds, otherwise false.
+     */
+    static bool get_slice_bounds(
+        const Value &start, const Value &end, int length, int &first, int &last) {
+        if (start.get_type() != TYPE_INT || end.get_type() != TYPE_INT) {
+            return false;
+        }
+
+        first = start.get_int();
+        last = end.get_int();
+        return first >= 0 && first < length && last >= 0 && last < length;
+    }
+
+private:
+    static inline size_t created_count = 0;
 };
 
 #endif // SYNTHSCRIPT_OBJECT_H
@@ -2,47 +2,133 @@
 #define SYNTHSCRIPT_STRINGOBJECT_H
 
 #include "object.h"
+#include "source_buffer.h"
+#include <string>
+#include <string_view>
 
+/**
+ * @class StringObject
+ * @brief An immutable string.
+ *
+ * The characters of the string are the first characters of a buffer, which may be shared with
+ * other strings. Adding to a string built by concatenation, whose characters are the whole buffer,
+ * appends to the buffer in place, and the result shares it, so building a string by repeated
+ * concatenation (s <- s + ch) takes linear time. The characters of a string are never changed, as
+ * appending only adds characters past the end of every string sharing the buffer. Other strings
+ * (literals and the interned characters among them) are copied by their first concatenation, so
+ * their buffers never grow while they are shared.
+ *
+ * A string read from a large file views the memory mapping of the file instead of a buffer, so
+ * reading the file copies nothing. Adding to such a string copies it into a new buffer.
+ */
 class StringObject : public Object {
 public:
-    explicit StringObject(std::string value) : value(value) {}
+    explicit StringObject(std::string value)
+        : buffer(std::make_shared<std::string>(std::move(value))), length(buffer->size()) {}
+
+    /**
+     * @brief Construct a string from the first characters of a buffer.
+     * @param buffer The buffer, shared with other strings.
+     * @param length The number of characters of the string.
+     */
+    StringObject(std::shared_ptr<std::string> buffer, size_t length)
+        : buffer(std::move(buffer)), length(length) {}
+
+    /**
+     * @brief Construct a string viewing the text of a mapped file.
+     * @param mapping The file, shared with other strings.
+     */
+    explicit StringObject(std::shared_ptr<const SourceBuffer> mapping)
+        : mapping(std::move(mapping)), length(this->mapping->get_text().size()) {}
+
     static std::shared_ptr<StringObject> from_string_literal(std::string value) {
         // Remove the quotes from the string
         return std::make_shared<StringObject>(value.substr(1, value.length() - 2));
     }
 
+    /**
+     * @brief Get the string of a single character.
+     *
+     * The strings of the 256 characters are created once and shared (strings are immutable), so
+     * subscripting or iterating over a string never allocates.
+     *
+     * @param character The character.
+     * @return The interned string value.
+     */
+    static const Value &from_char(char character);
+
     Type get_type() override { return TYPE_STRING; }
 
-    std::shared_ptr<Object> add(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> subtract(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> positive() override;
-    std::shared_ptr<Object> negative() override;
-    std::shared_ptr<Object> multiply(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> divide(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> modulo(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> bitwise_and(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> bitwise_or(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> bitwise_xor(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> bitwise_not() override;
-    std::shared_ptr<Object> equal(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> not_equal(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> less_than(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> greater_than(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> less_than_equal(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> greater_than_equal(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> logical_and(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> logical_or(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> logical_not() override;
-    std::shared_ptr<Object> cast(Type type) override;
-    std::shared_ptr<Object> subscript(std::shared_ptr<Object> other) override;
-    std::shared_ptr<Object> duplicate() override;
-    std::shared_ptr<Object> call(InterpreterVisitor *visitor, SymbolTable *table) override;
-
-    int get_len() const { return (int)value.size(); };
-    std::string get_value() { return value; }
+    Value add(const Value &other) override;
+    Value subtract(const Value &other) override;
+    Value positive() override;
+    Value negative() override;
+    Value multiply(const Value &other) override;
+    Value divide(const Value &other) override;
+    Value modulo(const Value &other) override;
+    Value bitwise_and(const Value &other) override;
+    Value bitwise_or(const Value &other) override;
+    Value bitwise_xor(const Value &other) override;
+    Value bitwise_not() override;
+    Value equal(const Value &other) override;
+    Value not_equal(const Value &other) override;
+    Value less_than(const Value &other) override;
+    Value greater_than(const Value &other) override;
+    Value less_than_equal(const Value &other) override;
+    Value greater_than_equal(const Value &other) override;
+    Value logical_and(const Value &other) override;
+    Value logical_or(const Value &other) override;
+    Value logical_not() override;
+    Value cast(Type type) override;
+    Value subscript(const Value &other) override;
+    Value slice(const Value &start, const Value &end) override;
+    Value duplicate() override;
+    Value call(InterpreterVisitor *visitor, SymbolTable *table) override;
+    int get_iteration_len() override;
+    bool iterate(int position, Value &element) override;
+
+    int get_len() const { return (int)length; };
+
+    /**
+     * @brief Check if adding to the string may append to its buffer in place.
+     * @return True for the results of concatenations.
+     */
+    bool is_appendable() const { return appendable; }
+
+    /**
+     * @brief Get the characters of the string.
+     * @return A view of the characters, valid while the string is alive.
+     */
+    std::string_view get_value() const {
+        return {mapping ? mapping->get_text().data() : buffer->data(), length};
+    }
 
 private:
-    std::string value;
+    /**
+     * @brief The buffer of the characters, or nullptr if the string views a mapped file.
+     */
+    std::shared_ptr<std::string> buffer;
+    std::shared_ptr<const SourceBuffer> mapping;
+    size_t length;
+
+    /**
+     * @brief Stores if the buffer was created by a concatenation, and may be appended to.
+     */
+    bool appendable = false;
+
+    /**
+     * @brief Create the result of a concatenation, which may be appended to in place.
+     * @param buffer The buffer of the characters, all of which are the string.
+     * @return The string.
+     */
+    static Value concatenation(std::shared_ptr<std::string> buffer);
+
+    /**
+     * @brief Create a string of the first characters of this string, sharing its characters.
+     * @param prefix_length The number of characters.
+     * @return The string.
+     */
+    Value share_prefix(size_t prefix_length) const;
 };
 
 #endif // SYNTHSCRIPT_STRINGOBJECT_H
@@ -0,0 +1,97 @@
+#ifndef SYNTHSCRIPT_VALUE_H
+#define SYNTHSCRIPT_VALUE_H
+
+#include "types/types.h"
+#include <memory>
+
+class Object;
+
+/**
+ * @class Value
+ * @brief A value in a SynthScript program.
+ *
+ * Ints, floats, bools and void are stored inline, so operations on them never allocate. Strings,
+ * arrays, functions and files are heap allocated objects, shared by reference.
+ *
+ * A default constructed value is undefined (TYPE_UNDEF). Operations return an undefined value if
+ * they are invalid for the types of their operands.
+ */
+class Value {
+public:
+    /**
+     * @brief Construct an undefined value.
+     */
+    Value() = default;
+
+    /**
+     * @brief Construct a value holding a heap allocated object.
+     * @param object The object (undefined if nullptr).
+     */
+    explicit Value(std::shared_ptr<Object> object);
+
+    static Value from_int(int value);
+    static Value from_float(float value);
+    static Value from_bool(bool value);
+    static Value make_void();
+
+    Type get_type() const { return type; }
+    bool is_defined() const { return type != TYPE_UNDEF; }
+
+    int get_int() const { return int_value; }
+    float get_float() const { return float_value; }
+    bool get_bool() const { return bool_value; }
+
+    /**
+     * @brief Get the heap allocated object of a string, array, function or file value.
+     * @return The object, or nullptr for inline values.
+     */
+    Object *get_object() const { return object.get(); }
+    const std::shared_ptr<Object> &get_shared_object() const { return object; }
+
+    /**
+     * @brief Get the heap allocated object, cast to its class.
+     * @tparam T The object class (for example StringObject).
+     */
+    template <typename T> T *as() const { return static_cast<T *>(object.get()); }
+
+    Value add(const Value &other) const;
+    Value subtract(const Value &other) const;
+    Value positive() const;
+    Value negative() const;
+    Value multiply(const Value &other) const;
+    Value divide(const Value &other) const;
+    Value modulo(const Value &other) const;
+    Value bitwise_and(const Value &other) const;
+    Value bitwise_or(const Value &other) const;
+    Value bitwise_xor(const Value &other) const;
+    Value bitwise_not() const;
+    Value equal(const Value &other) const;
+    Value not_equal(const Value &other) const;
+    Value less_than(const Value &other) const;
+    Value greater_than(const Value &other) const;
+    Value less_than_equal(const Value &other) const;
+    Value greater_than_equal(const Value &other) const;
+    Value logical_and(const Value &other) const;
+    Value logical_or(const Value &other) const;
+    Value logical_not() const;
+    Value cast(Type type) const;
+    Value subscript(const Value &other) const;
+    Value slice(const Value &start, const Value &end) const;
+    Value duplicate() const;
+
+private:
+    Type type = TYPE_UNDEF;
+
+    union {
+        int int_value = 0;
+        float float_value;
+        bool bool_value;
+    };
+
+    /**
+     * @brief The object of a string, array, function or file value (nullptr otherwise).
+     */
+    std::shared_ptr<Object> object;
+};
+
+#endif // SYNTHSCRIPT_VALUE_H
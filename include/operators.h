@@ -2,25 +2,236 @@
 #define SYNTHSCRIPT_OPERATORS_H
 
 #include "object/object.h"
-#include <functional>
+#include <array>
+#include <climits>
+#include <cstdint>
 
-// Type alias for readability
-using BinaryOp =
-    std::function<std::shared_ptr<Object>(std::shared_ptr<Object>, std::shared_ptr<Object>)>;
-using UnaryOp = std::function<std::shared_ptr<Object>(std::shared_ptr<Object>)>;
+/**
+ * @brief The binary operators, in the order of their opcodes (OP_ADD to OP_NOT_EQUAL).
+ */
+enum BinaryOperator : uint8_t {
+    BINARY_ADD,
+    BINARY_SUBTRACT,
+    BINARY_MULTIPLY,
+    BINARY_DIVIDE,
+    BINARY_MODULO,
+    BINARY_LOGICAL_AND,
+    BINARY_LOGICAL_OR,
+    BINARY_BITWISE_AND,
+    BINARY_BITWISE_OR,
+    BINARY_BITWISE_XOR,
+    BINARY_LESS_THAN,
+    BINARY_LESS_THAN_EQUAL,
+    BINARY_GREATER_THAN,
+    BINARY_GREATER_THAN_EQUAL,
+    BINARY_EQUAL,
+    BINARY_NOT_EQUAL,
+    BINARY_OPERATOR_COUNT
+};
+
+/**
+ * @brief The unary operators, in the order of their opcodes (OP_POSITIVE to OP_BITWISE_NOT).
+ */
+enum UnaryOperator : uint8_t {
+    UNARY_POSITIVE,
+    UNARY_NEGATIVE,
+    UNARY_LOGICAL_NOT,
+    UNARY_BITWISE_NOT,
+    UNARY_OPERATOR_COUNT
+};
+
+/**
+ * @brief The number of types, which index the kernel tables.
+ */
+constexpr int TYPE_COUNT = TYPE_UNDEF + 1;
+
+/**
+ * @brief An operator applied to operands of fixed types.
+ *
+ * A kernel for inline values (ints, floats and bools) computes the result directly. A kernel for
+ * an object operand calls the operation of the object, and a kernel for types the operator does
+ * not apply to returns an undefined value.
+ */
+using BinaryKernel = Value (*)(const Value &left, const Value &right);
+using UnaryKernel = Value (*)(const Value &operand);
+
+/**
+ * @brief The kernel of each binary operator for each pair of operand types, generated at compile
+ * time, at index (op * TYPE_COUNT + left type) * TYPE_COUNT + right type.
+ */
+extern const std::array<BinaryKernel, BINARY_OPERATOR_COUNT * TYPE_COUNT * TYPE_COUNT>
+    binary_kernels;
+
+/**
+ * @brief The kernel of each unary operator for each operand type, at index op * TYPE_COUNT + type.
+ */
+extern const std::array<UnaryKernel, UNARY_OPERATOR_COUNT * TYPE_COUNT> unary_kernels;
+
+/**
+ * @brief Get the binary operator of an operator token.
+ * @param op The operator token.
+ * @return The operator, or BINARY_OPERATOR_COUNT if the token is not a binary operator.
+ */
+BinaryOperator to_binary_operator(TokenType op);
+
+/**
+ * @brief Get the unary operator of an operator token.
+ * @param op The operator token.
+ * @return The operator, or UNARY_OPERATOR_COUNT if the token is not a unary operator.
+ */
+UnaryOperator to_unary_operator(TokenType op);
+
+/**
+ * @brief Get the kernel of a binary operator for a pair of operand types.
+ * @param op The operator.
+ * @param left The type of the left operand.
+ * @param right The type of the right operand.
+ * @return The kernel.
+ */
+inline BinaryKernel get_binary_kernel(BinaryOperator op, Type left, Type right) {
+    return binary_kernels[((size_t)op * TYPE_COUNT + left) * TYPE_COUNT + right];
+}
+
+/**
+ * @brief Apply a binary operator, through the kernel for the types of its operands.
+ * @param op The operator.
+ * @param left The left operand.
+ * @param right The right operand.
+ * @return The result, or an undefined value if the operator does not apply to the operands.
+ */
+inline Value apply_binary_operator(BinaryOperator op, const Value &left, const Value &right) {
+    return get_binary_kernel(op, left.get_type(), right.get_type())(left, right);
+}
+
+/**
+ * @brief Apply a unary operator, through the kernel for the type of its operand.
+ * @param op The operator.
+ * @param operand The operand.
+ * @return The result, or an undefined value if the operator does not apply to the operand.
+ */
+inline Value apply_unary_operator(UnaryOperator op, const Value &operand) {
+    return unary_kernels[(size_t)op * TYPE_COUNT + operand.get_type()](operand);
+}
+
+/**
+ * @brief Check if an int division (or modulo) would trap.
+ * @param a The dividend.
+ * @param b The divisor.
+ * @return True if the divisor is zero, or the minimum int is divided by -1.
+ */
+inline bool division_traps(int a, int b) {
+    return b == 0 || (b == -1 && a == INT_MIN);
+}
+
+/**
+ * @brief Add two ints, wrapping around on overflow.
+ *
+ * Ints are added, subtracted and multiplied as unsigned ints, whose overflow is defined, so that
+ * every operation on ints (on single values or packed arrays alike) has the same result.
+ *
+ * @param a The left operand.
+ * @param b The right operand.
+ * @return The sum, modulo 2^32.
+ */
+inline int wrapping_add(int a, int b) {
+    return (int)((unsigned int)a + (unsigned int)b);
+}
+
+/**
+ * @brief Subtract two ints, wrapping around on overflow.
+ * @param a The left operand.
+ * @param b The right operand.
+ * @return The difference, modulo 2^32.
+ */
+inline int wrapping_subtract(int a, int b) {
+    return (int)((unsigned int)a - (unsigned int)b);
+}
+
+/**
+ * @brief Multiply two ints, wrapping around on overflow.
+ * @param a The left operand.
+ * @param b The right operand.
+ * @return The product, modulo 2^32.
+ */
+inline int wrapping_multiply(int a, int b) {
+    return (int)((unsigned int)a * (unsigned int)b);
+}
 
 /**
- * Get the binary operator function for the given operator.
+ * @brief Apply a binary operator to two ints inline, without the indirect call of the kernel.
  * @param op The operator.
- * @return The binary operator function.
+ * @param a The left operand.
+ * @param b The right operand.
+ * @return The result, or an undefined value for the logical operators and for a division that
+ * would trap.
  */
-BinaryOp get_binary_op_function(TokenType op);
+inline Value apply_int_operator(BinaryOperator op, int a, int b) {
+    switch (op) {
+    case BINARY_ADD:
+        return Value::from_int(wrapping_add(a, b));
+    case BINARY_SUBTRACT:
+        return Value::from_int(wrapping_subtract(a, b));
+    case BINARY_MULTIPLY:
+        return Value::from_int(wrapping_multiply(a, b));
+    case BINARY_DIVIDE:
+        return division_traps(a, b) ? Value() : Value::from_int(a / b);
+    case BINARY_MODULO:
+        return division_traps(a, b) ? Value() : Value::from_int(a % b);
+    case BINARY_BITWISE_AND:
+        return Value::from_int(a & b);
+    case BINARY_BITWISE_OR:
+        return Value::from_int(a | b);
+    case BINARY_BITWISE_XOR:
+        return Value::from_int(a ^ b);
+    case BINARY_LESS_THAN:
+        return Value::from_bool(a < b);
+    case BINARY_LESS_THAN_EQUAL:
+        return Value::from_bool(a <= b);
+    case BINARY_GREATER_THAN:
+        return Value::from_bool(a > b);
+    case BINARY_GREATER_THAN_EQUAL:
+        return Value::from_bool(a >= b);
+    case BINARY_EQUAL:
+        return Value::from_bool(a == b);
+    case BINARY_NOT_EQUAL:
+        return Value::from_bool(a != b);
+    default:
+        return {};
+    }
+}
 
 /**
- * Get the unary operator function for the given operator.
+ * @brief Apply a binary operator to two floats inline, without the indirect call of the kernel.
  * @param op The operator.
- * @return The unary operator function.
+ * @param a The left operand.
+ * @param b The right operand.
+ * @return The result, or an undefined value for the modulo, logical and bitwise operators.
  */
-UnaryOp get_unary_op_function(TokenType op);
+inline Value apply_float_operator(BinaryOperator op, float a, float b) {
+    switch (op) {
+    case BINARY_ADD:
+        return Value::from_float(a + b);
+    case BINARY_SUBTRACT:
+        return Value::from_float(a - b);
+    case BINARY_MULTIPLY:
+        return Value::from_float(a * b);
+    case BINARY_DIVIDE:
+        return Value::from_float(a / b);
+    case BINARY_LESS_THAN:
+        return Value::from_bool(a < b);
+    case BINARY_LESS_THAN_EQUAL:
+        return Value::from_bool(a <= b);
+    case BINARY_GREATER_THAN:
+        return Value::from_bool(a > b);
+    case BINARY_GREATER_THAN_EQUAL:
+        return Value::from_bool(a >= b);
+    case BINARY_EQUAL:
+        return Value::from_bool(a == b);
+    case BINARY_NOT_EQUAL:
+        return Value::from_bool(a != b);
+    default:
+        return {};
+    }
+}
 
 #endif // SYNTHSCRIPT_OPERATORS_H
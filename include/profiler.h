@@ -0,0 +1,197 @@
+#ifndef SYNTHSCRIPT_PROFILER_H
+#define SYNTHSCRIPT_PROFILER_H
+
+#include "source_buffer.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class Profiler
+ * @brief Measures where a program spends its time, by function and by source line.
+ *
+ * The interpreter reports each function call and each statement it evaluates to the profiler.
+ * Inclusive time includes nested calls (or nested statements), and exclusive time does not.
+ * Allocations are the number of objects (strings, arrays and functions) created.
+ */
+class Profiler {
+public:
+    /**
+     * @brief The name of the frame of the top-level code.
+     */
+    static constexpr const char *MAIN_FUNCTION = "<main>";
+
+    /**
+     * @struct Entry
+     * @brief The measurements of a function or source line.
+     */
+    struct Entry {
+        int64_t count = 0;
+        int64_t inclusive_ns = 0;
+        int64_t exclusive_ns = 0;
+        int64_t allocations = 0;
+    };
+
+    /**
+     * @brief Start a call to a function.
+     * @param name The name of the function.
+     */
+    void enter_function(const std::string &name);
+
+    /**
+     * @brief End the innermost function call.
+     */
+    void exit_function();
+
+    /**
+     * @brief Replace the innermost function call with the call it makes in tail position.
+     *
+     * The callee takes over the frame of the call, and the statement that made the call has
+     * ended by the time it starts. Until the callee is replaced or ends, its line is running
+     * again (without being counted twice), as the line of a call in any other position would be.
+     * Otherwise the callee would be charged to the statement that started the chain of calls.
+     *
+     * @param name The name of the callee.
+     * @param line The line of the call.
+     */
+    void enter_tail_call(const std::string &name, int line);
+
+    /**
+     * @brief Start evaluating a statement.
+     * @param line The source line of the statement.
+     */
+    void enter_line(int line);
+
+    /**
+     * @brief End the innermost statement.
+     */
+    void exit_line();
+
+    /**
+     * @brief End every function call and statement that is still running.
+     *
+     * Used when the program stops because of a runtime error.
+     */
+    void finish();
+
+    /**
+     * @brief Get the measurements of each function.
+     * @return The measurements, by function name.
+     */
+    const std::unordered_map<std::string, Entry> &get_functions() const { return functions; }
+
+    /**
+     * @brief Get the measurements of each source line.
+     * @return The measurements, by line.
+     */
+    const std::map<int, Entry> &get_lines() const { return lines; }
+
+    /**
+     * @brief Print tables of the hottest functions and source lines.
+     * @param stream The stream to print to.
+     * @param source The source of the file, to show the code of each line.
+     * @param max_rows The maximum number of rows of each table.
+     */
+    void report(std::ostream &stream, const SourceBuffer &source, size_t max_rows = 20) const;
+
+    /**
+     * @brief Write the exclusive time of each call stack in the folded format of flame graphs.
+     *
+     * Each line is a call stack, with function names separated by ';', followed by the time in
+     * microseconds.
+     *
+     * @param stream The stream to write to.
+     */
+    void write_folded_stacks(std::ostream &stream) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @struct Frame
+     * @brief A function call or statement that is running.
+     */
+    template <typename Key> struct Frame {
+        Key key;
+        Clock::time_point start;
+        int64_t start_allocations;
+        int64_t child_ns = 0;
+        int64_t child_allocations = 0;
+        bool has_tail_line = false; // A function call with a line from enter_tail_call
+        bool counted = true;        // False for a line from enter_tail_call
+    };
+
+    /**
+     * @struct StackNode
+     * @brief A call stack, as the function called last and the call stack of its caller.
+     */
+    struct StackNode {
+        int parent;
+        std::string name;
+        int64_t exclusive_ns = 0;
+    };
+
+    std::unordered_map<std::string, Entry> functions;
+    std::map<int, Entry> lines;
+
+    /**
+     * @brief The call stacks that have been entered, as a tree of calls (a stack is only joined
+     * into a string when it is written).
+     */
+    std::vector<StackNode> stack_nodes;
+
+    /**
+     * @brief The index of each call stack, by the index of its caller (-1 for none) and the name
+     * of the function called last.
+     */
+    std::map<std::pair<int, std::string>, int> stack_children;
+
+    std::vector<Frame<std::string>> function_frames;
+    std::vector<Frame<int>> line_frames;
+
+    /**
+     * @brief The index of the call stack of each running function call.
+     */
+    std::vector<int> function_stacks;
+
+    /**
+     * @brief The number of running frames of each function and line.
+     *
+     * The inclusive time of recursive frames is only counted by the outermost frame.
+     */
+    std::unordered_map<std::string, int> active_functions;
+    std::unordered_map<int, int> active_lines;
+
+    /**
+     * @brief Start a function call.
+     * @param name The name of the function.
+     * @param now The time the call starts.
+     */
+    void enter_function(const std::string &name, Clock::time_point now);
+
+    /**
+     * @brief End the innermost function call, and its line from enter_tail_call if it has one.
+     * @param now The time the call ends.
+     */
+    void exit_function(Clock::time_point now);
+
+    /**
+     * @brief End the innermost frame of a stack.
+     * @param frames The stack of frames.
+     * @param entries The measurements to update.
+     * @param active The number of running frames of each key.
+     * @param now The time the frame ends.
+     * @return The exclusive time of the frame, in nanoseconds.
+     */
+    template <typename Key, typename Entries>
+    static int64_t exit_frame(std::vector<Frame<Key>> &frames,
+                              Entries &entries,
+                              std::unordered_map<Key, int> &active,
+                              Clock::time_point now);
+};
+
+#endif // SYNTHSCRIPT_PROFILER_H
@@ -2,12 +2,13 @@
 #define SYNTHSCRIPT_READER_H
 
 #include "error_manager.h"
+#include "source_buffer.h"
 #include <string>
-#include <vector>
+#include <string_view>
 
 /**
  * @class Reader
- * @brief Provides utility functions for reading and processing files.
+ * @brief Provides utility functions for reading files.
  */
 class Reader {
 public:
@@ -22,17 +23,19 @@ public:
     Reader(const std::string &file_path, ErrorManager *error_manager);
 
     /**
-     * @brief Reads the contents of a file into a string.
-     * @param file_path The path to the file.
-     * @return The file contents as a string.
+     * @brief Reads the contents of the file.
+     * @return A view of the file contents, valid for the lifetime of the reader.
+     *
+     * @note
+     * Comments are kept in the contents, and skipped by the lexer.
      */
-    std::string read_file();
+    std::string_view read_file();
 
     /**
-     * @brief Get the file lines.
-     * @return The file lines.
+     * @brief Get the source of the file, which also provides its lines.
+     * @return The source of the file.
      */
-    std::vector<std::string> get_lines();
+    const SourceBuffer &get_source() const { return source; }
 
 private:
     /**
@@ -48,40 +51,7 @@ private:
     /**
      * @brief The contents of the file.
      */
-    std::string file_contents;
-
-    /**
-     * @brief The character used to denote comments in the file.
-     */
-    const char comment_char = '#';
-
-    /**
-     * @brief Checks if a file exists at the given path.
-     * @param path The path to the file.
-     * @return True if the file exists, otherwise false.
-     */
-    bool file_exists(const std::string &path);
-
-    /**
-     * @brief Retrieves the raw text from a file.
-     * @param file_path The path to the file.
-     * @return The raw file text.
-     */
-    std::string get_file_text(const std::string &file_path);
-
-    /**
-     * @brief Cleans the file contents by removing comments.
-     * @param file The raw file contents.
-     * @return The cleaned file content as a string.
-     */
-    std::string clean_file(const std::string &file);
-
-    /**
-     * @brief Splits the file content into individual lines.
-     * @param file_contents The raw or cleaned file content.
-     * @return A vector containing the lines of the file.
-     */
-    std::vector<std::string> get_lines(const std::string &file_contents);
+    SourceBuffer source;
 };
 
 #endif // SYNTHSCRIPT_READER_H
@@ -0,0 +1,90 @@
+#ifndef SYNTHSCRIPT_SOURCEBUFFER_H
+#define SYNTHSCRIPT_SOURCEBUFFER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class SourceBuffer
+ * @brief The text of a source file, memory-mapped where the platform supports it.
+ *
+ * Tokens and error messages refer to the text with string views, so the text is never copied on
+ * its way from the disk to the token stream. Large files read by a program are loaded the same way,
+ * and shared by the strings that view them. The offsets of the lines are only computed when a
+ * line is first requested (usually to show the position of an error).
+ *
+ * @note
+ * The buffer must outlive every view of its text (including the tokens lexed from it).
+ */
+class SourceBuffer {
+public:
+    SourceBuffer() = default;
+    ~SourceBuffer();
+
+    SourceBuffer(const SourceBuffer &) = delete;
+    SourceBuffer &operator=(const SourceBuffer &) = delete;
+
+    /**
+     * @brief Map (or read) the contents of a file into the buffer.
+     * @param file_path The path to the file.
+     * @return True if the file was opened, otherwise false.
+     */
+    bool load(const std::string &file_path);
+
+    /**
+     * @brief Set the text of the buffer, for code that is not read from a file.
+     * @param text The text.
+     */
+    void assign(std::string text);
+
+    /**
+     * @brief Get the text of the file.
+     * @return A view of the text, valid for the lifetime of the buffer.
+     */
+    std::string_view get_text() const { return {data, size}; }
+
+    /**
+     * @brief Get the number of lines of the text.
+     * @return The number of lines, where a final line without a new line is also counted.
+     */
+    size_t get_line_count() const;
+
+    /**
+     * @brief Get a line of the text.
+     * @param line The line number (1-based).
+     * @return A view of the line without its new line, or an empty view if there is no such line.
+     */
+    std::string_view get_line(int line) const;
+
+private:
+    const char *data = nullptr;
+    size_t size = 0;
+
+    /**
+     * @brief If the text is a memory mapping of the file, which is unmapped in the destructor.
+     */
+    bool mapped = false;
+
+    /**
+     * @brief The text, if the file could not be mapped.
+     */
+    std::string contents;
+
+    /**
+     * @brief The offset of the first character of each line, computed on first use.
+     */
+    mutable std::vector<size_t> line_starts;
+
+    /**
+     * @brief Release the text of the buffer.
+     */
+    void release();
+
+    /**
+     * @brief Compute the line offsets, if they have not been computed yet.
+     */
+    void index_lines() const;
+};
+
+#endif // SYNTHSCRIPT_SOURCEBUFFER_H
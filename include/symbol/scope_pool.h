@@ -0,0 +1,92 @@
+#ifndef SYNTHSCRIPT_SCOPEPOOL_H
+#define SYNTHSCRIPT_SCOPEPOOL_H
+
+#include "symbol_table.h"
+#include <vector>
+
+/**
+ * @class ScopePool
+ * @brief Allocates the symbol tables of the scopes entered at runtime.
+ *
+ * Scopes are entered and exited in stack order, so a table is returned to the pool when its scope
+ * is exited and reused by the next scope that is entered. The number of tables is bounded by the
+ * deepest nesting of scopes (including calls), no matter how many times a block is executed.
+ *
+ * @note
+ * The ScopePool owns every table it allocated and deletes them in its destructor. Tables taken
+ * from the pool must be released before the pool is destroyed.
+ */
+class ScopePool {
+public:
+    ScopePool() = default;
+    ~ScopePool();
+
+    ScopePool(const ScopePool &) = delete;
+    ScopePool &operator=(const ScopePool &) = delete;
+
+    /**
+     * @brief Take an empty table from the pool.
+     * @param enclosing_scope A pointer to the enclosing scope's SymbolTable.
+     * @param loop A boolean indicating if the symbol table is within a loop.
+     * @param function A boolean indicating if the symbol table is within a function.
+     * @return The table.
+     */
+    SymbolTable *acquire(SymbolTable *enclosing_scope, bool loop = false, bool function = false);
+
+    /**
+     * @brief Return a table to the pool, releasing the values it holds.
+     * @param table The table, which must have been acquired from this pool.
+     */
+    void release(SymbolTable *table);
+
+    /**
+     * @brief Get the number of tables allocated by the pool.
+     * @return The number of tables (in use or free).
+     */
+    size_t get_allocated_size() const;
+
+private:
+    /**
+     * @brief The tables that are not in use.
+     */
+    std::vector<SymbolTable *> free_tables;
+
+    /**
+     * @brief The number of tables allocated by the pool.
+     */
+    size_t allocated_size = 0;
+};
+
+/**
+ * @class PooledScope
+ * @brief Holds a table of a ScopePool for the lifetime of a scope.
+ *
+ * The table is released when the PooledScope goes out of scope, including when a runtime error is
+ * thrown.
+ */
+class PooledScope {
+public:
+    /**
+     * @brief Enter a new scope.
+     * @param pool The pool to take the table from.
+     * @param enclosing_scope A pointer to the enclosing scope's SymbolTable.
+     * @param loop A boolean indicating if the symbol table is within a loop.
+     * @param function A boolean indicating if the symbol table is within a function.
+     */
+    PooledScope(ScopePool *pool,
+                SymbolTable *enclosing_scope,
+                bool loop = false,
+                bool function = false);
+    ~PooledScope();
+
+    PooledScope(const PooledScope &) = delete;
+    PooledScope &operator=(const PooledScope &) = delete;
+
+    SymbolTable *get() const { return table; }
+
+private:
+    ScopePool *pool;
+    SymbolTable *table;
+};
+
+#endif // SYNTHSCRIPT_SCOPEPOOL_H
@@ -13,12 +13,12 @@
 class Symbol {
 public:
     /**
-     * @brief Constructs a symbol with no name and a null value.
+     * @brief Constructs a symbol with no name and an undefined value.
      */
     Symbol() = default;
 
     /**
-     * @brief Constructs a symbol with the given name and a null value.
+     * @brief Constructs a symbol with the given name and an undefined value.
      *
      * @param name The name of the symbol.
      */
@@ -30,7 +30,7 @@ public:
      * @param name The name of the symbol.
      * @param value The value of the symbol.
      */
-    Symbol(std::string name, std::shared_ptr<Object> value);
+    Symbol(std::string name, Value value);
 
     /**
      * @brief Get the name of the symbol.
@@ -42,20 +42,20 @@ public:
      * @brief Set the value of the symbol.
      * @param value The new value of the symbol.
      */
-    void set_value(std::shared_ptr<Object> value);
+    void set_value(Value value);
 
     /**
      * @brief Get the value of the symbol.
      * @return The value of the symbol.
      */
-    std::shared_ptr<Object> get_value() const;
+    Value get_value() const;
 
     /**
      * @brief Get the type of the symbol.
      * @return The type of the symbol.
      * 
      * @note
-     * If the value of the symbol is null, the type of the symbol is undefined.
+     * If the value of the symbol is undefined, the type of the symbol is undefined.
      */
     Type get_type() const;
 
@@ -68,7 +68,7 @@ private:
     /**
      * @brief The value of the symbol.
      */
-    std::shared_ptr<Object> value;
+    Value value;
 };
 
 #endif // SYNTHSCRIPT_SYMBOL_H
@@ -2,7 +2,9 @@
 #define SYNTHSCRIPT_SYMBOLTABLE_H
 
 #include "symbol.h"
+#include "variable_slot.h"
 #include <unordered_map>
+#include <vector>
 
 /**
  * @class SymbolTable
@@ -11,6 +13,9 @@
  * The SymbolTable class manages symbols within different scopes, such as global, function, and loop
  * scopes. It supports inserting symbols, checking for their existence, and retrieving them.
  *
+ * Every symbol is also given a slot in its scope. Semantic analysis resolves each variable to its
+ * slot (see VariableSlot), so that the values can be accessed at runtime without looking up names.
+ *
  * @note
  * The SymbolTable class assumes ownership of child symbol tables and is responsible for their
  * deletion.
@@ -30,6 +35,18 @@ public:
 
     ~SymbolTable();
 
+    /**
+     * @brief Empty the symbol table and move it to another enclosing scope, so it can be reused.
+     * @param enclosing_scope A pointer to the new enclosing scope's SymbolTable.
+     * @param loop A boolean indicating if the symbol table is within a loop.
+     * @param function A boolean indicating if the symbol table is within a function.
+     *
+     * @note
+     * The symbol table is not added as a child of the enclosing scope, so it is not deleted by it.
+     * Only tables without child scopes can be reset.
+     */
+    void reset(SymbolTable *enclosing_scope, bool loop = false, bool function = false);
+
     /**
      * @brief Insert a symbol into the symbol table.
      * @param symbol The symbol to insert.
@@ -84,6 +101,70 @@ public:
      */
     SymbolTable *get_global_scope() const;
 
+    /**
+     * @brief Resolve the slot of a declared symbol.
+     *
+     * @param name The name of the symbol.
+     * @return The slot of the symbol, relative to this scope (unresolved if it does not exist).
+     */
+    VariableSlot resolve(const std::string &name) const;
+
+    /**
+     * @brief Get the slot index of a name in this scope, reserving a new slot if needed.
+     *
+     * @param name The name.
+     * @return The index of the slot.
+     *
+     * @note
+     * Reserving a slot does not declare a symbol.
+     */
+    int slot_index(const std::string &name);
+
+    /**
+     * @brief Get the names of the slots of this scope.
+     * @return The name of each slot, by index.
+     */
+    std::vector<std::string> get_slot_names() const;
+
+    /**
+     * @brief Get the value in a slot of this scope.
+     * @param index The index of the slot.
+     * @return The value, or an undefined value if the slot is empty.
+     */
+    Value get_slot(int index) const;
+
+    /**
+     * @brief Set the value in a slot of this scope.
+     * @param index The index of the slot.
+     * @param value The new value.
+     */
+    void set_slot(int index, Value value);
+
+    /**
+     * @brief Load the value of a resolved variable.
+     * @param slot The slot of the variable, relative to this scope.
+     * @return The value, or an undefined value if the variable is undefined.
+     */
+    Value load(const VariableSlot &slot) const;
+
+    /**
+     * @brief Store the value of a resolved variable.
+     *
+     * If the variable has a global fallback, the global is updated instead while the local variable
+     * is undefined and the global is defined.
+     *
+     * @param slot The slot of the variable, relative to this scope.
+     * @param value The new value.
+     */
+    void store(const VariableSlot &slot, Value value);
+
+    /**
+     * @brief Get an enclosing scope.
+     * @param depth The number of scopes to go up (or VariableSlot::GLOBAL_DEPTH).
+     * @return The scope.
+     */
+    SymbolTable *get_scope(int depth) const;
+
 protected:
     /**
      * @brief Add a symbol table as a child.
@@ -97,6 +178,19 @@ private:
      */
     std::unordered_map<std::string, Symbol> symbols;
 
+    /**
+     * @brief Maps the name of each symbol (or reserved slot) to its slot index.
+     */
+    std::unordered_map<std::string, int> slot_indices;
+
+    /**
+     * @brief The values of the slots.
+     *
+     * @note
+     * The slots grow as they are set, so a table only holds the slots that were used.
+     */
+    std::vector<Value> slots;
+
     /**
      * @brief The enclosing scope of the symbol table, if it exists.
      *
@@ -0,0 +1,29 @@
+#ifndef SYNTHSCRIPT_VARIABLESLOT_H
+#define SYNTHSCRIPT_VARIABLESLOT_H
+
+/**
+ * @struct VariableSlot
+ * @brief The location of a variable, resolved during semantic analysis.
+ *
+ * A local variable is stored `depth` scopes above the scope it is used in, at index `slot` of that
+ * scope. A global variable is stored at index `slot` of the global scope.
+ *
+ * Functions can assign to a global that is only declared after them. Such variables are local,
+ * but refer to the global at index `global_slot` while the local variable is undefined.
+ */
+struct VariableSlot {
+    /**
+     * @brief The depth of global variables.
+     */
+    static constexpr int GLOBAL_DEPTH = -1;
+
+    int depth = GLOBAL_DEPTH;
+    int slot = -1;
+    int global_slot = -1;
+
+    bool is_resolved() const { return slot >= 0; }
+    bool is_global() const { return depth == GLOBAL_DEPTH; }
+    bool has_global_fallback() const { return global_slot >= 0; }
+};
+
+#endif // SYNTHSCRIPT_VARIABLESLOT_H
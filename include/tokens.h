@@ -2,6 +2,7 @@
 #define SYNTHSCRIPT_TOKENS_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 typedef enum {
@@ -114,6 +115,12 @@ const std::vector<std::string> token_values = {
     "end of file",
 };
 
+/**
+ * @brief The regular expression of each token type.
+ *
+ * At each position in the code, the token is the first of these expressions that matches. The lexer
+ * scans tokens by hand, following the same rules, and skips comments between tokens.
+ */
 const std::vector<std::pair<TokenType, std::string>> token_regexs = {
     {STRING_LITERAL, R"("(?:[^"\\]|\\.)*")"},
     {ASSIGNMENT_OPERATOR, R"(\<\-)"},
@@ -165,16 +172,20 @@ const std::vector<std::pair<TokenType, std::string>> token_regexs = {
     {INT_LITERAL, R"(\d+)"},
     {ESCAPED_NEW_LINE, R"(\\ *\n)"},
     {NEW_LINE, R"(\n)"},
-    {UNDEFINED, R"([^\ \t\n]+)"},
+    {UNDEFINED, R"([^\ \t\n#]+)"},
 };
 
+/**
+ * @struct Token
+ * @brief A token of the code, whose value is a view of the code it was lexed from.
+ */
 struct Token {
     const TokenType type{};
-    const std::string value{};
+    const std::string_view value{};
     const int line, column;
 
-    Token(TokenType type, std::string val, int line, int column)
-        : type(type), value(std::move(val)), line(line), column(column) {}
+    Token(TokenType type, std::string_view val, int line, int column)
+        : type(type), value(val), line(line), column(column) {}
 
     bool operator==(const Token &other) const {
         return type == other.type && value == other.value && line == other.line &&
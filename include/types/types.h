@@ -12,6 +12,7 @@ enum Type {
     TYPE_VOID,
     TYPE_ARRAY,
     TYPE_FUNCTION,
+    TYPE_FILE,
     TYPE_UNDEF
 };
 
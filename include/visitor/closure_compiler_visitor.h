@@ -0,0 +1,218 @@
+#ifndef SYNTHSCRIPT_CLOSURECOMPILERVISITOR_H
+#define SYNTHSCRIPT_CLOSURECOMPILERVISITOR_H
+
+#include "built_in_functions.h"
+#include "call_stack.h"
+#include "error_manager.h"
+#include "object/object.h"
+#include "symbol/scope_pool.h"
+#include "symbol/symbol_table.h"
+#include "visitor.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief A compiled node, which evaluates the node in a scope and returns its value (statements
+ * return an undefined value).
+ */
+using Closure = std::function<Value(SymbolTable *table)>;
+
+/**
+ * @class ClosureCompilerVisitor
+ * @brief Compiles the AST into a tree of closures, and runs them.
+ *
+ * Every visit function compiles a node into a closure that captures everything the node needs to
+ * be evaluated: the closures of its children, its operator, the slots of its variables and the id
+ * of its built-in function. Running the program then calls the closures directly, without
+ * dispatching on the nodes or reading their fields again.
+ *
+ * The closures run with the same scopes, control flow and errors as the InterpreterVisitor, which
+ * remains the reference implementation. The argument of the visit functions is the depth of the
+ * node in the AST.
+ */
+class ClosureCompilerVisitor : public Visitor<Closure, int> {
+public:
+    /**
+     * @brief Construct a new ClosureCompilerVisitor object.
+     * @param program_node The root node of the program to run.
+     * @param error_manager The error manager to use for error handling.
+     *
+     * @note
+     * The visitor does not take ownership of the program node or error manager. The program must
+     * have been analyzed by the SemanticAnalysisVisitor, and outlive the visitor.
+     */
+    ClosureCompilerVisitor(ProgramNode *program_node, ErrorManager *error_manager);
+    ~ClosureCompilerVisitor() = default;
+
+    /**
+     * @brief Compile the program into closures and run it.
+     */
+    void interpret();
+
+    /**
+     * @brief Set the maximum depth of nested function calls, beyond which a runtime error is
+     * reported (DEFAULT_MAX_CALL_DEPTH by default).
+     * @param max_call_depth The maximum depth.
+     */
+    void set_max_call_depth(int max_call_depth) { this->max_call_depth = max_call_depth; }
+
+    Closure visit(ProgramNode *node, int arg) override;
+    Closure visit(BinOpNode *node, int arg) override;
+    Closure visit(CastOpNode *node, int arg) override;
+    Closure visit(SubscriptOpNode *node, int arg) override;
+    Closure visit(SliceOpNode *node, int arg) override;
+    Closure visit(UnaryOpNode *node, int arg) override;
+    Closure visit(ArrayLiteralNode *node, int arg) override;
+    Closure visit(RangeLiteralNode *node, int arg) override;
+    Closure visit(AssignmentNode *node, int arg) override;
+    Closure visit(BreakStatementNode *node, int arg) override;
+    Closure visit(ContinueStatementNode *node, int arg) override;
+    Closure visit(ReturnStatementNode *node, int arg) override;
+    Closure visit(ForStatementNode *node, int arg) override;
+    Closure visit(IfStatementNode *node, int arg) override;
+    Closure visit(RepeatStatementNode *node, int arg) override;
+    Closure visit(WhileStatementNode *node, int arg) override;
+    Closure visit(FunctionDeclarationNode *node, int arg) override;
+    Closure visit(CallOpNode *node, int arg) override;
+    Closure visit(CompoundStatementNode *node, int arg) override;
+    Closure visit(IdentifierNode *node, int arg) override;
+    Closure visit(LiteralNode *node, int arg) override;
+    Closure visit(ErrorNode *node, int arg) override;
+
+private:
+    /**
+     * @brief The error manager to use for error handling.
+     */
+    ErrorManager *error_manager;
+
+    /**
+     * @brief The root node of the program to compile.
+     */
+    ProgramNode *program_node;
+
+    /**
+     * @brief Report a runtime error.
+     *
+     * @param message The error message.
+     * @param line The line of the error.
+     * @param column The column of the error.
+     */
+    void runtime_error(const std::string &message, int line, int column);
+
+    /**
+     * @brief Report that calls are nested too deeply.
+     * @param node The node that nests them further.
+     */
+    void recursion_error(ASTNode *node);
+
+    /**
+     * @brief Compile a child of a node.
+     *
+     * Calls check the space left on the stack, but a single call may nest expressions and blocks
+     * deeper than the space the stack reserves for it. Children at every STACK_CHECK_INTERVAL
+     * levels of the AST check the stack as well, so no path between two checks is longer than
+     * that.
+     *
+     * @param child The child.
+     * @param depth The depth of the node in the AST.
+     * @return The closure of the child.
+     */
+    Closure bind_child(ASTNode *child, int depth);
+
+    /**
+     * @brief Call a built-in function.
+     * @param node The call.
+     * @param built_in_id The id of the built-in function.
+     * @param arguments The closures of the arguments.
+     * @param table The symbol table of the scope of the call.
+     * @return The result of the function.
+     */
+    Value call_built_in(CallOpNode *node,
+                        int built_in_id,
+                        const std::vector<Closure> &arguments,
+                        SymbolTable *table);
+
+    /**
+     * @brief Call a function declared in the program, and the calls it makes in tail position.
+     * @param node The call.
+     * @param function The function.
+     * @param arguments The closures of the arguments.
+     * @param table The symbol table of the scope of the call.
+     * @return The value returned by the function.
+     */
+    Value call_function(CallOpNode *node,
+                        const Value &function,
+                        const std::vector<Closure> &arguments,
+                        SymbolTable *table);
+
+    /**
+     * @brief Built-in functions manager.
+     */
+    BuiltInFunctions built_in_functions;
+
+    /**
+     * @brief Allocator of the symbol tables of block and function scopes.
+     */
+    ScopePool scope_pool;
+
+    /**
+     * @brief The compiled bodies of the functions declared in the program, which their function
+     * objects point to.
+     */
+    std::vector<std::unique_ptr<Closure>> function_bodies;
+
+    /**
+     * @brief The value returned by the innermost function call, void until it returns a value.
+     */
+    Value return_value = Value::make_void();
+
+    /**
+     * @brief The call in tail position that the innermost function call is returning, to be run
+     * in its place, or nullptr.
+     */
+    CallOpNode *tail_call_node = nullptr;
+
+    /**
+     * @brief The function called by tail_call_node.
+     */
+    Value tail_call_function;
+
+    /**
+     * @brief The arguments of tail calls, on top of each other while they are being evaluated (the
+     * arguments of tail_call_node are last).
+     */
+    std::vector<Value> tail_call_arguments;
+
+    /**
+     * @brief The maximum depth of nested function calls.
+     */
+    int max_call_depth = DEFAULT_MAX_CALL_DEPTH;
+
+    /**
+     * @brief The depth of nested function calls being evaluated.
+     */
+    int call_depth = 0;
+
+    /**
+     * @brief The stack the program runs on, while it runs.
+     */
+    CallStack *call_stack = nullptr;
+
+    /**
+     * @brief Stores if the program is backtracking out of a loop body (to break or continue).
+     */
+    bool backtracking = false;
+
+    /**
+     * @brief Stores if the program is breaking out of a loop.
+     */
+    bool breaking = false;
+
+    /**
+     * @brief Stores if the program is returning from a function.
+     */
+    bool returning = false;
+};
+
+#endif // SYNTHSCRIPT_CLOSURECOMPILERVISITOR_H
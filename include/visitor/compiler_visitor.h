@@ -0,0 +1,266 @@
+#ifndef SYNTHSCRIPT_COMPILERVISITOR_H
+#define SYNTHSCRIPT_COMPILERVISITOR_H
+
+#include "built_in_functions.h"
+#include "error_manager.h"
+#include "visitor.h"
+#include "vm/bytecode_program.h"
+#include "symbol/variable_slot.h"
+#include <unordered_map>
+
+/**
+ * @class CompilerVisitor
+ * @brief Compiles the AST into bytecode for the register-based virtual machine.
+ *
+ * Every visit function compiles a node and returns the register that holds its value. The
+ * argument is the register the value must be placed in, or -1 if any register will do (statements
+ * return -1).
+ *
+ * Variables are located using the slots resolved by semantic analysis: block variables live in
+ * registers of the current call frame, while globals live in the global table (in the same slots
+ * as the global scope of the analysis).
+ */
+class CompilerVisitor : public Visitor<int, int> {
+public:
+    /**
+     * @brief Construct a new CompilerVisitor object.
+     * @param program_node The root node of the program to compile.
+     * @param error_manager The error manager to use for error handling.
+     *
+     * @note
+     * The visitor does not take ownership of the program node or error manager. The program must
+     * have been analyzed by the SemanticAnalysisVisitor.
+     */
+    CompilerVisitor(ProgramNode *program_node, ErrorManager *error_manager);
+    ~CompilerVisitor() = default;
+
+    /**
+     * @brief Compile the program.
+     * @return The compiled program.
+     *
+     * @note
+     * The caller is responsible for deleting the returned program.
+     */
+    BytecodeProgram *compile();
+
+    int visit(ProgramNode *node, int dest) override;
+    int visit(BinOpNode *node, int dest) override;
+    int visit(CastOpNode *node, int dest) override;
+    int visit(SubscriptOpNode *node, int dest) override;
+    int visit(SliceOpNode *node, int dest) override;
+    int visit(UnaryOpNode *node, int dest) override;
+    int visit(ArrayLiteralNode *node, int dest) override;
+    int visit(RangeLiteralNode *node, int dest) override;
+    int visit(AssignmentNode *node, int dest) override;
+    int visit(BreakStatementNode *node, int dest) override;
+    int visit(ContinueStatementNode *node, int dest) override;
+    int visit(ReturnStatementNode *node, int dest) override;
+    int visit(ForStatementNode *node, int dest) override;
+    int visit(IfStatementNode *node, int dest) override;
+    int visit(RepeatStatementNode *node, int dest) override;
+    int visit(WhileStatementNode *node, int dest) override;
+    int visit(FunctionDeclarationNode *node, int dest) override;
+    int visit(CallOpNode *node, int dest) override;
+    int visit(CompoundStatementNode *node, int dest) override;
+    int visit(IdentifierNode *node, int dest) override;
+    int visit(LiteralNode *node, int dest) override;
+    int visit(ErrorNode *node, int dest) override;
+
+private:
+    /**
+     * @struct Variable
+     * @brief The compile-time location of a variable.
+     */
+    struct Variable {
+        /**
+         * @brief LOCAL variables live in a register, GLOBAL variables in the global table.
+         *
+         * DYNAMIC variables are assigned inside a function before a global of the same name is
+         * declared. They refer to the global if it exists when they are first assigned, and to a
+         * register otherwise.
+         */
+        enum Kind { LOCAL, GLOBAL, DYNAMIC } kind;
+        int reg;
+        int global;
+    };
+
+    /**
+     * @struct Scope
+     * @brief A block scope of the function being compiled.
+     *
+     * The variables are indexed by their slot in the scope. Slots without a register (-1) are not
+     * declared yet.
+     */
+    struct Scope {
+        std::vector<Variable> variables;
+        int start_register;
+        int start_locals_top;
+    };
+
+    /**
+     * @struct Loop
+     * @brief The jump targets of the loop being compiled.
+     */
+    struct Loop {
+        int continue_target;
+        std::vector<int> break_jumps;
+    };
+
+    /**
+     * @struct FunctionState
+     * @brief The state of a function that is being compiled.
+     */
+    struct FunctionState {
+        FunctionState(BytecodeFunction *function, bool is_main)
+            : function(function), is_main(is_main) {}
+
+        BytecodeFunction *function;
+        bool is_main;
+        std::vector<Scope> scopes;
+        std::vector<Loop> loops;
+        int free_register = 0;
+        int locals_top = 0;
+    };
+
+    /**
+     * @brief The error manager to use for error handling.
+     */
+    ErrorManager *error_manager;
+
+    /**
+     * @brief The root node of the program to compile.
+     */
+    ProgramNode *program_node;
+
+    /**
+     * @brief Built-in functions manager.
+     */
+    BuiltInFunctions built_in_functions;
+
+    /**
+     * @brief The program being compiled.
+     */
+    BytecodeProgram *program = nullptr;
+
+    /**
+     * @brief The functions being compiled, innermost last.
+     */
+    std::vector<FunctionState> functions;
+
+    /**
+     * @brief Compile a node as a statement, discarding its value.
+     * @param node The node to compile.
+     */
+    void compile_statement(ASTNode *node);
+
+    /**
+     * @brief Convert a literal to its value, or emit an error if it is out of range.
+     * @param node The literal.
+     * @return The value, or an undefined value if it is out of range.
+     */
+    Value literal_value(LiteralNode *node);
+
+    /**
+     * @brief Compile the left operand of an operation.
+     *
+     * The operand is copied out of its variable's register if the right operand could change it.
+     *
+     * @param left The left operand.
+     * @param right The right operand.
+     * @return The register holding the left operand.
+     */
+    int compile_left_operand(ASTNode *left, ASTNode *right);
+
+    /**
+     * @brief Compile a function body into a new bytecode function.
+     * @param node The function declaration.
+     * @return The compiled function.
+     */
+    BytecodeFunction *compile_function(FunctionDeclarationNode *node);
+
+    /**
+     * @brief Find a declared variable of the current function.
+     * @param slot The slot of the variable (not global).
+     * @return The variable, or nullptr if it is not declared yet.
+     */
+    Variable *find_variable(const VariableSlot &slot);
+
+    /**
+     * @brief Declare a variable in the current scope.
+     * @param slot The slot of the variable in the scope.
+     * @param variable The location of the variable.
+     */
+    void declare_variable(int slot, const Variable &variable);
+
+    /**
+     * @brief Load a variable into a register.
+     * @param slot The slot of the variable.
+     * @param name The name of the variable (for error messages).
+     * @param dest The destination register (or -1 for any register).
+     * @param node The node to report errors at.
+     * @return The register holding the variable.
+     */
+    int load_variable(const VariableSlot &slot, const std::string &name, int dest, ASTNode *node);
+
+    /**
+     * @brief Emit an instruction in the current function.
+     * @param op The operation.
+     * @param a The first operand.
+     * @param b The second operand.
+     * @param c The third operand.
+     * @param node The node the instruction is compiled from.
+     * @return The index of the instruction.
+     */
+    int emit(OpCode op, int a, int b, int c, ASTNode *node);
+
+    /**
+     * @brief Get the current function state.
+     */
+    FunctionState &current() { return functions.back(); }
+
+    /**
+     * @brief Allocate consecutive temporary registers.
+     * @param count The number of registers.
+     * @return The first allocated register.
+     */
+    int allocate_registers(int count = 1);
+
+    /**
+     * @brief Allocate a register for a new variable in the current scope.
+     * @return The register.
+     */
+    int allocate_local();
+
+    /**
+     * @brief Use the destination register if there is one, otherwise allocate a temporary.
+     * @param dest The destination register (or -1).
+     * @return The register.
+     */
+    int target_register(int dest);
+
+    /**
+     * @brief Copy a value into the destination register if needed.
+     * @param reg The register holding the value.
+     * @param dest The destination register (or -1).
+     * @param node The node the copy is compiled from.
+     * @return The register holding the value (dest if it was given).
+     */
+    int move_to(int reg, int dest, ASTNode *node);
+
+    /**
+     * @brief Open a new block scope.
+     */
+    void push_scope();
+
+    /**
+     * @brief Close the innermost block scope, releasing its registers.
+     */
+    void pop_scope();
+
+    /**
+     * @brief Patch the pending break jumps of the innermost loop and close it.
+     */
+    void pop_loop();
+};
+
+#endif // SYNTHSCRIPT_COMPILERVISITOR_H
@@ -2,48 +2,69 @@
 #define SYNTHSCRIPT_INTERPRETERVISITOR_H
 
 #include "built_in_functions.h"
+#include "call_stack.h"
 #include "error_manager.h"
 #include "object/object.h"
+#include "profiler.h"
+#include "symbol/scope_pool.h"
 #include "symbol/symbol_table.h"
 #include "visitor.h"
 #include <memory>
-#include <stack>
+#include <vector>
 
-class InterpreterVisitor : public Visitor<std::shared_ptr<Object>, SymbolTable *> {
+class InterpreterVisitor : public Visitor<Value, SymbolTable *> {
 public:
     /**
      * @brief Construct a new InterpreterVisitor object
      * @param error_manager The error manager to use for error handling
      *
      * @note
-     * The visitor does not take ownership of the program node or error manager.
+     * The visitor does not take ownership of the program node or error manager. The program must
+     * have been analyzed by the SemanticAnalysisVisitor.
      */
     InterpreterVisitor(ProgramNode *program_node, ErrorManager *error_manager);
     ~InterpreterVisitor() = default;
 
     void interpret();
 
-    std::shared_ptr<Object> visit(ProgramNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(BinOpNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(CastOpNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(SubscriptOpNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(UnaryOpNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(ArrayLiteralNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(RangeLiteralNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(AssignmentNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(BreakStatementNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(ContinueStatementNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(ReturnStatementNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(ForStatementNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(IfStatementNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(RepeatStatementNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(WhileStatementNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(FunctionDeclarationNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(CallOpNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(CompoundStatementNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(IdentifierNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(LiteralNode *node, SymbolTable *table) override;
-    std::shared_ptr<Object> visit(ErrorNode *node, SymbolTable *table) override;
+    /**
+     * @brief Report function calls and statements to a profiler.
+     * @param profiler The profiler, or nullptr to disable profiling.
+     *
+     * @note
+     * The visitor does not take ownership of the profiler.
+     */
+    void set_profiler(Profiler *profiler) { this->profiler = profiler; }
+
+    /**
+     * @brief Set the maximum depth of nested function calls, beyond which a runtime error is
+     * reported (DEFAULT_MAX_CALL_DEPTH by default).
+     * @param max_call_depth The maximum depth.
+     */
+    void set_max_call_depth(int max_call_depth) { this->max_call_depth = max_call_depth; }
+
+    Value visit(ProgramNode *node, SymbolTable *table) override;
+    Value visit(BinOpNode *node, SymbolTable *table) override;
+    Value visit(CastOpNode *node, SymbolTable *table) override;
+    Value visit(SubscriptOpNode *node, SymbolTable *table) override;
+    Value visit(SliceOpNode *node, SymbolTable *table) override;
+    Value visit(UnaryOpNode *node, SymbolTable *table) override;
+    Value visit(ArrayLiteralNode *node, SymbolTable *table) override;
+    Value visit(RangeLiteralNode *node, SymbolTable *table) override;
+    Value visit(AssignmentNode *node, SymbolTable *table) override;
+    Value visit(BreakStatementNode *node, SymbolTable *table) override;
+    Value visit(ContinueStatementNode *node, SymbolTable *table) override;
+    Value visit(ReturnStatementNode *node, SymbolTable *table) override;
+    Value visit(ForStatementNode *node, SymbolTable *table) override;
+    Value visit(IfStatementNode *node, SymbolTable *table) override;
+    Value visit(RepeatStatementNode *node, SymbolTable *table) override;
+    Value visit(WhileStatementNode *node, SymbolTable *table) override;
+    Value visit(FunctionDeclarationNode *node, SymbolTable *table) override;
+    Value visit(CallOpNode *node, SymbolTable *table) override;
+    Value visit(CompoundStatementNode *node, SymbolTable *table) override;
+    Value visit(IdentifierNode *node, SymbolTable *table) override;
+    Value visit(LiteralNode *node, SymbolTable *table) override;
+    Value visit(ErrorNode *node, SymbolTable *table) override;
 
 private:
     /**
@@ -65,15 +86,100 @@ private:
      */
     void runtime_error(const std::string &message, int line, int column);
 
+    /**
+     * @brief Report a runtime error if there is too little space left on the stack to evaluate a
+     * node.
+     *
+     * Calls, blocks and operators check the stack, since a single call may nest expressions and
+     * blocks deeper than the space the stack reserves for it.
+     *
+     * @param node The node about to be evaluated.
+     */
+    void check_stack(ASTNode *node) {
+        if (call_stack && call_stack->is_exhausted()) {
+            recursion_error(node);
+        }
+    }
+
+    /**
+     * @brief Report that calls are nested too deeply.
+     * @param node The node that nests them further.
+     */
+    void recursion_error(ASTNode *node);
+
     /**
      * @brief Built-in functions manager.
      */
     BuiltInFunctions built_in_functions;
 
     /**
-     * @brief Stack of return values from each function call.
+     * @brief Allocator of the symbol tables of block and function scopes.
+     */
+    ScopePool scope_pool;
+
+    /**
+     * @brief The profiler to report to, if profiling is enabled.
+     */
+    Profiler *profiler = nullptr;
+
+    /**
+     * @brief Evaluate a statement, reporting its source line to the profiler.
+     *
+     * Kept out of the statement loops, so they stay lean when profiling is disabled.
+     *
+     * @param statement The statement to evaluate.
+     * @param table The symbol table of the scope of the statement.
+     */
+    void evaluate_profiled_statement(ASTNode *statement, SymbolTable *table);
+
+    /**
+     * @brief Call a built-in function, with the arguments of a call.
+     * @param node The call.
+     * @param built_in_id The id of the built-in function.
+     * @param table The symbol table of the scope of the call.
+     * @return The result of the function.
+     */
+    Value call_built_in(CallOpNode *node, int built_in_id, SymbolTable *table);
+
+    /**
+     * @brief The value returned by the innermost function call, void until it returns a value.
+     *
+     * Calls return in stack order, so a single value is enough: the caller takes it as soon as the
+     * call returns.
+     */
+    Value return_value = Value::make_void();
+
+    /**
+     * @brief The call in tail position that the innermost function call is returning, to be run
+     * in its place, or nullptr.
+     */
+    CallOpNode *tail_call_node = nullptr;
+
+    /**
+     * @brief The function called by tail_call_node.
+     */
+    Value tail_call_function;
+
+    /**
+     * @brief The arguments of tail calls, on top of each other while they are being evaluated (the
+     * arguments of tail_call_node are last).
+     */
+    std::vector<Value> tail_call_arguments;
+
+    /**
+     * @brief The maximum depth of nested function calls.
+     */
+    int max_call_depth = DEFAULT_MAX_CALL_DEPTH;
+
+    /**
+     * @brief The depth of nested function calls being evaluated.
+     */
+    int call_depth = 0;
+
+    /**
+     * @brief The stack the program is interpreted on, while it runs.
      */
-    std::stack<std::shared_ptr<Object>> return_values;
+    CallStack *call_stack = nullptr;
 
     /**
      * @brief Stores if the interpreter is backtracking out of a node.
@@ -0,0 +1,106 @@
+#ifndef SYNTHSCRIPT_OPTIMIZERVISITOR_H
+#define SYNTHSCRIPT_OPTIMIZERVISITOR_H
+
+#include "error_manager.h"
+#include "object/value.h"
+#include "visitor.h"
+#include <vector>
+
+/**
+ * @class OptimizerVisitor
+ * @brief Simplifies the AST before it is run: literals are converted to values once, operations
+ * on constants are folded into literals, and if statements with a constant condition are replaced
+ * by the branch that is taken.
+ *
+ * Every visit function optimizes a node and returns the node that replaces it, or nullptr if a
+ * statement can be removed. A node that is replaced is deleted (the argument is unused).
+ *
+ * Operations that would fail at runtime are never folded, so that the error is still reported when
+ * (and if) they are evaluated.
+ */
+class OptimizerVisitor : public Visitor<ASTNode *, int> {
+public:
+    /**
+     * @brief Construct a new OptimizerVisitor object.
+     * @param program_node The root node of the program to optimize.
+     * @param error_manager The error manager to use for error handling.
+     *
+     * @note
+     * The visitor does not take ownership of the program node or error manager. The program must
+     * have been analyzed by the SemanticAnalysisVisitor, and the slots it resolved stay valid.
+     */
+    OptimizerVisitor(ProgramNode *program_node, ErrorManager *error_manager);
+    ~OptimizerVisitor() = default;
+
+    void optimize();
+
+    ASTNode *visit(ProgramNode *node, int arg) override;
+    ASTNode *visit(BinOpNode *node, int arg) override;
+    ASTNode *visit(CastOpNode *node, int arg) override;
+    ASTNode *visit(SubscriptOpNode *node, int arg) override;
+    ASTNode *visit(SliceOpNode *node, int arg) override;
+    ASTNode *visit(UnaryOpNode *node, int arg) override;
+    ASTNode *visit(ArrayLiteralNode *node, int arg) override;
+    ASTNode *visit(RangeLiteralNode *node, int arg) override;
+    ASTNode *visit(AssignmentNode *node, int arg) override;
+    ASTNode *visit(BreakStatementNode *node, int arg) override;
+    ASTNode *visit(ContinueStatementNode *node, int arg) override;
+    ASTNode *visit(ReturnStatementNode *node, int arg) override;
+    ASTNode *visit(ForStatementNode *node, int arg) override;
+    ASTNode *visit(IfStatementNode *node, int arg) override;
+    ASTNode *visit(RepeatStatementNode *node, int arg) override;
+    ASTNode *visit(WhileStatementNode *node, int arg) override;
+    ASTNode *visit(FunctionDeclarationNode *node, int arg) override;
+    ASTNode *visit(CallOpNode *node, int arg) override;
+    ASTNode *visit(CompoundStatementNode *node, int arg) override;
+    ASTNode *visit(IdentifierNode *node, int arg) override;
+    ASTNode *visit(LiteralNode *node, int arg) override;
+    ASTNode *visit(ErrorNode *node, int arg) override;
+
+private:
+    /**
+     * @brief The error manager to use for error handling.
+     */
+    ErrorManager *error_manager;
+
+    /**
+     * @brief The root node of the program to optimize.
+     */
+    ProgramNode *program_node;
+
+    /**
+     * @brief Optimize a node, which may be nullptr.
+     * @param node The node to optimize.
+     * @return The node that replaces it.
+     */
+    ASTNode *optimize(ASTNode *node);
+
+    /**
+     * @brief Optimize each expression in a list, in place.
+     * @param expressions The expressions.
+     */
+    void optimize_expressions(std::vector<ASTNode *> *expressions);
+
+    /**
+     * @brief Optimize each statement in a list, in place, removing the statements that do nothing.
+     * @param statements The statements.
+     */
+    void optimize_statements(std::vector<ASTNode *> *statements);
+
+    /**
+     * @brief Get the constant value of a node.
+     * @param node The node.
+     * @return The value if the node is a materialized literal, otherwise an undefined value.
+     */
+    static Value get_constant(ASTNode *node);
+
+    /**
+     * @brief Replace a node with a literal of its constant value.
+     * @param node The node to replace, which is deleted.
+     * @param constant The value of the node (an int, float, bool or string).
+     * @return The literal, or the node itself if the value is undefined or not a literal type.
+     */
+    static ASTNode *replace_with_constant(ASTNode *node, const Value &constant);
+};
+
+#endif // SYNTHSCRIPT_OPTIMIZERVISITOR_H
@@ -23,6 +23,7 @@ public:
     void visit(BinOpNode *node, int indentation) override;
     void visit(CastOpNode *node, int indentation) override;
     void visit(SubscriptOpNode *node, int indentation) override;
+    void visit(SliceOpNode *node, int indentation) override;
     void visit(UnaryOpNode *node, int indentation) override;
     void visit(ArrayLiteralNode *node, int indentation) override;
     void visit(RangeLiteralNode *node, int indentation) override;
@@ -5,6 +5,7 @@
 #include "error_manager.h"
 #include "symbol/symbol_table.h"
 #include "visitor.h"
+#include <unordered_set>
 
 class SemanticAnalysisVisitor : public Visitor<void, SymbolTable *> {
 public:
@@ -25,6 +26,7 @@ public:
     void visit(BinOpNode *node, SymbolTable *table) override;
     void visit(CastOpNode *node, SymbolTable *table) override;
     void visit(SubscriptOpNode *node, SymbolTable *table) override;
+    void visit(SliceOpNode *node, SymbolTable *table) override;
     void visit(UnaryOpNode *node, SymbolTable *table) override;
     void visit(ArrayLiteralNode *node, SymbolTable *table) override;
     void visit(RangeLiteralNode *node, SymbolTable *table) override;
@@ -68,6 +70,26 @@ private:
      */
     BuiltInFunctions built_in_functions;
 
+    /**
+     * @brief Every name the top level of the program may declare as a global.
+     */
+    std::unordered_set<std::string> global_names;
+
+    /**
+     * @brief Resolve the slot of a variable that is used in the given scope.
+     *
+     * @param name The name of the variable.
+     * @param table The symbol table of the scope.
+     * @return The slot of the variable (unresolved if it is not declared).
+     */
+    VariableSlot resolve(const std::string &name, SymbolTable *table);
+
+    /**
+     * @brief Collect the names that the given top level statement may declare as globals.
+     * @param node The statement (or expression) to search.
+     */
+    void collect_global_names(ASTNode *node);
+
     /**
      * @brief Report a semantic error.
      *
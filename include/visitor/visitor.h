@@ -10,6 +10,7 @@ public:
     virtual T visit(BinOpNode *node, A arg) = 0;
     virtual T visit(CastOpNode *node, A arg) = 0;
     virtual T visit(SubscriptOpNode *node, A arg) = 0;
+    virtual T visit(SliceOpNode *node, A arg) = 0;
     virtual T visit(UnaryOpNode *node, A arg) = 0;
     virtual T visit(ArrayLiteralNode *node, A arg) = 0;
     virtual T visit(RangeLiteralNode *node, A arg) = 0;
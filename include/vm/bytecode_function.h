@@ -0,0 +1,101 @@
+#ifndef SYNTHSCRIPT_BYTECODEFUNCTION_H
+#define SYNTHSCRIPT_BYTECODEFUNCTION_H
+
+#include "object/object.h"
+#include "vm/instruction.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class BytecodeFunction
+ * @brief The compiled form of a function (or of the top level of a program).
+ *
+ * Each function owns its instructions, the source position of every instruction, a pool of
+ * constant objects and a pool of names used for error messages and built-in dispatch.
+ */
+class BytecodeFunction {
+public:
+    /**
+     * @brief Create a new, empty bytecode function.
+     * @param parameters_size The number of parameters the function takes.
+     */
+    explicit BytecodeFunction(int parameters_size) : parameters_size(parameters_size) {}
+
+    /**
+     * @brief Append an instruction to the function.
+     * @param instruction The instruction to append.
+     * @param line The source line the instruction was compiled from.
+     * @param column The source column the instruction was compiled from.
+     * @return The index of the appended instruction.
+     */
+    int emit(Instruction instruction, int line, int column);
+
+    /**
+     * @brief Set the jump target of a previously emitted jump instruction.
+     * @param index The index of the jump instruction.
+     * @param target The instruction to jump to.
+     */
+    void patch_jump(int index, int target);
+
+    /**
+     * @brief Add an object to the constant pool.
+     * @param constant The constant object.
+     * @return The index of the constant in the pool.
+     */
+    int add_constant(Value constant);
+
+    /**
+     * @brief Add a name to the name pool, reusing an existing entry if possible.
+     * @param name The name to add.
+     * @return The index of the name in the pool.
+     */
+    int add_name(const std::string &name);
+
+    /**
+     * @brief Reserve registers so that the function has at least `count` of them.
+     * @param count The number of registers needed.
+     */
+    void reserve_registers(int count);
+
+    int get_parameters_size() const { return parameters_size; }
+    int get_register_count() const { return register_count; }
+    int get_code_size() const { return (int)code.size(); }
+
+    const Instruction *get_code() const { return code.data(); }
+    const SourcePosition &get_position(int index) const { return positions[index]; }
+    const Value *get_constants() const { return constants.data(); }
+    const std::string &get_name(int index) const { return names[index]; }
+
+private:
+    /**
+     * @brief The instructions of the function.
+     */
+    std::vector<Instruction> code;
+
+    /**
+     * @brief The source position of each instruction (parallel to `code`).
+     */
+    std::vector<SourcePosition> positions;
+
+    /**
+     * @brief The constant pool.
+     */
+    std::vector<Value> constants;
+
+    /**
+     * @brief The name pool.
+     */
+    std::vector<std::string> names;
+
+    /**
+     * @brief The number of parameters, which occupy the first registers of the frame.
+     */
+    int parameters_size;
+
+    /**
+     * @brief The number of registers a call frame of this function needs.
+     */
+    int register_count = 0;
+};
+
+#endif // SYNTHSCRIPT_BYTECODEFUNCTION_H
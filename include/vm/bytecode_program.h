@@ -0,0 +1,65 @@
+#ifndef SYNTHSCRIPT_BYTECODEPROGRAM_H
+#define SYNTHSCRIPT_BYTECODEPROGRAM_H
+
+#include "vm/bytecode_function.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class BytecodeProgram
+ * @brief A compiled program: its functions and its global variables.
+ *
+ * @note
+ * The program owns its functions and deletes them when it is destroyed.
+ */
+class BytecodeProgram {
+public:
+    BytecodeProgram() = default;
+    ~BytecodeProgram();
+
+    BytecodeProgram(const BytecodeProgram &) = delete;
+    BytecodeProgram &operator=(const BytecodeProgram &) = delete;
+
+    /**
+     * @brief Add a function to the program.
+     * @param function The function, which the program takes ownership of.
+     * @return The index of the function.
+     */
+    int add_function(BytecodeFunction *function);
+
+    /**
+     * @brief Add a global variable to the program.
+     * @param name The name of the global variable.
+     * @param initial_value The value of the global when the program starts (undefined by default).
+     * @return The index of the global variable.
+     */
+    int add_global(const std::string &name, Value initial_value = Value());
+
+    /**
+     * @brief Get the entry point of the program (the top level statements).
+     * @return The main function.
+     */
+    BytecodeFunction *get_main_function() const { return functions[0]; }
+
+    int get_globals_size() const { return (int)global_names.size(); }
+    const std::string &get_global_name(int index) const { return global_names[index]; }
+    const std::vector<Value> &get_global_values() const { return global_values; }
+
+private:
+    /**
+     * @brief The functions of the program. The first function is the main function.
+     */
+    std::vector<BytecodeFunction *> functions;
+
+    /**
+     * @brief The names of the global variables.
+     */
+    std::vector<std::string> global_names;
+
+    /**
+     * @brief The initial values of the global variables.
+     */
+    std::vector<Value> global_values;
+};
+
+#endif // SYNTHSCRIPT_BYTECODEPROGRAM_H
@@ -0,0 +1,103 @@
+#ifndef SYNTHSCRIPT_INSTRUCTION_H
+#define SYNTHSCRIPT_INSTRUCTION_H
+
+#include <cstdint>
+
+/**
+ * @brief The operations understood by the virtual machine.
+ *
+ * Operands are named a, b and c. Unless stated otherwise, a is the destination register and b and
+ * c are source registers of the current call frame.
+ */
+enum OpCode : uint8_t {
+    // Moving values around
+    OP_LOAD_CONST,   // a <- constants[b]
+    OP_MOVE,         // a <- b
+    OP_LOAD_GLOBAL,  // a <- globals[b]
+    OP_STORE_GLOBAL, // globals[b] <- a
+    OP_LOAD_DYNAMIC, // a <- b if b is defined, otherwise globals[c]
+    OP_STORE_DYNAMIC, // b <- a if b is defined or globals[c] is undefined, otherwise globals[c] <- a
+    OP_CLEAR,        // a <- undefined
+
+    // Binary operators
+    OP_ADD,
+    OP_SUBTRACT,
+    OP_MULTIPLY,
+    OP_DIVIDE,
+    OP_MODULO,
+    OP_LOGICAL_AND,
+    OP_LOGICAL_OR,
+    OP_BITWISE_AND,
+    OP_BITWISE_OR,
+    OP_BITWISE_XOR,
+    OP_LESS_THAN,
+    OP_LESS_THAN_EQUAL,
+    OP_GREATER_THAN,
+    OP_GREATER_THAN_EQUAL,
+    OP_EQUAL,
+    OP_NOT_EQUAL,
+
+    // Unary operators
+    OP_POSITIVE,
+    OP_NEGATIVE,
+    OP_LOGICAL_NOT,
+    OP_BITWISE_NOT,
+
+    // Other operators
+    OP_CAST,            // a <- cast b to type c
+    OP_SUBSCRIPT,       // a <- b[c]
+    OP_SLICE,           // a <- b[c..c + 1]
+    OP_SUBSCRIPT_STORE, // a[b] <- c
+    OP_NEW_ARRAY,       // a <- [b, b + 1, ..., b + c - 1]
+    OP_NEW_RANGE,       // a <- b..c
+
+    // Checks
+    OP_CHECK_TYPE,   // Report a type error of kind c unless register a has one of the types in b
+    OP_CHECK_ASSIGN, // Report an error if register a holds void
+    OP_RAISE,        // Report the runtime error stored in names[a]
+
+    // Control flow
+    OP_JUMP,          // Jump to instruction a
+    OP_JUMP_IF_FALSE, // Jump to instruction b if a is false (a must be a bool, see CheckKind c)
+    OP_FOR_START,     // a + 1 <- 0 and a + 2 <- the number of elements of an iteration over a
+    OP_FOR_NEXT,      // b <- a[a + 1] and increment a + 1, or jump to c once a + 1 reaches a + 2
+                      // (or a is exhausted)
+    OP_REPEAT_NEXT,   // Increment a + 1 while it is below a, otherwise jump to c
+    OP_CALL,          // a <- call a with arguments a + 1, ..., a + b (called by the name names[c])
+    OP_TAIL_CALL,     // Like OP_CALL, but the callee replaces the current frame (and returns to
+                      // its caller); a built-in callee sets a and continues
+    OP_CALL_BUILT_IN, // a <- call the built-in function c with arguments a + 1, ..., a + b
+    OP_RETURN,        // Return register a to the caller
+    OP_RETURN_VOID,   // Return void to the caller
+};
+
+/**
+ * @brief The kinds of runtime type checks, used to report the matching error message.
+ */
+enum CheckKind : uint8_t {
+    CHECK_RANGE_START,
+    CHECK_RANGE_END,
+    CHECK_FOR_ITERABLE,
+    CHECK_IF_CONDITION,
+    CHECK_WHILE_CONDITION,
+    CHECK_REPEAT_COUNT,
+};
+
+/**
+ * @struct Instruction
+ * @brief A single virtual machine instruction with up to three operands.
+ */
+struct Instruction {
+    OpCode op;
+    int32_t a, b, c;
+};
+
+/**
+ * @struct SourcePosition
+ * @brief The position in the source file that an instruction was compiled from.
+ */
+struct SourcePosition {
+    int line, column;
+};
+
+#endif // SYNTHSCRIPT_INSTRUCTION_H
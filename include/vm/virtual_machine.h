@@ -0,0 +1,115 @@
+#ifndef SYNTHSCRIPT_VIRTUALMACHINE_H
+#define SYNTHSCRIPT_VIRTUALMACHINE_H
+
+#include "built_in_functions.h"
+#include "call_stack.h"
+#include "error_manager.h"
+#include "vm/bytecode_program.h"
+#include <vector>
+
+/**
+ * @class VirtualMachine
+ * @brief Executes a compiled program.
+ *
+ * The virtual machine is register based: each call frame owns a window of a single register stack,
+ * and instructions address the registers of the current frame directly. Calls push a frame on an
+ * explicit frame stack instead of recursing on the native stack.
+ */
+class VirtualMachine {
+public:
+    /**
+     * @brief Construct a new VirtualMachine object.
+     * @param program The program to execute.
+     * @param error_manager The error manager to use for error handling.
+     *
+     * @note
+     * The virtual machine does not take ownership of the program or error manager.
+     */
+    VirtualMachine(BytecodeProgram *program, ErrorManager *error_manager);
+    ~VirtualMachine() = default;
+
+    /**
+     * @brief Run the program from the start of its main function.
+     */
+    void run();
+
+    /**
+     * @brief Set the maximum depth of nested function calls, beyond which a runtime error is
+     * reported (DEFAULT_MAX_CALL_DEPTH by default).
+     * @param max_call_depth The maximum depth.
+     */
+    void set_max_call_depth(int max_call_depth) { this->max_call_depth = max_call_depth; }
+
+private:
+    /**
+     * @struct CallFrame
+     * @brief The state of a function call.
+     */
+    struct CallFrame {
+        /**
+         * @brief The function being executed.
+         */
+        BytecodeFunction *function;
+
+        /**
+         * @brief The index of the next instruction (saved while another frame runs).
+         */
+        int pc;
+
+        /**
+         * @brief The index of the first register of the frame in the register stack.
+         */
+        int base;
+
+        /**
+         * @brief The register stack index that receives the return value.
+         */
+        int return_register;
+    };
+
+    /**
+     * @brief The program to execute.
+     */
+    BytecodeProgram *program;
+
+    /**
+     * @brief The error manager to use for error handling.
+     */
+    ErrorManager *error_manager;
+
+    /**
+     * @brief Built-in functions manager.
+     */
+    BuiltInFunctions built_in_functions;
+
+    /**
+     * @brief The registers of every active call frame.
+     */
+    std::vector<Value> registers;
+
+    /**
+     * @brief The values of the global variables (undefined if it has no value yet).
+     */
+    std::vector<Value> globals;
+
+    /**
+     * @brief The active call frames, innermost last.
+     */
+    std::vector<CallFrame> frames;
+
+    /**
+     * @brief The maximum depth of nested function calls.
+     */
+    int max_call_depth = DEFAULT_MAX_CALL_DEPTH;
+
+    /**
+     * @brief Report a runtime error at the position of an instruction.
+     *
+     * @param message The error message.
+     * @param function The function containing the instruction.
+     * @param pc The index of the instruction.
+     */
+    void runtime_error(const std::string &message, BytecodeFunction *function, int pc);
+};
+
+#endif // SYNTHSCRIPT_VIRTUALMACHINE_H
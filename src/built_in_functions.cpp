@@ -1,179 +1,247 @@
 #include "built_in_functions.h"
 #include "object/array_object.h"
 #include "object/function_object.h"
-#include "object/int_object.h"
 #include "object/string_object.h"
-#include "object/void_object.h"
 #include <filesystem>
 #include <fstream>
 #include <iostream>
-#include <sstream>
+#include <iterator>
 
-BuiltInFunctions::BuiltInFunctions(ErrorManager *error_manager) : error_manager(error_manager) {
-    built_in_functions = {BUILT_IN_FUNCTION(output, 1, this),
-                          BUILT_IN_FUNCTION(input, 0, this),
-                          BUILT_IN_FUNCTION(read, 1, this),
-                          BUILT_IN_FUNCTION(write, 2, this),
-                          BUILT_IN_FUNCTION(append, 2, this),
-                          BUILT_IN_FUNCTION(current_directory, 0, this),
-                          BUILT_IN_FUNCTION(len, 1, this),
-                          BUILT_IN_FUNCTION(sum, 1, this),
-                          BUILT_IN_FUNCTION(product, 1, this)};
+namespace {
+/**
+ * @brief The size from which files read whole are mapped into memory, in bytes.
+ */
+constexpr uintmax_t MIN_MAPPED_FILE_SIZE = 64 * 1024;
+
+/**
+ * @brief Get the canonical path of a file, which may not exist yet.
+ * @param file_path The path of the file.
+ * @return The absolute path, without symbolic links or dot components.
+ */
+std::string canonical_path(const std::string &file_path) {
+    // weakly_canonical leaves a relative path relative when the file doesn't exist yet
+    std::error_code error;
+    std::filesystem::path absolute_path = std::filesystem::absolute(file_path, error);
+    return std::filesystem::weakly_canonical(absolute_path, error).string();
+}
+
+/**
+ * @brief The built-in functions, sorted by name, so that they always get the same ids and global
+ * slots.
+ */
+const BuiltInFunction built_in_function_table[] = {
+    BUILT_IN_FUNCTION(append, 2),
+    BUILT_IN_FUNCTION(close, 1),
+    BUILT_IN_FUNCTION(current_directory, 0),
+    BUILT_IN_FUNCTION(flush, 0),
+    BUILT_IN_FUNCTION(input, 0),
+    BUILT_IN_FUNCTION(len, 1),
+    BUILT_IN_FUNCTION(lines, 1),
+    BUILT_IN_FUNCTION(open, 1),
+    BUILT_IN_FUNCTION(output, 1),
+    BUILT_IN_FUNCTION(product, 1),
+    BUILT_IN_FUNCTION(push, 2),
+    BUILT_IN_FUNCTION(read, 1),
+    BUILT_IN_FUNCTION(read_chunk, 2),
+    BUILT_IN_FUNCTION(read_line, 1),
+    BUILT_IN_FUNCTION(replicate, 2),
+    BUILT_IN_FUNCTION(sum, 1),
+    BUILT_IN_FUNCTION(write, 2),
+};
+} // namespace
+
+BuiltInFunctions::BuiltInFunctions(ErrorManager *error_manager) : error_manager(error_manager) {}
+
+BuiltInFunctions::~BuiltInFunctions() {
+    flush();
 }
 
 void BuiltInFunctions::register_built_in_functions(SymbolTable *symbol_table) {
-    for (const auto &built_in_function : built_in_functions) {
-        std::vector<std::string> parameters(built_in_function.second.param_count);
-        std::shared_ptr<Object> function_object =
-            std::make_shared<FunctionObject>(nullptr, parameters, true);
-        Symbol function_symbol(built_in_function.first, function_object);
+    for (auto &function_object : create_function_objects()) {
+        Symbol function_symbol(function_object.first, function_object.second);
         symbol_table->insert(function_symbol);
     }
 }
 
-std::shared_ptr<Object>
-BuiltInFunctions::handle_built_in_function(const std::string &identifier,
-                                           std::vector<std::shared_ptr<Object>> *arguments,
-                                           int line,
-                                           int col) {
-    return built_in_functions[identifier].function(*arguments, line, col);
+std::vector<std::pair<std::string, Value>> BuiltInFunctions::create_function_objects() {
+    std::vector<std::pair<std::string, Value>> function_objects;
+    for (int id = 0; id < get_count(); id++) {
+        std::vector<std::string> parameters(get(id).param_count);
+        function_objects.emplace_back(
+            get(id).name, Value(std::make_shared<FunctionObject>(nullptr, parameters, id)));
+    }
+    return function_objects;
+}
+
+int BuiltInFunctions::get_count() {
+    return (int)std::size(built_in_function_table);
+}
+
+const BuiltInFunction &BuiltInFunctions::get(int id) {
+    return built_in_function_table[id];
 }
 
-std::shared_ptr<Object> BuiltInFunctions::built_in_output(
-    std::vector<std::shared_ptr<Object>> *arguments, int line, int col) {
-    std::shared_ptr<Object> cast_obj = arguments->at(0)->cast(TYPE_STRING);
-    if (cast_obj == nullptr) {
+void BuiltInFunctions::flush() {
+    std::cout.flush();
+    for (auto &stream : append_streams) {
+        stream.second.flush();
+    }
+}
+
+Value BuiltInFunctions::built_in_output(const Value *arguments, int line, int col) {
+    Value cast_obj = arguments[0].cast(TYPE_STRING);
+    if (!cast_obj.is_defined()) {
         error_manager->runtime_error("Invalid argument to built-in output of type " +
-                                         type_to_string(arguments->at(0)->get_type()),
+                                         type_to_string(arguments[0].get_type()),
                                      line,
                                      col);
     } else {
-        std::cout << std::static_pointer_cast<StringObject>(cast_obj)->get_value() << std::endl;
+        std::cout << cast_obj.as<StringObject>()->get_value() << '\n';
     }
 
-    return std::make_shared<VoidObject>();
+    return Value::make_void();
 }
 
-std::shared_ptr<Object> BuiltInFunctions::built_in_input(
-    std::vector<std::shared_ptr<Object>> *arguments, int line, int col) {
+Value BuiltInFunctions::built_in_input(const Value *arguments, int line, int col) {
     std::string input;
     std::cin >> input;
-    return std::make_shared<StringObject>(input);
+    return Value(std::make_shared<StringObject>(input));
 }
 
-std::shared_ptr<Object> BuiltInFunctions::built_in_read(
-    std::vector<std::shared_ptr<Object>> *arguments, int line, int col) {
-    std::shared_ptr<Object> file_path_obj = arguments->at(0)->cast(TYPE_STRING);
-    if (file_path_obj == nullptr) {
+Value BuiltInFunctions::built_in_read(const Value *arguments, int line, int col) {
+    Value file_path_obj = arguments[0].cast(TYPE_STRING);
+    if (!file_path_obj.is_defined()) {
         error_manager->runtime_error("Invalid argument to built-in read of type " +
-                                         type_to_string(arguments->at(0)->get_type()),
+                                         type_to_string(arguments[0].get_type()),
                                      line,
                                      col);
     }
-    std::string file_path = std::static_pointer_cast<StringObject>(file_path_obj)->get_value();
-    std::ifstream stream(file_path);
+    std::string file_path(file_path_obj.as<StringObject>()->get_value());
+    flush();
+
+    // Large files are mapped into memory instead of being copied (pipes and other special files
+    // can't be mapped, and small files are faster to read)
+    std::error_code error;
+    bool regular_file = std::filesystem::is_regular_file(file_path, error);
+    if (regular_file && std::filesystem::file_size(file_path, error) >= MIN_MAPPED_FILE_SIZE) {
+        auto mapping = std::make_shared<SourceBuffer>();
+        if (mapping->load(file_path)) {
+            mapped_files[canonical_path(file_path)] = mapping;
+            return Value(std::make_shared<StringObject>(std::move(mapping)));
+        }
+    }
+
+    std::ifstream stream(file_path, std::ios_base::in | std::ios_base::binary);
     if (!stream.good()) {
         error_manager->runtime_error("Cannot access file from path '" + file_path + "'", line, col);
     }
-    std::stringstream buffer;
-    buffer << stream.rdbuf();
-    std::string file_text = buffer.str();
-    return std::make_shared<StringObject>(file_text);
+    std::string file_text(std::istreambuf_iterator<char>(stream), {});
+    return Value(std::make_shared<StringObject>(std::move(file_text)));
 }
 
-std::shared_ptr<Object> BuiltInFunctions::built_in_write(
-    std::vector<std::shared_ptr<Object>> *arguments, int line, int col) {
-    std::shared_ptr<Object> file_path_obj = arguments->at(0)->cast(TYPE_STRING);
-    if (file_path_obj == nullptr) {
+Value BuiltInFunctions::built_in_write(const Value *arguments, int line, int col) {
+    Value file_path_obj = arguments[0].cast(TYPE_STRING);
+    if (!file_path_obj.is_defined()) {
         error_manager->runtime_error("Invalid argument to built-in write of type " +
-                                         type_to_string(arguments->at(0)->get_type()),
+                                         type_to_string(arguments[0].get_type()),
                                      line,
                                      col);
     }
-    std::string file_path = std::static_pointer_cast<StringObject>(file_path_obj)->get_value();
-    std::shared_ptr<Object> file_text_obj = arguments->at(1)->cast(TYPE_STRING);
-    if (file_text_obj == nullptr) {
+    std::string file_path(file_path_obj.as<StringObject>()->get_value());
+    Value file_text_obj = arguments[1].cast(TYPE_STRING);
+    if (!file_text_obj.is_defined()) {
         error_manager->runtime_error("Invalid argument to built-in write of type " +
-                                         type_to_string(arguments->at(1)->get_type()),
+                                         type_to_string(arguments[1].get_type()),
                                      line,
                                      col);
     }
-    std::string file_text = std::static_pointer_cast<StringObject>(file_text_obj)->get_value();
+    std::string file_text(file_text_obj.as<StringObject>()->get_value());
+    flush();
+    detach_mapped_file(file_path);
     std::ofstream stream(file_path);
     stream << file_text;
-    return std::make_shared<VoidObject>();
+    return Value::make_void();
 }
 
-std::shared_ptr<Object> BuiltInFunctions::built_in_append(
-    std::vector<std::shared_ptr<Object>> *arguments, int line, int col) {
-    std::shared_ptr<Object> file_path_obj = arguments->at(0)->cast(TYPE_STRING);
-    if (file_path_obj == nullptr) {
+Value BuiltInFunctions::built_in_append(const Value *arguments, int line, int col) {
+    Value file_path_obj = arguments[0].cast(TYPE_STRING);
+    if (!file_path_obj.is_defined()) {
         error_manager->runtime_error("Invalid argument to built-in append of type " +
-                                         type_to_string(arguments->at(0)->get_type()),
+                                         type_to_string(arguments[0].get_type()),
                                      line,
                                      col);
     }
-    std::string file_path = std::static_pointer_cast<StringObject>(file_path_obj)->get_value();
-    std::shared_ptr<Object> file_text_obj = arguments->at(1)->cast(TYPE_STRING);
-    if (file_text_obj == nullptr) {
+    std::string file_path(file_path_obj.as<StringObject>()->get_value());
+    Value file_text_obj = arguments[1].cast(TYPE_STRING);
+    if (!file_text_obj.is_defined()) {
         error_manager->runtime_error("Invalid argument to built-in append of type " +
-                                         type_to_string(arguments->at(1)->get_type()),
+                                         type_to_string(arguments[1].get_type()),
                                      line,
                                      col);
     }
-    std::string file_text = std::static_pointer_cast<StringObject>(file_text_obj)->get_value();
-    std::ofstream stream(file_path, std::ios_base::app);
-    stream << file_text;
-    return std::make_shared<VoidObject>();
+
+    // The file stays open, so appending to it again (as a log) needs no system calls until the
+    // buffer is full. Files are opened in append mode, so writes always go to the end of the file.
+    std::string key = canonical_path(file_path);
+    auto stream = append_streams.find(key);
+    if (stream == append_streams.end()) {
+        if (append_streams.size() >= MAX_APPEND_STREAMS) {
+            append_streams.erase(append_streams.begin());
+        }
+        stream = append_streams.emplace(key, std::ofstream(file_path, std::ios_base::app)).first;
+    }
+    stream->second << file_text_obj.as<StringObject>()->get_value();
+    return Value::make_void();
 }
 
-std::shared_ptr<Object> BuiltInFunctions::built_in_current_directory(
-    std::vector<std::shared_ptr<Object>> *arguments, int line, int col) {
+Value BuiltInFunctions::built_in_current_directory(const Value *arguments, int line, int col) {
     try {
         std::string cwd_str = std::filesystem::current_path().string();
-        return std::make_shared<StringObject>(cwd_str);
+        return Value(std::make_shared<StringObject>(cwd_str));
     } catch (const std::filesystem::filesystem_error &e) {
         error_manager->runtime_error(
             "Error getting current directory: " + std::string(e.what()), line, col);
-        return nullptr;
+        return {};
     }
 }
 
-std::shared_ptr<Object>
-BuiltInFunctions::built_in_len(std::vector<std::shared_ptr<Object>> *arguments, int line, int col) {
-    if (arguments->at(0)->get_type() != TYPE_ARRAY && arguments->at(0)->get_type() != TYPE_STRING) {
+Value BuiltInFunctions::built_in_len(const Value *arguments, int line, int col) {
+    if (arguments[0].get_type() != TYPE_ARRAY && arguments[0].get_type() != TYPE_STRING) {
         error_manager->runtime_error("Invalid argument to built-in len of type " +
-                                         type_to_string(arguments->at(0)->get_type()),
+                                         type_to_string(arguments[0].get_type()),
                                      line,
                                      col);
     }
 
-    if (arguments->at(0)->get_type() == TYPE_ARRAY) {
-        return std::make_shared<IntObject>(
-            std::static_pointer_cast<ArrayObject>(arguments->at(0))->get_len());
+    if (arguments[0].get_type() == TYPE_ARRAY) {
+        return Value::from_int(arguments[0].as<ArrayObject>()->get_len());
     } else {
-        return std::make_shared<IntObject>(
-            std::static_pointer_cast<StringObject>(arguments->at(0))->get_len());
+        return Value::from_int(arguments[0].as<StringObject>()->get_len());
     }
 }
 
-std::shared_ptr<Object>
-BuiltInFunctions::built_in_sum(std::vector<std::shared_ptr<Object>> *arguments, int line, int col) {
-    if (arguments->at(0)->get_type() != TYPE_ARRAY) {
+Value BuiltInFunctions::built_in_sum(const Value *arguments, int line, int col) {
+    if (arguments[0].get_type() != TYPE_ARRAY) {
         error_manager->runtime_error("Invalid argument to built-in sum of type " +
-                                         type_to_string(arguments->at(0)->get_type()),
+                                         type_to_string(arguments[0].get_type()),
                                      line,
                                      col);
     }
 
-    std::shared_ptr<Object> sum = std::make_shared<IntObject>(0);
-    std::vector<std::shared_ptr<Object>> arg_value =
-        *std::static_pointer_cast<ArrayObject>(arguments->at(0))->get_value();
-    for (auto &argument : arg_value) {
-        sum = sum->add(argument);
-        if (sum == nullptr) {
+    // Packed numbers are summed with a single loop, and other elements one value at a time
+    auto *array = arguments[0].as<ArrayObject>();
+    Value sum = array->packed_sum();
+    if (sum.is_defined()) {
+        return sum;
+    }
+
+    sum = Value::from_int(0);
+    for (int i = 0; i < array->get_len(); i++) {
+        Value argument = array->get_element(i);
+        sum = sum.add(argument);
+        if (!sum.is_defined()) {
             error_manager->runtime_error("Invalid argument to built-in sum of type " +
-                                             type_to_string(argument->get_type()),
+                                             type_to_string(argument.get_type()),
                                          line,
                                          col);
         }
@@ -181,26 +249,142 @@ BuiltInFunctions::built_in_sum(std::vector<std::shared_ptr<Object>> *arguments,
     return sum;
 }
 
-std::shared_ptr<Object> BuiltInFunctions::built_in_product(
-    std::vector<std::shared_ptr<Object>> *arguments, int line, int col) {
-    if (arguments->at(0)->get_type() != TYPE_ARRAY) {
+Value BuiltInFunctions::built_in_product(const Value *arguments, int line, int col) {
+    if (arguments[0].get_type() != TYPE_ARRAY) {
         error_manager->runtime_error("Invalid argument to built-in product of type " +
-                                         type_to_string(arguments->at(0)->get_type()),
+                                         type_to_string(arguments[0].get_type()),
                                      line,
                                      col);
     }
 
-    std::shared_ptr<Object> product = std::make_shared<IntObject>(1);
-    std::vector<std::shared_ptr<Object>> arg_value =
-        *std::static_pointer_cast<ArrayObject>(arguments->at(0))->get_value();
-    for (auto &argument : arg_value) {
-        product = product->multiply(argument);
-        if (product == nullptr) {
+    auto *array = arguments[0].as<ArrayObject>();
+    Value product = array->packed_product();
+    if (product.is_defined()) {
+        return product;
+    }
+
+    product = Value::from_int(1);
+    for (int i = 0; i < array->get_len(); i++) {
+        Value argument = array->get_element(i);
+        product = product.multiply(argument);
+        if (!product.is_defined()) {
             error_manager->runtime_error("Invalid argument to built-in product of type " +
-                                             type_to_string(argument->get_type()),
+                                             type_to_string(argument.get_type()),
                                          line,
                                          col);
         }
     }
     return product;
 }
+
+Value BuiltInFunctions::built_in_push(const Value *arguments, int line, int col) {
+    if (arguments[0].get_type() != TYPE_ARRAY) {
+        error_manager->runtime_error("Invalid argument to built-in push of type " +
+                                         type_to_string(arguments[0].get_type()),
+                                     line,
+                                     col);
+    }
+
+    // The array grows in place, so every reference to it sees the new element
+    arguments[0].as<ArrayObject>()->push(arguments[1]);
+    return Value::make_void();
+}
+
+Value BuiltInFunctions::built_in_replicate(const Value *arguments, int line, int col) {
+    if (arguments[0].get_type() != TYPE_ARRAY) {
+        error_manager->runtime_error("Invalid argument to built-in replicate of type " +
+                                         type_to_string(arguments[0].get_type()),
+                                     line,
+                                     col);
+    }
+    if (arguments[1].get_type() != TYPE_INT) {
+        error_manager->runtime_error("Invalid argument to built-in replicate of type " +
+                                         type_to_string(arguments[1].get_type()),
+                                     line,
+                                     col);
+    }
+    if (arguments[1].get_int() < 0) {
+        error_manager->runtime_error("Count of built-in replicate must be non-negative", line, col);
+    }
+    return arguments[0].as<ArrayObject>()->repeat(arguments[1].get_int());
+}
+
+Value BuiltInFunctions::built_in_open(const Value *arguments, int line, int col) {
+    Value file_path_obj = arguments[0].cast(TYPE_STRING);
+    if (!file_path_obj.is_defined()) {
+        error_manager->runtime_error("Invalid argument to built-in open of type " +
+                                         type_to_string(arguments[0].get_type()),
+                                     line,
+                                     col);
+    }
+    std::string file_path(file_path_obj.as<StringObject>()->get_value());
+    flush();
+    auto file = std::make_shared<FileObject>(file_path);
+    if (!file->is_open()) {
+        error_manager->runtime_error("Cannot access file from path '" + file_path + "'", line, col);
+    }
+    return Value(file);
+}
+
+Value BuiltInFunctions::built_in_lines(const Value *arguments, int line, int col) {
+    // The file is read one line at a time by the loop that iterates over it
+    return built_in_open(arguments, line, col);
+}
+
+Value BuiltInFunctions::built_in_read_line(const Value *arguments, int line, int col) {
+    return get_open_file(arguments[0], "read_line", line, col)->read_line();
+}
+
+Value BuiltInFunctions::built_in_read_chunk(const Value *arguments, int line, int col) {
+    FileObject *file = get_open_file(arguments[0], "read_chunk", line, col);
+    if (arguments[1].get_type() != TYPE_INT) {
+        error_manager->runtime_error("Invalid argument to built-in read_chunk of type " +
+                                         type_to_string(arguments[1].get_type()),
+                                     line,
+                                     col);
+    }
+    if (arguments[1].get_int() < 0) {
+        error_manager->runtime_error("Size of built-in read_chunk must be non-negative", line, col);
+    }
+    return file->read_chunk(arguments[1].get_int());
+}
+
+Value BuiltInFunctions::built_in_close(const Value *arguments, int line, int col) {
+    get_open_file(arguments[0], "close", line, col)->close();
+    return Value::make_void();
+}
+
+Value BuiltInFunctions::built_in_flush(const Value *arguments, int line, int col) {
+    flush();
+    return Value::make_void();
+}
+
+void BuiltInFunctions::detach_mapped_file(const std::string &file_path) {
+    auto entry = mapped_files.find(canonical_path(file_path));
+    if (entry == mapped_files.end()) {
+        return;
+    }
+
+    if (auto mapping = entry->second.lock()) {
+        mapping->assign(std::string(mapping->get_text()));
+    }
+    mapped_files.erase(entry);
+}
+
+FileObject *BuiltInFunctions::get_open_file(const Value &argument,
+                                            const std::string &name,
+                                            int line,
+                                            int col) {
+    if (argument.get_type() != TYPE_FILE) {
+        error_manager->runtime_error("Invalid argument to built-in " + name + " of type " +
+                                         type_to_string(argument.get_type()),
+                                     line,
+                                     col);
+    }
+
+    auto *file = argument.as<FileObject>();
+    if (!file->is_open()) {
+        error_manager->runtime_error("File '" + file->get_path() + "' is closed", line, col);
+    }
+    return file;
+}
@@ -0,0 +1,130 @@
+#include "call_stack.h"
+#include <cstdint>
+#include <exception>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sys/mman.h>
+#endif
+
+namespace {
+/**
+ * @brief A function to run on a thread, and the exception it threw.
+ */
+struct ThreadTask {
+    const std::function<void()> *function;
+    std::exception_ptr exception;
+};
+
+/**
+ * @brief The entry point of the thread of a CallStack.
+ * @param argument The ThreadTask.
+ * @return nullptr.
+ */
+void *run_task(void *argument) {
+    auto *task = static_cast<ThreadTask *>(argument);
+    try {
+        (*task->function)();
+    } catch (...) {
+        task->exception = std::current_exception();
+    }
+    return nullptr;
+}
+} // namespace
+
+CallStack::CallStack(int max_call_depth) {
+#ifndef _WIN32
+    size_t requested = (max_call_depth > 0 ? (size_t)max_call_depth : 1) * BYTES_PER_CALL;
+
+    // Only reserve the address space: pages are committed when they are first touched. Where the
+    // address space is limited (by ulimit -v, for example), a smaller stack is reserved instead.
+    size = requested + BASE_SIZE + RESERVE_SIZE;
+    while (true) {
+        void *mapping = mmap(nullptr,
+                             size,
+                             PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                             -1,
+                             0);
+        if (mapping != MAP_FAILED) {
+            memory = static_cast<char *>(mapping);
+            return;
+        }
+        if (size / 2 < MIN_SIZE) {
+            size = 0;
+            return;
+        }
+        size /= 2;
+    }
+#else
+    (void)max_call_depth;
+#endif
+}
+
+CallStack::~CallStack() {
+#ifndef _WIN32
+    if (memory) {
+        munmap(memory, size);
+    }
+#endif
+}
+
+void CallStack::run(const std::function<void()> &function) {
+#ifndef _WIN32
+    if (memory) {
+        limit = reinterpret_cast<uintptr_t>(memory) + RESERVE_SIZE;
+        ThreadTask task{&function, nullptr};
+        pthread_attr_t attributes;
+        pthread_t thread;
+        bool started = false;
+        if (pthread_attr_init(&attributes) == 0) {
+            started = pthread_attr_setstack(&attributes, memory, size) == 0 &&
+                      pthread_create(&thread, &attributes, run_task, &task) == 0;
+            pthread_attr_destroy(&attributes);
+        }
+
+        if (started) {
+            pthread_join(thread, nullptr);
+            if (task.exception) {
+                std::rethrow_exception(task.exception);
+            }
+            return;
+        }
+
+        // Without a thread, the stack is not used
+        munmap(memory, size);
+        memory = nullptr;
+        size = 0;
+    }
+#endif
+
+    limit_to_calling_thread();
+    function();
+}
+
+bool CallStack::is_exhausted() const {
+    if (!limit) {
+        return false;
+    }
+
+    // The stack grows down, towards the limit
+    char marker;
+    return reinterpret_cast<uintptr_t>(&marker) < limit;
+}
+
+void CallStack::limit_to_calling_thread() {
+    limit = 0;
+#if defined(__linux__)
+    pthread_attr_t attributes;
+    if (pthread_getattr_np(pthread_self(), &attributes) != 0) {
+        return;
+    }
+
+    void *stack = nullptr;
+    size_t stack_size = 0;
+    if (pthread_attr_getstack(&attributes, &stack, &stack_size) == 0 && stack_size > RESERVE_SIZE) {
+        limit = reinterpret_cast<uintptr_t>(stack) + RESERVE_SIZE;
+    }
+    pthread_attr_destroy(&attributes);
+#endif
+}
@@ -1,5 +1,4 @@
 #include "error_manager.h"
-#include "reader.h"
 #include <iostream>
 
 ErrorManager::ErrorManager() {
@@ -38,10 +37,10 @@ void ErrorManager::runtime_error(const std::string &message, int line, int col)
 }
 
 void ErrorManager::show_position(int line, int col) {
-    if (!file_lines.empty()) {
+    if (source && line >= 1 && (size_t)line <= source->get_line_count()) {
         // Show '^' under a specific position in the file
         std::string position = std::string(col - 1, ' ') + "^\n";
-        std::cout << file_lines[line - 1] << position;
+        std::cout << source->get_line(line) << "\n" << position;
     }
 }
 
@@ -61,6 +60,6 @@ ErrorManager::BuildStatus ErrorManager::get_status() {
     return (error_count > 0) ? BuildStatus::FAILURE : BuildStatus::SUCCESS;
 }
 
-void ErrorManager::set_file_lines(const std::vector<std::string> &lines) {
-    file_lines = std::move(lines);
+void ErrorManager::set_source(const SourceBuffer *source) {
+    this->source = source;
 }
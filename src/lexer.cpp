@@ -1,111 +1,374 @@
 #include "lexer.h"
-#include <regex>
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
 
-Lexer::Lexer(const std::string &code, ErrorManager *error_manager)
-    : code(std::move(code)), error_manager(error_manager) {}
+namespace {
+/**
+ * @brief The character that starts a comment (and, doubled, starts or ends a multi-line comment).
+ */
+constexpr char comment_char = '#';
 
-std::vector<Token> Lexer::parse_tokens() {
-    // Preparation for lexical analysis
-    prepare_prefixes(code);
-    std::string token_regex = combine_regex();
+/**
+ * @brief Maps each keyword (and bool literal) to its token type.
+ */
+const std::unordered_map<std::string_view, TokenType> keyword_tokens = {
+    {"and", LOGICAL_AND_OPERATOR},
+    {"or", LOGICAL_OR_OPERATOR},
+    {"not", LOGICAL_NOT_OPERATOR},
+    {"for", FOR_KEYWORD},
+    {"repeat", REPEAT_KEYWORD},
+    {"while", WHILE_KEYWORD},
+    {"if", IF_KEYWORD},
+    {"else", ELSE_KEYWORD},
+    {"next", CONTINUE_KEYWORD},
+    {"stop", BREAK_KEYWORD},
+    {"return", RETURN_KEYWORD},
+    {"in", IN_KEYWORD},
+    {"function", FUNCTION_KEYWORD},
+    {"int", INT_TYPE},
+    {"float", FLOAT_TYPE},
+    {"string", STRING_TYPE},
+    {"bool", BOOL_TYPE},
+    {"void", VOID_TYPE},
+    {"array", ARRAY_TYPE},
+    {"true", BOOL_LITERAL},
+    {"false", BOOL_LITERAL},
+};
+
+/**
+ * @brief Check if a character is a decimal digit.
+ */
+bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Check if a character can be part of an identifier (a letter, digit or underscore).
+ */
+bool is_word(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || is_digit(c) || c == '_';
+}
+
+/**
+ * @brief Check if a character separates undefined tokens (a space, tab, new line or comment).
+ */
+bool is_separator(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == comment_char;
+}
+
+/**
+ * @brief Find the end of a single-line comment, before the new line that ends it.
+ * @param code The code.
+ * @param start The position of the comment character.
+ * @return The position of the new line, or the size of the code.
+ */
+size_t find_line_end(std::string_view code, size_t start) {
+    size_t end = code.find('\n', start);
+    return end == std::string_view::npos ? code.size() : end;
+}
+} // namespace
+
+Lexer::Lexer(std::string_view code, ErrorManager *error_manager)
+    : code(code), error_manager(error_manager) {}
 
+std::vector<Token> Lexer::parse_tokens() {
     // Lexical analysis
-    std::vector<Token> tokens = get_tokens(code, token_regex);
+    std::vector<Token> tokens = get_tokens();
 
     return tokens;
 }
 
-std::string Lexer::combine_regex() {
-    // Combine all the regexes into one with the format:
-    // (regex_1)|(regex_2)|...|(regex_N)
-    std::string token_regex;
-    for (auto &token_expr : token_regexs) {
-        token_regex += "(" + token_expr.second + ")";
-        token_regex += "|";
+void Lexer::lexer_error(std::string_view token, int line, int col) {
+    error_manager->error_at_pos("Undefined token: '" + std::string(token) + "'", line, col);
+}
+
+std::vector<Token> Lexer::get_tokens() {
+    std::vector<Token> tokens;
+
+    // Tokenize the code
+    size_t start = 0;
+    while (start < code.size()) {
+        // Skip spaces and tabs between tokens
+        if (code[start] == ' ' || code[start] == '\t') {
+            if (code[start] == '\t' && escape_position != std::string_view::npos) {
+                add_undefined_escape(tokens);
+            }
+            start++;
+            continue;
+        }
+
+        // Skip comments
+        if (code[start] == comment_char) {
+            start = skip_comment(start, tokens);
+            continue;
+        }
+
+        // A backslash followed by comments still escapes the next new line
+        if (escape_position != std::string_view::npos) {
+            if (code[start] == '\n') {
+                escape_position = std::string_view::npos;
+                start++;
+                continue;
+            }
+            add_undefined_escape(tokens);
+        }
+        if (code[start] == '\\') {
+            size_t position = code.find_first_not_of(' ', start + 1);
+            if (position != std::string_view::npos && code[position] == comment_char) {
+                escape_position = start;
+                start = position;
+                continue;
+            }
+        }
+
+        // Parse the token (positioned at its last character)
+        TokenType type;
+        size_t end = scan_token(code, start, type);
+        std::string_view value = code.substr(start, end - start);
+        move_to(end - 1);
+
+        // Check for undefined tokens
+        if (type == UNDEFINED) {
+            lexer_error(value, line, get_column(end - 1));
+        }
+
+        // Don't include new line escapes in the token list
+        if (type != ESCAPED_NEW_LINE) {
+            tokens.emplace_back(type, value, line, get_column(end - 1));
+        }
+
+        start = end;
+    }
+    if (escape_position != std::string_view::npos) {
+        add_undefined_escape(tokens);
     }
 
-    // Remove extra separator ('|')
-    token_regex.pop_back();
+    // Add the end of file token
+    move_to(code.size());
+    tokens.emplace_back(END_OF_FILE, std::string_view(), line, get_column(code.size()));
 
-    return token_regex;
+    return tokens;
 }
 
-void Lexer::lexer_error(const std::string &token, int line, int col) {
-    error_manager->error_at_pos("Undefined token: '" + token + "'", line, col);
+void Lexer::add_undefined_escape(std::vector<Token> &tokens) {
+    // Only spaces and single-line comments follow the backslash, so it is on the current line
+    std::string_view value = code.substr(escape_position, 1);
+    lexer_error(value, line, get_column(escape_position));
+    tokens.emplace_back(UNDEFINED, value, line, get_column(escape_position));
+    escape_position = std::string_view::npos;
 }
 
-void Lexer::prepare_prefixes(std::string &code) {
-    // Add one for EOF token
-    line_prefix.assign(code.size() + 1, 0);
-    line_offset_prefix.assign(code.size() + 1, 0);
+size_t Lexer::skip_comment(size_t start, std::vector<Token> &tokens) {
+    // Comments are whitespace, so new lines before them are counted as usual
+    move_to(start);
+
+    size_t end;
+    if (start + 1 < code.size() && code[start + 1] == comment_char) {
+        // A multi-line comment ends after the next double comment character
+        end = code.find(std::string_view("##"), start + 2);
+        end = end == std::string_view::npos ? code.size() : end + 2;
+    } else {
+        end = find_line_end(code, start);
+    }
+    comment_start = start;
+    comment_end = end;
 
-    // Prepare the line and line offset prefixes
-    int last_line_start = 0;
-    int current_line = 1;
-    for (size_t i = 0; i < code.size(); i++) {
-        line_offset_prefix[i] = last_line_start;
-        line_prefix[i] = current_line;
+    // Only spaces may come between an escape and its new line, and tabs are kept in comments
+    if (escape_position != std::string_view::npos) {
+        size_t tab = code.substr(0, end).find_first_of("\t\n", start);
+        if (tab != std::string_view::npos && code[tab] == '\t') {
+            add_undefined_escape(tokens);
+        }
+    }
 
-        // New line
-        if (code[i] == '\n' && !(i != 0 && code[i - 1] == '\\')) {
-            last_line_start = i + 1;
-            current_line++;
+    // The new lines of multi-line comments are still tokens, unless escaped
+    for (size_t position = start; (position = code.find('\n', position)) < end; position++) {
+        move_to(position);
+        if (escape_position != std::string_view::npos) {
+            escape_position = std::string_view::npos;
+            continue;
         }
+        tokens.emplace_back(NEW_LINE, code.substr(position, 1), line, get_column(position));
     }
 
-    // Add the EOF token
-    line_offset_prefix[code.size()] = last_line_start;
-    line_prefix[code.size()] = current_line;
+    return end;
 }
 
-std::vector<Token> Lexer::get_tokens(std::string &code, std::string &token_regex) {
-    std::vector<Token> tokens;
+void Lexer::move_to(size_t position) {
+    while (line_position < position) {
+        const void *new_line =
+            std::memchr(code.data() + line_position, '\n', position - line_position);
+        if (!new_line) {
+            break;
+        }
+        size_t i = static_cast<const char *>(new_line) - code.data();
 
-    // Prepare regex
-    std::regex reg(token_regex);
-    std::smatch match;
+        // An escaped new line doesn't start a new line (backslashes in comments don't escape)
+        bool escaped = i != 0 && code[i - 1] == '\\' &&
+                       !(i - 1 >= comment_start && i - 1 < comment_end);
+        if (!escaped) {
+            line++;
+            line_start = i + 1;
+        }
+        line_position = i + 1;
+    }
+    line_position = std::max(line_position, position);
+}
 
-    // Tokenize the code
-    auto start = code.cbegin(), end = code.cend();
-    while (regex_search(start, end, match, reg)) {
-        // First match is the entire regex, the rest are the individual groups
-        for (int i = 1; i < (int)match.size(); i++) {
-            int token_idx = i - 1;
-            bool is_match_empty = match[i].str().empty();
-            if (!is_match_empty) {
-                // Parse the token
-                int position = (int)(match[i].second - code.cbegin()) - 1;
-                int line = get_line(position), column = get_column(position);
-                Token cur_token(token_regexs[token_idx].first, match[i].str(), line, column);
-
-                // Check for undefined tokens
-                if (token_regexs[token_idx].first == UNDEFINED) {
-                    lexer_error(match[i].str(), line, column);
-                }
+size_t Lexer::scan_token(std::string_view code, size_t start, TokenType &type) {
+    size_t size = code.size();
+    size_t position = start + 1;
+    char next = position < size ? code[position] : '\0';
 
-                // Don't include new line escapes in the token list
-                if (token_regexs[token_idx].first != ESCAPED_NEW_LINE) {
-                    tokens.push_back(cur_token);
+    switch (code[start]) {
+    case '"':
+        // String literal, where a backslash escapes any character other than a line break
+        while (position < size && code[position] != '"') {
+            if (code[position] == '\\') {
+                if (position + 1 >= size || code[position + 1] == '\n' ||
+                    code[position + 1] == '\r') {
+                    break;
                 }
-
-                // Move the start position to the end of the current match
-                start = match[i].second;
-                break;
+                position++;
+            }
+            position++;
+        }
+        if (position < size && code[position] == '"') {
+            type = STRING_LITERAL;
+            return position + 1;
+        }
+        break;
+    case '<':
+        if (next == '-') {
+            type = ASSIGNMENT_OPERATOR;
+            return start + 2;
+        } else if (next == '=') {
+            type = LESS_THAN_EQUAL_OPERATOR;
+            return start + 2;
+        }
+        type = LESS_THAN_OPERATOR;
+        return position;
+    case '>':
+        if (next == '=') {
+            type = GREATER_THAN_EQUAL_OPERATOR;
+            return start + 2;
+        }
+        type = GREATER_THAN_OPERATOR;
+        return position;
+    case '!':
+        if (next == '=') {
+            type = NOT_EQUAL_OPERATOR;
+            return start + 2;
+        }
+        break;
+    case '.':
+        if (next == '.') {
+            type = RANGE_SYMBOL;
+            return start + 2;
+        }
+        break;
+    case '\\':
+        // Escaped new line, with optional spaces before the new line
+        while (position < size && code[position] == ' ') {
+            position++;
+        }
+        if (position < size && code[position] == '\n') {
+            type = ESCAPED_NEW_LINE;
+            return position + 1;
+        }
+        break;
+    case '\n':
+        type = NEW_LINE;
+        return position;
+    case '+':
+        type = ADDITION_OPERATOR;
+        return position;
+    case '-':
+        type = SUBTRACTION_OPERATOR;
+        return position;
+    case '*':
+        type = MULTIPLICATIVE_OPERATOR;
+        return position;
+    case '/':
+        type = DIVISION_OPERATOR;
+        return position;
+    case '%':
+        type = MOD_OPERATOR;
+        return position;
+    case '&':
+        type = BITWISE_AND_OPERATOR;
+        return position;
+    case '|':
+        type = BITWISE_OR_OPERATOR;
+        return position;
+    case '^':
+        type = BITWISE_XOR_OPERATOR;
+        return position;
+    case '~':
+        type = BITWISE_NOT_OPERATOR;
+        return position;
+    case '=':
+        type = EQUAL_OPERATOR;
+        return position;
+    case '(':
+        type = LPAREN;
+        return position;
+    case ')':
+        type = RPAREN;
+        return position;
+    case '{':
+        type = LBRACE;
+        return position;
+    case '}':
+        type = RBRACE;
+        return position;
+    case '[':
+        type = LBRACKET;
+        return position;
+    case ']':
+        type = RBRACKET;
+        return position;
+    case ',':
+        type = COMMA;
+        return position;
+    default:
+        if (is_digit(code[start])) {
+            // Int literal, or float literal if the digits are followed by '.' and more digits
+            while (position < size && is_digit(code[position])) {
+                position++;
+            }
+            type = INT_LITERAL;
+            if (position + 1 < size && code[position] == '.' && is_digit(code[position + 1])) {
+                position += 2;
+                while (position < size && is_digit(code[position])) {
+                    position++;
+                }
+                type = FLOAT_LITERAL;
+            }
+            return position;
+        } else if (is_word(code[start])) {
+            // Keyword, bool literal or identifier
+            while (position < size && is_word(code[position])) {
+                position++;
             }
+            std::string_view word(code.data() + start, position - start);
+            auto keyword = keyword_tokens.find(word);
+            type = keyword != keyword_tokens.end() ? keyword->second : IDENTIFIER;
+            return position;
         }
+        break;
     }
 
-    // Add the end of file token
-    Token end_token(END_OF_FILE, "", get_line(code.size()), get_column(code.size()));
-    tokens.push_back(end_token);
-
-    return tokens;
-}
-
-int Lexer::get_line(size_t position) {
-    return line_prefix[position];
+    // Anything else is undefined, up to the next space, tab or new line
+    position = start + 1;
+    while (position < size && !is_separator(code[position])) {
+        position++;
+    }
+    type = UNDEFINED;
+    return position;
 }
 
 int Lexer::get_column(size_t position) {
-    return position - line_offset_prefix[position] + 1;
+    return (int)(position - line_start) + 1;
 }
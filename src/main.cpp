@@ -1,34 +1,112 @@
 #include "error_manager.h"
 #include "lexer.h"
 #include "parser.h"
+#include "profiler.h"
 #include "reader.h"
 #include "tokens.h"
+#include "visitor/closure_compiler_visitor.h"
+#include "visitor/optimizer_visitor.h"
 #include "visitor/print_visitor.h"
+#include "vm/virtual_machine.h"
+#include <climits>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <memory>
 
-int build_and_run(const std::string &path);
+/**
+ * @brief The engines that can execute a program.
+ */
+enum class Engine {
+    BYTECODE,    // Compile to bytecode and run it on the virtual machine
+    TREE_WALKER, // Interpret the AST directly (reference implementation)
+    CLOSURES,    // Compile the AST into closures and call them
+};
+
+/**
+ * @struct ProfileOptions
+ * @brief The profiling options of a run.
+ */
+struct ProfileOptions {
+    bool enabled = false;
+
+    /**
+     * @brief The path to write the folded call stacks to, or empty to not write them.
+     */
+    std::string folded_path;
+};
+
+int build_and_run(const std::string &path,
+                  Engine engine,
+                  bool optimize,
+                  int max_call_depth,
+                  const ProfileOptions &profile_options);
 void print_usage();
 
 int main(int argc, char *argv[]) {
-    if (argc == 2) {
-        char *file_path = argv[1];
-        return build_and_run(file_path);
-    } else {
+    Engine engine = Engine::BYTECODE;
+    bool optimize = false;
+    int max_call_depth = DEFAULT_MAX_CALL_DEPTH;
+    ProfileOptions profile_options;
+    std::string file_path;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        if (argument == "--engine=vm") {
+            engine = Engine::BYTECODE;
+        } else if (argument == "--engine=tree") {
+            engine = Engine::TREE_WALKER;
+        } else if (argument == "--engine=closure") {
+            engine = Engine::CLOSURES;
+        } else if (argument == "-O") {
+            optimize = true;
+        } else if (argument.rfind("--max-depth=", 0) == 0) {
+            char *end = nullptr;
+            long depth = std::strtol(argument.c_str() + 12, &end, 10);
+            if (*end != '\0' || end == argument.c_str() + 12 || depth < 1 || depth > INT_MAX) {
+                print_usage();
+                return 127;
+            }
+            max_call_depth = (int)depth;
+        } else if (argument == "--profile") {
+            profile_options.enabled = true;
+        } else if (argument.rfind("--profile-folded=", 0) == 0) {
+            profile_options.enabled = true;
+            profile_options.folded_path = argument.substr(17);
+        } else if (file_path.empty() && argument.rfind("--", 0) != 0) {
+            file_path = argument;
+        } else {
+            print_usage();
+            return 127;
+        }
+    }
+
+    if (file_path.empty()) {
         print_usage();
         return 127;
     }
+
+    // Only the tree-walking interpreter reports to the profiler
+    if (profile_options.enabled) {
+        engine = Engine::TREE_WALKER;
+    }
+
+    return build_and_run(file_path, engine, optimize, max_call_depth, profile_options);
 }
 
-int build_and_run(const std::string &path) {
+int build_and_run(const std::string &path,
+                  Engine engine,
+                  bool optimize,
+                  int max_call_depth,
+                  const ProfileOptions &profile_options) {
     std::cout << "Building program..." << std::endl;
 
     ErrorManager error_manager;
 
     // Read the file
     Reader reader(path, &error_manager);
-    std::string code = reader.read_file();
-    std::vector<std::string> file_lines = reader.get_lines();
-    error_manager.set_file_lines(file_lines);
+    std::string_view code = reader.read_file();
+    error_manager.set_source(&reader.get_source());
 
     // Lexical analysis
     Lexer lexer(code, &error_manager);
@@ -57,15 +135,56 @@ int build_and_run(const std::string &path) {
         delete program;
         exit_code = EXIT_FAILURE;
     } else {
+        // Optimization
+        if (optimize) {
+            OptimizerVisitor optimizer_visitor(program, &error_manager);
+            optimizer_visitor.optimize();
+        }
+
         // Execution
         std::cout << "Running program..." << std::endl;
 
+        Profiler profiler;
         try {
-            // Interpret the AST nodes
-            InterpreterVisitor interpreter_visitor(program, &error_manager);
-            interpreter_visitor.interpret();
+            if (engine == Engine::TREE_WALKER) {
+                // Interpret the AST nodes
+                InterpreterVisitor interpreter_visitor(program, &error_manager);
+                interpreter_visitor.set_max_call_depth(max_call_depth);
+                if (profile_options.enabled) {
+                    interpreter_visitor.set_profiler(&profiler);
+                }
+                interpreter_visitor.interpret();
+            } else if (engine == Engine::CLOSURES) {
+                // Compile the AST nodes into closures and run them
+                ClosureCompilerVisitor closure_compiler_visitor(program, &error_manager);
+                closure_compiler_visitor.set_max_call_depth(max_call_depth);
+                closure_compiler_visitor.interpret();
+            } else {
+                // Compile the AST nodes and run the bytecode
+                CompilerVisitor compiler_visitor(program, &error_manager);
+                std::unique_ptr<BytecodeProgram> bytecode(compiler_visitor.compile());
+                VirtualMachine virtual_machine(bytecode.get(), &error_manager);
+                virtual_machine.set_max_call_depth(max_call_depth);
+                virtual_machine.run();
+            }
         } catch (const std::runtime_error &e) {
             exit_code = EXIT_FAILURE;
+        } catch (const std::exception &e) {
+            // Failures of the runtime itself (such as running out of memory) end the program too
+            std::cout << "Runtime Error: " << e.what() << std::endl;
+            exit_code = EXIT_FAILURE;
+        }
+
+        // Report the profile, including the calls interrupted by a runtime error
+        if (profile_options.enabled) {
+            profiler.finish();
+            std::cerr << std::endl;
+            profiler.report(std::cerr, reader.get_source());
+
+            if (!profile_options.folded_path.empty()) {
+                std::ofstream folded_stream(profile_options.folded_path);
+                profiler.write_folded_stacks(folded_stream);
+            }
         }
 
         delete program;
@@ -75,5 +194,24 @@ int build_and_run(const std::string &path) {
 }
 
 void print_usage() {
-    std::cout << "Usage: sscript <path>" << std::endl;
+    std::cout << "Usage: sscript [options] <path>" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --engine=vm    Run the program on the bytecode virtual machine (default)"
+              << std::endl;
+    std::cout << "  --engine=tree  Run the program on the reference tree-walking interpreter"
+              << std::endl;
+    std::cout << "  --engine=closure" << std::endl;
+    std::cout << "                 Compile the AST into closures and run them" << std::endl;
+    std::cout << "  -O             Fold constant expressions and branches before running" << std::endl;
+    std::cout << "  --max-depth=<n>" << std::endl;
+    std::cout << "                 Report an error when function calls are nested deeper than n"
+              << std::endl;
+    std::cout << "                 (100000 by default; raise it to recurse millions deep on the vm)"
+              << std::endl;
+    std::cout << "  --profile      Run the program on the tree-walking interpreter and print the"
+              << std::endl;
+    std::cout << "                 hottest functions and lines to stderr" << std::endl;
+    std::cout << "  --profile-folded=<path>" << std::endl;
+    std::cout << "                 Profile, and write folded call stacks for flame graphs to a file"
+              << std::endl;
 }
@@ -0,0 +1,170 @@
+#include "object/array_kernels.h"
+#include "operators.h"
+#include <climits>
+
+// Each kernel is compiled for AVX2 and for the baseline instruction set (SSE2 on x86-64), and the
+// dynamic linker selects the version for the CPU when the program starts
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__linux__)
+#define KERNEL_TARGETS __attribute__((target_clones("avx2", "default")))
+#else
+#define KERNEL_TARGETS
+#endif
+
+namespace {
+/**
+ * @brief Apply an operation element by element, in a loop simple enough to be vectorized.
+ * @param left The left operands, or a single operand for every element.
+ * @param right The right operands, or a single operand for every element.
+ * @param scalar The operand that is a single value, if any.
+ * @param result Set to the results.
+ * @param count The number of elements.
+ * @param op The operation.
+ */
+template <typename T, typename R, typename Op>
+inline void apply(const T *left, const T *right, ScalarOperand scalar, R *result, size_t count,
+                  Op op) {
+    if (scalar == SCALAR_RIGHT) {
+        T b = *right;
+        for (size_t i = 0; i < count; i++) {
+            result[i] = op(left[i], b);
+        }
+    } else if (scalar == SCALAR_LEFT) {
+        T a = *left;
+        for (size_t i = 0; i < count; i++) {
+            result[i] = op(a, right[i]);
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            result[i] = op(left[i], right[i]);
+        }
+    }
+}
+
+/**
+ * @brief Check if an int division would trap.
+ * @param left The dividends, or a single dividend.
+ * @param right The divisors, or a single divisor.
+ * @param scalar The operand that is a single value, if any.
+ * @param count The number of elements.
+ * @return True if a divisor is zero, or the minimum int is divided by -1.
+ */
+bool division_traps(const int *left, const int *right, ScalarOperand scalar, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        int dividend = scalar == SCALAR_LEFT ? *left : left[i];
+        int divisor = scalar == SCALAR_RIGHT ? *right : right[i];
+        if (divisor == 0 || (divisor == -1 && dividend == INT_MIN)) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+KERNEL_TARGETS
+bool int_kernel(ElementOp op, const int *left, const int *right, ScalarOperand scalar, int *result,
+                size_t count) {
+    // Overflow wraps around, as it does for operations on single ints
+    switch (op) {
+    case ELEMENT_ADD:
+        apply(left, right, scalar, result, count, [](int a, int b) {
+            return wrapping_add(a, b);
+        });
+        return true;
+    case ELEMENT_SUBTRACT:
+        apply(left, right, scalar, result, count, [](int a, int b) {
+            return wrapping_subtract(a, b);
+        });
+        return true;
+    case ELEMENT_MULTIPLY:
+        apply(left, right, scalar, result, count, [](int a, int b) {
+            return wrapping_multiply(a, b);
+        });
+        return true;
+    case ELEMENT_DIVIDE:
+        if (division_traps(left, right, scalar, count)) {
+            return false;
+        }
+        apply(left, right, scalar, result, count, [](int a, int b) { return a / b; });
+        return true;
+    case ELEMENT_MODULO:
+        if (division_traps(left, right, scalar, count)) {
+            return false;
+        }
+        apply(left, right, scalar, result, count, [](int a, int b) { return a % b; });
+        return true;
+    case ELEMENT_BITWISE_AND:
+        apply(left, right, scalar, result, count, [](int a, int b) { return a & b; });
+        return true;
+    case ELEMENT_BITWISE_OR:
+        apply(left, right, scalar, result, count, [](int a, int b) { return a | b; });
+        return true;
+    case ELEMENT_BITWISE_XOR:
+        apply(left, right, scalar, result, count, [](int a, int b) { return a ^ b; });
+        return true;
+    default:
+        return false;
+    }
+}
+
+KERNEL_TARGETS
+void float_kernel(ElementOp op, const float *left, const float *right, ScalarOperand scalar,
+                  float *result, size_t count) {
+    switch (op) {
+    case ELEMENT_ADD:
+        apply(left, right, scalar, result, count, [](float a, float b) { return a + b; });
+        break;
+    case ELEMENT_SUBTRACT:
+        apply(left, right, scalar, result, count, [](float a, float b) { return a - b; });
+        break;
+    case ELEMENT_MULTIPLY:
+        apply(left, right, scalar, result, count, [](float a, float b) { return a * b; });
+        break;
+    case ELEMENT_DIVIDE:
+        apply(left, right, scalar, result, count, [](float a, float b) { return a / b; });
+        break;
+    default:
+        break;
+    }
+}
+
+KERNEL_TARGETS
+void int_compare_kernel(ElementOp op, const int *left, const int *right, ScalarOperand scalar,
+                        uint8_t *result, size_t count) {
+    switch (op) {
+    case ELEMENT_LESS_THAN:
+        apply(left, right, scalar, result, count, [](int a, int b) { return a < b; });
+        break;
+    case ELEMENT_GREATER_THAN:
+        apply(left, right, scalar, result, count, [](int a, int b) { return a > b; });
+        break;
+    case ELEMENT_LESS_THAN_EQUAL:
+        apply(left, right, scalar, result, count, [](int a, int b) { return a <= b; });
+        break;
+    case ELEMENT_GREATER_THAN_EQUAL:
+        apply(left, right, scalar, result, count, [](int a, int b) { return a >= b; });
+        break;
+    default:
+        break;
+    }
+}
+
+KERNEL_TARGETS
+void float_compare_kernel(ElementOp op, const float *left, const float *right, ScalarOperand scalar,
+                          uint8_t *result, size_t count) {
+    switch (op) {
+    case ELEMENT_LESS_THAN:
+        apply(left, right, scalar, result, count, [](float a, float b) { return a < b; });
+        break;
+    case ELEMENT_GREATER_THAN:
+        apply(left, right, scalar, result, count, [](float a, float b) { return a > b; });
+        break;
+    case ELEMENT_LESS_THAN_EQUAL:
+        apply(left, right, scalar, result, count, [](float a, float b) { return a <= b; });
+        break;
+    case ELEMENT_GREATER_THAN_EQUAL:
+        apply(left, right, scalar, result, count, [](float a, float b) { return a >= b; });
+        break;
+    default:
+        break;
+    }
+}
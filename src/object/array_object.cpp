@@ -1,198 +1,737 @@
 #include "object/array_object.h"
-#include "object/bool_object.h"
-#include "object/int_object.h"
 #include "object/string_object.h"
+#include <algorithm>
+#include <climits>
+#include <sstream>
+#include <type_traits>
 
-std::shared_ptr<Object> ArrayObject::add(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_ARRAY) {
-        std::vector<std::shared_ptr<Object>> result;
-        result.insert(result.end(), value.begin(), value.end());
-        result.insert(result.end(),
-                      std::static_pointer_cast<ArrayObject>(other)->get_value()->begin(),
-                      std::static_pointer_cast<ArrayObject>(other)->get_value()->end());
-        return std::make_shared<ArrayObject>(result);
+ArrayObject::ArrayObject(std::vector<Value> values) {
+    auto has_type = [&](Type type) {
+        return std::all_of(values.begin(), values.end(), [&](const Value &element) {
+            return element.get_type() == type;
+        });
+    };
+
+    // Pack the elements if they are all ints (which an empty array is taken to be) or all floats
+    if (has_type(TYPE_INT)) {
+        storage = STORAGE_INTS;
+        ints = std::make_shared<std::vector<int>>(values.size());
+        for (size_t i = 0; i < values.size(); i++) {
+            (*ints)[i] = values[i].get_int();
+        }
+    } else if (has_type(TYPE_FLOAT)) {
+        storage = STORAGE_FLOATS;
+        floats = std::make_shared<std::vector<float>>(values.size());
+        for (size_t i = 0; i < values.size(); i++) {
+            (*floats)[i] = values[i].get_float();
+        }
     } else {
+        storage = STORAGE_VALUES;
+        this->values = std::make_shared<std::vector<Value>>(std::move(values));
+    }
+}
+
+ArrayObject::ArrayObject(std::vector<int> values)
+    : storage(STORAGE_INTS), ints(std::make_shared<std::vector<int>>(std::move(values))) {}
+
+ArrayObject::ArrayObject(std::vector<float> values)
+    : storage(STORAGE_FLOATS), floats(std::make_shared<std::vector<float>>(std::move(values))) {}
+
+std::shared_ptr<ArrayObject> ArrayObject::from_range(int start, int end) {
+    int step = (start < end) ? 1 : -1;
+    long long len = step * ((long long)end - start) + 1;
+    if (len > INT_MAX) {
         return nullptr;
     }
+
+    auto array = std::make_shared<ArrayObject>(std::vector<int>());
+    array->storage = STORAGE_RANGE;
+    array->ints = nullptr;
+    array->range_start = start;
+    array->range_step = step;
+    array->range_len = (int)len;
+    return array;
 }
 
-std::shared_ptr<Object> ArrayObject::subtract(std::shared_ptr<Object> other) {
-    return nullptr;
+void ArrayObject::prepare_write() {
+    switch (storage) {
+    case STORAGE_RANGE: {
+        auto materialized = std::make_shared<std::vector<int>>();
+        materialized->reserve(range_len);
+        append_elements(materialized.get());
+        ints = std::move(materialized);
+        storage = STORAGE_INTS;
+        break;
+    }
+    case STORAGE_INTS:
+        if (ints.use_count() > 1) {
+            ints = std::make_shared<std::vector<int>>(*ints);
+        }
+        break;
+    case STORAGE_FLOATS:
+        if (floats.use_count() > 1) {
+            floats = std::make_shared<std::vector<float>>(*floats);
+        }
+        break;
+    case STORAGE_VALUES:
+        if (values.use_count() > 1) {
+            values = std::make_shared<std::vector<Value>>(*values);
+        }
+        break;
+    }
 }
 
-std::shared_ptr<Object> ArrayObject::positive() {
-    return nullptr;
+void ArrayObject::box() {
+    if (storage == STORAGE_VALUES) {
+        return;
+    }
+
+    auto boxed = std::make_shared<std::vector<Value>>();
+    boxed->reserve(get_len());
+    append_elements(boxed.get());
+    values = std::move(boxed);
+    ints = nullptr;
+    floats = nullptr;
+    storage = STORAGE_VALUES;
 }
 
-std::shared_ptr<Object> ArrayObject::negative() {
-    return nullptr;
+bool ArrayObject::fits(const Value &value) const {
+    switch (storage) {
+    case STORAGE_RANGE:
+    case STORAGE_INTS:
+        return value.get_type() == TYPE_INT;
+    case STORAGE_FLOATS:
+        return value.get_type() == TYPE_FLOAT;
+    default:
+        return true;
+    }
 }
 
-std::shared_ptr<Object> ArrayObject::multiply(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_INT) {
-        int times = std::static_pointer_cast<IntObject>(other)->get_value();
-        std::vector<std::shared_ptr<Object>> result;
-        for (int i = 0; i < times; i++) {
-            auto cur = *std::static_pointer_cast<ArrayObject>(this->duplicate())->get_value();
-            result.insert(result.end(), cur.begin(), cur.end());
+template <typename T> void ArrayObject::append_elements(std::vector<T> *result) const {
+    if constexpr (std::is_same_v<T, Value>) {
+        if (storage == STORAGE_VALUES) {
+            result->insert(result->end(), values->begin(), values->end());
+        } else {
+            for (int i = 0; i < get_len(); i++) {
+                result->push_back(get_element(i));
+            }
+        }
+    } else if (storage == STORAGE_RANGE) {
+        for (int i = 0; i < range_len; i++) {
+            result->push_back(range_start + i * range_step);
         }
-        return std::make_shared<ArrayObject>(result);
+    } else if constexpr (std::is_same_v<T, int>) {
+        result->insert(result->end(), ints->begin(), ints->end());
     } else {
-        return nullptr;
+        result->insert(result->end(), floats->begin(), floats->end());
     }
 }
 
-std::shared_ptr<Object> ArrayObject::divide(std::shared_ptr<Object> other) {
-    return nullptr;
+Value ArrayObject::share() const {
+    return Value(std::make_shared<ArrayObject>(*this));
 }
 
-std::shared_ptr<Object> ArrayObject::modulo(std::shared_ptr<Object> other) {
-    return nullptr;
+/**
+ * @brief Get the storage of the elements of an array once it is materialized.
+ * @param array The array.
+ * @return The storage, where a range is stored as ints.
+ */
+static ArrayObject::Storage element_storage(const ArrayObject *array) {
+    return array->is_range() ? ArrayObject::STORAGE_INTS : array->get_storage();
 }
 
-std::shared_ptr<Object> ArrayObject::bitwise_and(std::shared_ptr<Object> other) {
-    return nullptr;
+void ArrayObject::push(const Value &value) {
+    // An empty array takes the type of its first element
+    if (get_len() == 0) {
+        ints = nullptr;
+        floats = nullptr;
+        values = nullptr;
+        if (value.get_type() == TYPE_INT) {
+            storage = STORAGE_INTS;
+            ints = std::make_shared<std::vector<int>>();
+        } else if (value.get_type() == TYPE_FLOAT) {
+            storage = STORAGE_FLOATS;
+            floats = std::make_shared<std::vector<float>>();
+        } else {
+            storage = STORAGE_VALUES;
+            values = std::make_shared<std::vector<Value>>();
+        }
+    } else if (fits(value)) {
+        prepare_write();
+    } else {
+        box();
+    }
+
+    switch (storage) {
+    case STORAGE_INTS:
+        ints->push_back(value.get_int());
+        break;
+    case STORAGE_FLOATS:
+        floats->push_back(value.get_float());
+        break;
+    default:
+        values->push_back(value);
+        break;
+    }
 }
 
-std::shared_ptr<Object> ArrayObject::bitwise_or(std::shared_ptr<Object> other) {
-    return nullptr;
+Value ArrayObject::repeat(int times) {
+    // Packed numbers are copied as they are, and nested arrays are duplicated
+    auto repeat_packed = [&](auto once) {
+        append_elements(&once);
+        decltype(once) result;
+        result.reserve(once.size() * times);
+        for (int i = 0; i < times; i++) {
+            result.insert(result.end(), once.begin(), once.end());
+        }
+        return Value(std::make_shared<ArrayObject>(std::move(result)));
+    };
+
+    switch (element_storage(this)) {
+    case STORAGE_INTS:
+        return repeat_packed(std::vector<int>());
+    case STORAGE_FLOATS:
+        return repeat_packed(std::vector<float>());
+    default:
+        break;
+    }
+
+    std::vector<Value> result;
+    result.reserve(values->size() * times);
+    for (int i = 0; i < times; i++) {
+        for (const Value &element : *values) {
+            result.push_back(duplicate_element(element));
+        }
+    }
+    return Value(std::make_shared<ArrayObject>(std::move(result)));
 }
 
-std::shared_ptr<Object> ArrayObject::bitwise_xor(std::shared_ptr<Object> other) {
-    return nullptr;
+Value ArrayObject::packed_sum() const {
+    if (get_len() == 0) {
+        return {};
+    }
+
+    // Ints are added as unsigned so that overflow wraps around, as it does for int operations
+    switch (storage) {
+    case STORAGE_RANGE: {
+        unsigned int sum = 0;
+        for (int i = 0; i < range_len; i++) {
+            sum += (unsigned int)(range_start + i * range_step);
+        }
+        return Value::from_int((int)sum);
+    }
+    case STORAGE_INTS: {
+        unsigned int sum = 0;
+        for (int element : *ints) {
+            sum += (unsigned int)element;
+        }
+        return Value::from_int((int)sum);
+    }
+    case STORAGE_FLOATS: {
+        float sum = 0.0f;
+        for (float element : *floats) {
+            sum += element;
+        }
+        return Value::from_float(sum);
+    }
+    default:
+        return {};
+    }
+}
+
+Value ArrayObject::packed_product() const {
+    if (get_len() == 0) {
+        return {};
+    }
+
+    switch (storage) {
+    case STORAGE_RANGE: {
+        unsigned int product = 1;
+        for (int i = 0; i < range_len; i++) {
+            product *= (unsigned int)(range_start + i * range_step);
+        }
+        return Value::from_int((int)product);
+    }
+    case STORAGE_INTS: {
+        unsigned int product = 1;
+        for (int element : *ints) {
+            product *= (unsigned int)element;
+        }
+        return Value::from_int((int)product);
+    }
+    case STORAGE_FLOATS: {
+        float product = 1.0f;
+        for (float element : *floats) {
+            product *= element;
+        }
+        return Value::from_float(product);
+    }
+    default:
+        return {};
+    }
 }
 
-std::shared_ptr<Object> ArrayObject::bitwise_not() {
-    return nullptr;
+const int *ArrayObject::int_elements(std::vector<int> &scratch) const {
+    if (storage == STORAGE_INTS) {
+        return ints->data();
+    }
+
+    scratch.reserve(range_len);
+    append_elements(&scratch);
+    return scratch.data();
 }
 
-std::shared_ptr<Object> ArrayObject::equal(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_ARRAY) {
-        std::vector<std::shared_ptr<Object>> other_value =
-            *std::static_pointer_cast<ArrayObject>(other)->get_value();
-        bool match = true;
-        if (value.size() == other_value.size()) {
-            for (int i = 0; i < value.size(); i++) {
-                if (!other_value[i]->equal(value[i])) {
-                    match = false;
-                    break;
-                }
+const float *ArrayObject::float_elements(std::vector<float> &scratch) const {
+    if (storage == STORAGE_FLOATS) {
+        return floats->data();
+    }
+
+    std::vector<int> int_scratch;
+    const int *elements = int_elements(int_scratch);
+    scratch.assign(elements, elements + get_len());
+    return scratch.data();
+}
+
+/**
+ * @brief Get the type of the packed elements of an array.
+ * @param array The array.
+ * @return TYPE_INT or TYPE_FLOAT if the elements are packed numbers, otherwise TYPE_VOID.
+ */
+static Type packed_type(const ArrayObject *array) {
+    switch (array->get_storage()) {
+    case ArrayObject::STORAGE_RANGE:
+    case ArrayObject::STORAGE_INTS:
+        return TYPE_INT;
+    case ArrayObject::STORAGE_FLOATS:
+        return TYPE_FLOAT;
+    default:
+        return TYPE_VOID;
+    }
+}
+
+/**
+ * @brief Apply an element-wise operation to two values.
+ * @param left The left operand.
+ * @param right The right operand.
+ * @param op The operation.
+ * @return The result, or an undefined value if the operation is invalid.
+ */
+static Value apply_element_op(const Value &left, const Value &right, ElementOp op) {
+    switch (op) {
+    case ELEMENT_ADD:
+        return left.add(right);
+    case ELEMENT_SUBTRACT:
+        return left.subtract(right);
+    case ELEMENT_MULTIPLY:
+        return left.multiply(right);
+    case ELEMENT_DIVIDE:
+        return left.divide(right);
+    case ELEMENT_MODULO:
+        return left.modulo(right);
+    case ELEMENT_BITWISE_AND:
+        return left.bitwise_and(right);
+    case ELEMENT_BITWISE_OR:
+        return left.bitwise_or(right);
+    case ELEMENT_BITWISE_XOR:
+        return left.bitwise_xor(right);
+    case ELEMENT_LESS_THAN:
+        return left.less_than(right);
+    case ELEMENT_GREATER_THAN:
+        return left.greater_than(right);
+    case ELEMENT_LESS_THAN_EQUAL:
+        return left.less_than_equal(right);
+    case ELEMENT_GREATER_THAN_EQUAL:
+        return left.greater_than_equal(right);
+    default:
+        return {};
+    }
+}
+
+Value ArrayObject::elementwise(const Value &other, ElementOp op, bool other_left) {
+    auto *other_array = other.get_type() == TYPE_ARRAY ? other.as<ArrayObject>() : nullptr;
+    if (other_array != nullptr && other_array->get_len() != get_len()) {
+        return {};
+    }
+
+    size_t count = get_len();
+    Type array_type = packed_type(this);
+    Type other_type = other_array != nullptr ? packed_type(other_array) : other.get_type();
+    ScalarOperand scalar = other_array != nullptr ? SCALAR_NONE
+                           : other_left           ? SCALAR_LEFT
+                                                  : SCALAR_RIGHT;
+    bool ints_only = array_type == TYPE_INT && other_type == TYPE_INT;
+    bool numbers = (array_type == TYPE_INT || array_type == TYPE_FLOAT) &&
+                   (other_type == TYPE_INT || other_type == TYPE_FLOAT);
+
+    // Packed numbers go through the vectorized kernels
+    if (ints_only) {
+        std::vector<int> scratch, other_scratch;
+        const int *elements = int_elements(scratch);
+        int other_scalar = other_array == nullptr ? other.get_int() : 0;
+        const int *other_elements =
+            other_array == nullptr ? &other_scalar : other_array->int_elements(other_scratch);
+        const int *left = other_left ? other_elements : elements;
+        const int *right = other_left ? elements : other_elements;
+
+        if (is_comparison(op)) {
+            std::vector<uint8_t> result(count);
+            int_compare_kernel(op, left, right, scalar, result.data(), count);
+            std::vector<Value> bools(count);
+            for (size_t i = 0; i < count; i++) {
+                bools[i] = Value::from_bool(result[i]);
             }
-        } else {
-            match = false;
+            return Value(std::make_shared<ArrayObject>(std::move(bools)));
+        }
+
+        std::vector<int> result(count);
+        if (!int_kernel(op, left, right, scalar, result.data(), count)) {
+            return {};
+        }
+        return Value(std::make_shared<ArrayObject>(std::move(result)));
+    } else if (numbers) {
+        std::vector<float> scratch, other_scratch;
+        const float *elements = float_elements(scratch);
+        float other_scalar = other_array != nullptr ? 0.0f
+                             : other_type == TYPE_INT ? (float)other.get_int()
+                                                      : other.get_float();
+        const float *other_elements =
+            other_array == nullptr ? &other_scalar : other_array->float_elements(other_scratch);
+        const float *left = other_left ? other_elements : elements;
+        const float *right = other_left ? elements : other_elements;
+
+        if (is_comparison(op)) {
+            std::vector<uint8_t> result(count);
+            float_compare_kernel(op, left, right, scalar, result.data(), count);
+            std::vector<Value> bools(count);
+            for (size_t i = 0; i < count; i++) {
+                bools[i] = Value::from_bool(result[i]);
+            }
+            return Value(std::make_shared<ArrayObject>(std::move(bools)));
         }
 
-        return std::make_shared<BoolObject>(match);
+        // Modulo and bitwise operators are only defined on ints
+        if (op != ELEMENT_ADD && op != ELEMENT_SUBTRACT && op != ELEMENT_MULTIPLY &&
+            op != ELEMENT_DIVIDE) {
+            return {};
+        }
+
+        std::vector<float> result(count);
+        float_kernel(op, left, right, scalar, result.data(), count);
+        return Value(std::make_shared<ArrayObject>(std::move(result)));
+    }
+
+    // Other elements are combined one value at a time
+    std::vector<Value> result(count);
+    for (size_t i = 0; i < count; i++) {
+        Value element = get_element((int)i);
+        Value other_element = other_array == nullptr ? other : other_array->get_element((int)i);
+        result[i] = other_left ? apply_element_op(other_element, element, op)
+                               : apply_element_op(element, other_element, op);
+        if (!result[i].is_defined()) {
+            return {};
+        }
+    }
+    return Value(std::make_shared<ArrayObject>(std::move(result)));
+}
+
+Value ArrayObject::add(const Value &other) {
+    if (other.get_type() == TYPE_ARRAY) {
+        auto *other_array = other.as<ArrayObject>();
+
+        // Adding an empty array gives a copy of the other array
+        if (other_array->get_len() == 0) {
+            return share();
+        } else if (get_len() == 0) {
+            return other_array->share();
+        }
+
+        auto concatenate = [&](auto result) {
+            result.reserve((size_t)get_len() + other_array->get_len());
+            append_elements(&result);
+            other_array->append_elements(&result);
+            return Value(std::make_shared<ArrayObject>(std::move(result)));
+        };
+
+        // The result stays packed if both arrays are packed with the same type
+        Storage result_storage = element_storage(this);
+        if (result_storage != element_storage(other_array)) {
+            result_storage = STORAGE_VALUES;
+        }
+
+        switch (result_storage) {
+        case STORAGE_INTS:
+            return concatenate(std::vector<int>());
+        case STORAGE_FLOATS:
+            return concatenate(std::vector<float>());
+        default:
+            return concatenate(std::vector<Value>());
+        }
     } else {
-        return nullptr;
+        return elementwise(other, ELEMENT_ADD);
     }
 }
 
-std::shared_ptr<Object> ArrayObject::not_equal(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_ARRAY) {
-        std::vector<std::shared_ptr<Object>> other_value =
-            *std::static_pointer_cast<ArrayObject>(other)->get_value();
-        bool match = true;
-        if (value.size() != other_value.size()) {
-            for (int i = 0; i < value.size(); i++) {
-                if (!other_value[i]->equal(value[i])) {
-                    match = false;
-                    break;
-                }
-            }
-        } else {
-            match = false;
+Value ArrayObject::subtract(const Value &other) {
+    return elementwise(other, ELEMENT_SUBTRACT);
+}
+
+Value ArrayObject::positive() {
+    return {};
+}
+
+Value ArrayObject::negative() {
+    return {};
+}
+
+Value ArrayObject::multiply(const Value &other) {
+    return elementwise(other, ELEMENT_MULTIPLY);
+}
+
+Value ArrayObject::divide(const Value &other) {
+    return elementwise(other, ELEMENT_DIVIDE);
+}
+
+Value ArrayObject::modulo(const Value &other) {
+    return elementwise(other, ELEMENT_MODULO);
+}
+
+Value ArrayObject::bitwise_and(const Value &other) {
+    return elementwise(other, ELEMENT_BITWISE_AND);
+}
+
+Value ArrayObject::bitwise_or(const Value &other) {
+    return elementwise(other, ELEMENT_BITWISE_OR);
+}
+
+Value ArrayObject::bitwise_xor(const Value &other) {
+    return elementwise(other, ELEMENT_BITWISE_XOR);
+}
+
+Value ArrayObject::bitwise_not() {
+    return {};
+}
+
+Value ArrayObject::equal(const Value &other) {
+    if (other.get_type() == TYPE_ARRAY) {
+        auto *other_array = other.as<ArrayObject>();
+
+        // Packed arrays of the same type are compared as a whole
+        if (storage == STORAGE_INTS && other_array->storage == STORAGE_INTS) {
+            return Value::from_bool(*ints == *other_array->ints);
+        } else if (storage == STORAGE_FLOATS && other_array->storage == STORAGE_FLOATS) {
+            return Value::from_bool(*floats == *other_array->floats);
         }
 
-        return std::make_shared<BoolObject>(!match);
+        bool match = get_len() == other_array->get_len();
+        for (int i = 0; match && i < get_len(); i++) {
+            Value element_match = get_element(i).equal(other_array->get_element(i));
+            match = element_match.get_type() == TYPE_BOOL && element_match.get_bool();
+        }
+
+        return Value::from_bool(match);
     } else {
-        return nullptr;
+        return {};
     }
 }
 
-std::shared_ptr<Object> ArrayObject::less_than(std::shared_ptr<Object> other) {
-    return nullptr;
+Value ArrayObject::not_equal(const Value &other) {
+    Value match = equal(other);
+    if (match.is_defined()) {
+        return Value::from_bool(!match.get_bool());
+    } else {
+        return {};
+    }
 }
 
-std::shared_ptr<Object> ArrayObject::greater_than(std::shared_ptr<Object> other) {
-    return nullptr;
+Value ArrayObject::less_than(const Value &other) {
+    return elementwise(other, ELEMENT_LESS_THAN);
 }
 
-std::shared_ptr<Object> ArrayObject::less_than_equal(std::shared_ptr<Object> other) {
-    return nullptr;
+Value ArrayObject::greater_than(const Value &other) {
+    return elementwise(other, ELEMENT_GREATER_THAN);
 }
 
-std::shared_ptr<Object> ArrayObject::greater_than_equal(std::shared_ptr<Object> other) {
-    return nullptr;
+Value ArrayObject::less_than_equal(const Value &other) {
+    return elementwise(other, ELEMENT_LESS_THAN_EQUAL);
 }
 
-std::shared_ptr<Object> ArrayObject::logical_and(std::shared_ptr<Object> other) {
-    return nullptr;
+Value ArrayObject::greater_than_equal(const Value &other) {
+    return elementwise(other, ELEMENT_GREATER_THAN_EQUAL);
 }
 
-std::shared_ptr<Object> ArrayObject::logical_or(std::shared_ptr<Object> other) {
-    return nullptr;
+Value ArrayObject::logical_and(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> ArrayObject::logical_not() {
-    return nullptr;
+Value ArrayObject::logical_or(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> ArrayObject::cast(Type type) {
+Value ArrayObject::logical_not() {
+    return {};
+}
+
+Value ArrayObject::cast(Type type) {
     if (type == TYPE_ARRAY) {
-        return std::make_shared<ArrayObject>(value);
+        return share();
     } else if (type == TYPE_STRING) {
+        int len = get_len();
         std::string result = "[";
-        for (size_t i = 0; i < value.size(); i++) {
-            result +=
-                std::static_pointer_cast<StringObject>(value[i]->cast(TYPE_STRING))->get_value();
-            if (i != value.size() - 1) {
-                result += ", ";
+
+        // Packed numbers are formatted directly, without creating a string for each element
+        if (storage == STORAGE_RANGE || storage == STORAGE_INTS) {
+            for (int i = 0; i < len; i++) {
+                result += std::to_string(get_element(i).get_int());
+                if (i != len - 1) {
+                    result += ", ";
+                }
+            }
+        } else if (storage == STORAGE_FLOATS) {
+            std::ostringstream oss;
+            for (int i = 0; i < len; i++) {
+                oss << (*floats)[i];
+                if (i != len - 1) {
+                    oss << ", ";
+                }
+            }
+            result += oss.str();
+        } else {
+            // An array is only a string if each of its elements is (functions are not)
+            for (int i = 0; i < len; i++) {
+                Value element = (*values)[i].cast(TYPE_STRING);
+                if (element.get_type() != TYPE_STRING) {
+                    return {};
+                }
+                result += element.as<StringObject>()->get_value();
+                if (i != len - 1) {
+                    result += ", ";
+                }
             }
         }
+
         result += "]";
-        return std::make_shared<StringObject>(result);
+        return Value(std::make_shared<StringObject>(result));
     } else {
-        return nullptr;
+        return {};
     }
 }
 
-std::shared_ptr<Object> ArrayObject::subscript(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_INT) {
-        int index = std::static_pointer_cast<IntObject>(other)->get_value();
-        if (index >= 0 && index < value.size()) {
-            return value[index];
+Value ArrayObject::subscript(const Value &other) {
+    if (other.get_type() == TYPE_INT) {
+        int index = other.get_int();
+        if (index >= 0 && index < get_len()) {
+            return get_element(index);
         } else {
-            return nullptr;
+            return {};
         }
     } else {
-        return nullptr;
+        return {};
+    }
+}
+
+Value ArrayObject::slice(const Value &start, const Value &end) {
+    int first, last;
+    if (!get_slice_bounds(start, end, get_len(), first, last)) {
+        return {};
+    }
+
+    // A slice of a range is a range, and a slice of the whole array shares its elements. Any other
+    // slice copies the elements it selects, as an array does not view part of another's buffer.
+    if (storage == STORAGE_RANGE) {
+        return Value(from_range(get_element(first).get_int(), get_element(last).get_int()));
+    } else if (first == 0 && last == get_len() - 1) {
+        return share();
+    }
+
+    int step = (first <= last) ? 1 : -1;
+    auto pick = [&](const auto &elements) {
+        std::decay_t<decltype(elements)> result;
+        result.reserve(step * (last - first) + 1);
+        for (int i = first;; i += step) {
+            result.push_back(elements[i]);
+            if (i == last) {
+                break;
+            }
+        }
+        return Value(std::make_shared<ArrayObject>(std::move(result)));
+    };
+
+    switch (storage) {
+    case STORAGE_INTS:
+        return pick(*ints);
+    case STORAGE_FLOATS:
+        return pick(*floats);
+    default:
+        return pick(*values);
     }
 }
 
-std::shared_ptr<Object> ArrayObject::subscript_update(const std::shared_ptr<Object> &index,
-                                                      const std::shared_ptr<Object> &val) {
-    if (index->get_type() == TYPE_INT) {
-        int i = std::static_pointer_cast<IntObject>(index)->get_value();
-        if (i >= 0 && i < value.size()) {
-            value[i] = val;
+Value ArrayObject::subscript_update(const Value &index, const Value &val) {
+    if (index.get_type() == TYPE_INT) {
+        int i = index.get_int();
+        if (i >= 0 && i < get_len()) {
+            // An element of another type than the packed elements converts the array to values
+            if (fits(val)) {
+                prepare_write();
+            } else {
+                box();
+            }
+
+            switch (storage) {
+            case STORAGE_INTS:
+                (*ints)[i] = val.get_int();
+                break;
+            case STORAGE_FLOATS:
+                (*floats)[i] = val.get_float();
+                break;
+            default:
+                (*values)[i] = val;
+                break;
+            }
             return val;
         } else {
-            return nullptr;
+            return {};
         }
     } else {
-        return nullptr;
+        return {};
+    }
+}
+
+Value ArrayObject::duplicate() {
+    // Only nested arrays are duplicated, and the other values (strings included) are immutable
+    // or cannot be copied, so a deep copy of an array without them can share its elements
+    auto is_shared = [](const Value &element) { return element.get_type() != TYPE_ARRAY; };
+    if (storage != STORAGE_VALUES || std::all_of(values->begin(), values->end(), is_shared)) {
+        return share();
     }
+
+    std::vector<Value> result(values->size());
+    for (size_t i = 0; i < values->size(); i++) {
+        result[i] = duplicate_element((*values)[i]);
+    }
+    return Value(std::make_shared<ArrayObject>(std::move(result)));
 }
 
-std::shared_ptr<Object> ArrayObject::duplicate() {
-    std::vector<std::shared_ptr<Object>> result(value.size());
-    for (int i = 0; i < value.size(); i++) {
-        result[i] = value[i]->duplicate();
+Value ArrayObject::duplicate_element(const Value &element) {
+    if (element.get_type() == TYPE_ARRAY) {
+        return element.duplicate();
     }
-    return std::make_shared<ArrayObject>(result);
+    return element;
+}
+
+Value ArrayObject::call(InterpreterVisitor *visitor, SymbolTable *table) {
+    return {};
+}
+
+int ArrayObject::get_iteration_len() {
+    return get_len();
 }
 
-std::shared_ptr<Object> ArrayObject::call(InterpreterVisitor *visitor, SymbolTable *table) {
-    return nullptr;
+bool ArrayObject::iterate(int position, Value &element) {
+    if (position >= get_len()) {
+        return false;
+    }
+
+    element = get_element(position);
+    return true;
 }
@@ -0,0 +1,166 @@
+#include "object/file_object.h"
+#include "object/string_object.h"
+#include <algorithm>
+#include <climits>
+
+FileObject::FileObject(std::string path)
+    : path(std::move(path)), buffer(std::make_unique<char[]>(BUFFER_SIZE)) {
+    // The buffer is set before the file is opened, for it to be used
+    stream.rdbuf()->pubsetbuf(buffer.get(), BUFFER_SIZE);
+    stream.open(this->path, std::ios_base::in | std::ios_base::binary);
+}
+
+Value FileObject::add(const Value &other) {
+    return {};
+}
+
+Value FileObject::subtract(const Value &other) {
+    return {};
+}
+
+Value FileObject::positive() {
+    return {};
+}
+
+Value FileObject::negative() {
+    return {};
+}
+
+Value FileObject::multiply(const Value &other) {
+    return {};
+}
+
+Value FileObject::divide(const Value &other) {
+    return {};
+}
+
+Value FileObject::modulo(const Value &other) {
+    return {};
+}
+
+Value FileObject::bitwise_and(const Value &other) {
+    return {};
+}
+
+Value FileObject::bitwise_or(const Value &other) {
+    return {};
+}
+
+Value FileObject::bitwise_xor(const Value &other) {
+    return {};
+}
+
+Value FileObject::bitwise_not() {
+    return {};
+}
+
+Value FileObject::equal(const Value &other) {
+    // Files are only equal to themselves
+    if (other.get_type() == TYPE_FILE) {
+        return Value::from_bool(other.get_object() == this);
+    } else {
+        return {};
+    }
+}
+
+Value FileObject::not_equal(const Value &other) {
+    Value match = equal(other);
+    if (match.is_defined()) {
+        return Value::from_bool(!match.get_bool());
+    } else {
+        return {};
+    }
+}
+
+Value FileObject::less_than(const Value &other) {
+    return {};
+}
+
+Value FileObject::greater_than(const Value &other) {
+    return {};
+}
+
+Value FileObject::less_than_equal(const Value &other) {
+    return {};
+}
+
+Value FileObject::greater_than_equal(const Value &other) {
+    return {};
+}
+
+Value FileObject::logical_and(const Value &other) {
+    return {};
+}
+
+Value FileObject::logical_or(const Value &other) {
+    return {};
+}
+
+Value FileObject::logical_not() {
+    return {};
+}
+
+Value FileObject::cast(Type type) {
+    if (type == TYPE_STRING) {
+        return Value(std::make_shared<StringObject>("<file '" + path + "'>"));
+    } else {
+        return {};
+    }
+}
+
+Value FileObject::subscript(const Value &other) {
+    return {};
+}
+
+Value FileObject::slice(const Value &start, const Value &end) {
+    return {};
+}
+
+Value FileObject::duplicate() {
+    return {};
+}
+
+Value FileObject::call(InterpreterVisitor *visitor, SymbolTable *table) {
+    return {};
+}
+
+int FileObject::get_iteration_len() {
+    return INT_MAX;
+}
+
+bool FileObject::iterate(int position, Value &element) {
+    // The file keeps its own position, so the loop position is not needed
+    std::string line;
+    if (!stream.is_open() || !std::getline(stream, line)) {
+        return false;
+    }
+
+    element = Value(std::make_shared<StringObject>(std::move(line)));
+    return true;
+}
+
+Value FileObject::read_line() {
+    std::string line;
+    if (std::getline(stream, line) && !stream.eof()) {
+        line += '\n';
+    }
+    return Value(std::make_shared<StringObject>(std::move(line)));
+}
+
+Value FileObject::read_chunk(int size) {
+    // The chunk grows by at most a buffer at a time, so a large size on a small file costs nothing
+    std::string chunk;
+    size_t remaining = size;
+    while (remaining > 0 && stream) {
+        size_t offset = chunk.size();
+        chunk.resize(offset + std::min(remaining, BUFFER_SIZE));
+        stream.read(chunk.data() + offset, chunk.size() - offset);
+        chunk.resize(offset + stream.gcount());
+        remaining -= stream.gcount();
+    }
+    return Value(std::make_shared<StringObject>(std::move(chunk)));
+}
+
+void FileObject::close() {
+    stream.close();
+}
@@ -1,97 +1,109 @@
 #include "object/function_object.h"
 
-std::shared_ptr<Object> FunctionObject::add(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::add(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::subtract(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::subtract(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::positive() {
-    return nullptr;
+Value FunctionObject::positive() {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::negative() {
-    return nullptr;
+Value FunctionObject::negative() {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::multiply(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::multiply(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::divide(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::divide(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::modulo(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::modulo(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::bitwise_and(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::bitwise_and(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::bitwise_or(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::bitwise_or(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::bitwise_xor(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::bitwise_xor(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::bitwise_not() {
-    return nullptr;
+Value FunctionObject::bitwise_not() {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::equal(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::equal(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::not_equal(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::not_equal(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::less_than(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::less_than(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::greater_than(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::greater_than(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::less_than_equal(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::less_than_equal(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::greater_than_equal(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::greater_than_equal(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::logical_and(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::logical_and(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::logical_or(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::logical_or(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::logical_not() {
-    return nullptr;
+Value FunctionObject::logical_not() {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::cast(Type type) {
-    return nullptr;
+Value FunctionObject::cast(Type type) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::subscript(std::shared_ptr<Object> other) {
-    return nullptr;
+Value FunctionObject::subscript(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::duplicate() {
-    return nullptr;
+Value FunctionObject::slice(const Value &start, const Value &end) {
+    return {};
 }
 
-std::shared_ptr<Object> FunctionObject::call(InterpreterVisitor *visitor, SymbolTable *table) {
+Value FunctionObject::duplicate() {
+    return {};
+}
+
+Value FunctionObject::call(InterpreterVisitor *visitor, SymbolTable *table) {
     return body->evaluate(visitor, table);
 }
+
+int FunctionObject::get_iteration_len() {
+    return 0;
+}
+
+bool FunctionObject::iterate(int position, Value &element) {
+    return false;
+}
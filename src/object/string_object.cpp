@@ -1,158 +1,230 @@
 #include "object/string_object.h"
-#include "object/bool_object.h"
-#include "object/float_object.h"
-#include "object/int_object.h"
-
-std::shared_ptr<Object> StringObject::add(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_STRING) {
-        return std::make_shared<StringObject>(
-            value + std::static_pointer_cast<StringObject>(other)->get_value());
+#include <array>
+#include <stdexcept>
+
+const Value &StringObject::from_char(char character) {
+    static const std::array<Value, 256> characters = []() {
+        std::array<Value, 256> result;
+        for (size_t i = 0; i < result.size(); i++) {
+            result[i] = Value(std::make_shared<StringObject>(std::string(1, (char)i)));
+        }
+        return result;
+    }();
+
+    return characters[(unsigned char)character];
+}
+
+Value StringObject::add(const Value &other) {
+    if (other.get_type() == TYPE_STRING) {
+        auto *other_string = other.as<StringObject>();
+
+        // Append in place to the buffer of a concatenation, if no other string has been appended
+        // to it. The other string must not share the buffer, as appending may move the characters
+        // it views.
+        if (appendable && buffer->size() == length && other_string->buffer != buffer) {
+            buffer->append(other_string->get_value());
+            return concatenation(buffer);
+        }
+
+        auto result = std::make_shared<std::string>();
+        result->reserve(length + other_string->length);
+        result->append(get_value());
+        result->append(other_string->get_value());
+        return concatenation(std::move(result));
     } else {
-        return nullptr;
+        return {};
     }
 }
 
-std::shared_ptr<Object> StringObject::subtract(std::shared_ptr<Object> other) {
-    return nullptr;
+Value StringObject::subtract(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> StringObject::positive() {
-    return nullptr;
+Value StringObject::positive() {
+    return {};
 }
 
-std::shared_ptr<Object> StringObject::negative() {
-    return nullptr;
+Value StringObject::negative() {
+    return {};
 }
 
-std::shared_ptr<Object> StringObject::multiply(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_INT) {
+Value StringObject::multiply(const Value &other) {
+    if (other.get_type() == TYPE_INT) {
         std::string result;
-        for (int i = 0; i < std::static_pointer_cast<IntObject>(other)->get_value(); i++) {
-            result += value;
+        for (int i = 0; i < other.get_int(); i++) {
+            result += get_value();
         }
-        return std::make_shared<StringObject>(result);
+        return Value(std::make_shared<StringObject>(result));
     } else {
-        return nullptr;
+        return {};
     }
 }
 
-std::shared_ptr<Object> StringObject::divide(std::shared_ptr<Object> other) {
-    return nullptr;
+Value StringObject::divide(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> StringObject::modulo(std::shared_ptr<Object> other) {
-    return nullptr;
+Value StringObject::modulo(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> StringObject::bitwise_and(std::shared_ptr<Object> other) {
-    return nullptr;
+Value StringObject::bitwise_and(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> StringObject::bitwise_or(std::shared_ptr<Object> other) {
-    return nullptr;
+Value StringObject::bitwise_or(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> StringObject::bitwise_xor(std::shared_ptr<Object> other) {
-    return nullptr;
+Value StringObject::bitwise_xor(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> StringObject::bitwise_not() {
-    return nullptr;
+Value StringObject::bitwise_not() {
+    return {};
 }
 
-std::shared_ptr<Object> StringObject::equal(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_STRING) {
-        return std::make_shared<BoolObject>(
-            value == std::static_pointer_cast<StringObject>(other)->get_value());
+Value StringObject::equal(const Value &other) {
+    if (other.get_type() == TYPE_STRING) {
+        return Value::from_bool(get_value() == other.as<StringObject>()->get_value());
     } else {
-        return nullptr;
+        return {};
     }
 }
 
-std::shared_ptr<Object> StringObject::not_equal(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_STRING) {
-        return std::make_shared<BoolObject>(
-            value != std::static_pointer_cast<StringObject>(other)->get_value());
+Value StringObject::not_equal(const Value &other) {
+    if (other.get_type() == TYPE_STRING) {
+        return Value::from_bool(get_value() != other.as<StringObject>()->get_value());
     } else {
-        return nullptr;
+        return {};
     }
 }
 
-std::shared_ptr<Object> StringObject::less_than(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_STRING) {
-        return std::make_shared<BoolObject>(
-            value < std::static_pointer_cast<StringObject>(other)->get_value());
+Value StringObject::less_than(const Value &other) {
+    if (other.get_type() == TYPE_STRING) {
+        return Value::from_bool(get_value() < other.as<StringObject>()->get_value());
     } else {
-        return nullptr;
+        return {};
     }
 }
 
-std::shared_ptr<Object> StringObject::greater_than(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_STRING) {
-        return std::make_shared<BoolObject>(
-            value > std::static_pointer_cast<StringObject>(other)->get_value());
+Value StringObject::greater_than(const Value &other) {
+    if (other.get_type() == TYPE_STRING) {
+        return Value::from_bool(get_value() > other.as<StringObject>()->get_value());
     } else {
-        return nullptr;
+        return {};
     }
 }
 
-std::shared_ptr<Object> StringObject::less_than_equal(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_STRING) {
-        return std::make_shared<BoolObject>(
-            value <= std::static_pointer_cast<StringObject>(other)->get_value());
+Value StringObject::less_than_equal(const Value &other) {
+    if (other.get_type() == TYPE_STRING) {
+        return Value::from_bool(get_value() <= other.as<StringObject>()->get_value());
     } else {
-        return nullptr;
+        return {};
     }
 }
 
-std::shared_ptr<Object> StringObject::greater_than_equal(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_STRING) {
-        return std::make_shared<BoolObject>(
-            value >= std::static_pointer_cast<StringObject>(other)->get_value());
+Value StringObject::greater_than_equal(const Value &other) {
+    if (other.get_type() == TYPE_STRING) {
+        return Value::from_bool(get_value() >= other.as<StringObject>()->get_value());
     } else {
-        return nullptr;
+        return {};
     }
 }
 
-std::shared_ptr<Object> StringObject::logical_and(std::shared_ptr<Object> other) {
-    return nullptr;
+Value StringObject::logical_and(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> StringObject::logical_or(std::shared_ptr<Object> other) {
-    return nullptr;
+Value StringObject::logical_or(const Value &other) {
+    return {};
 }
 
-std::shared_ptr<Object> StringObject::logical_not() {
-    return nullptr;
+Value StringObject::logical_not() {
+    return {};
 }
 
-std::shared_ptr<Object> StringObject::cast(Type type) {
+Value StringObject::cast(Type type) {
     if (type == TYPE_STRING) {
-        return std::make_shared<StringObject>(value);
-    } else if (type == TYPE_INT) {
-        return std::make_shared<IntObject>(std::stoi(value));
-    } else if (type == TYPE_FLOAT) {
-        return std::make_shared<FloatObject>(std::stof(value));
+        return share_prefix(length);
+    } else if (type == TYPE_INT || type == TYPE_FLOAT) {
+        // A string that is not a number (or is out of range) can't be cast
+        try {
+            std::string text(get_value());
+            return type == TYPE_INT ? Value::from_int(std::stoi(text))
+                                    : Value::from_float(std::stof(text));
+        } catch (const std::logic_error &e) {
+            return {};
+        }
     } else if (type == TYPE_BOOL) {
-        return std::make_shared<BoolObject>(value == "true");
+        return Value::from_bool(get_value() == "true");
     } else {
-        return nullptr;
+        return {};
     }
 }
 
-std::shared_ptr<Object> StringObject::subscript(std::shared_ptr<Object> other) {
-    if (other->get_type() == TYPE_INT) {
-        return std::make_shared<StringObject>(
-            std::string(1, value[std::static_pointer_cast<IntObject>(other)->get_value()]));
+Value StringObject::subscript(const Value &other) {
+    if (other.get_type() == TYPE_INT) {
+        int index = other.get_int();
+        if (index >= 0 && index < (int)length) {
+            return from_char(get_value()[index]);
+        } else {
+            return {};
+        }
     } else {
-        return nullptr;
+        return {};
+    }
+}
+
+Value StringObject::slice(const Value &start, const Value &end) {
+    int first, last;
+    if (!get_slice_bounds(start, end, (int)length, first, last)) {
+        return {};
     }
+
+    // A prefix shares the characters of the string
+    std::string_view value = get_value();
+    if (first == 0) {
+        return share_prefix((size_t)last + 1);
+    } else if (first <= last) {
+        std::string result(value.substr(first, last - first + 1));
+        return Value(std::make_shared<StringObject>(std::move(result)));
+    }
+
+    std::string result(value.rend() - first - 1, value.rend() - last);
+    return Value(std::make_shared<StringObject>(std::move(result)));
+}
+
+Value StringObject::duplicate() {
+    return share_prefix(length);
+}
+
+Value StringObject::call(InterpreterVisitor *visitor, SymbolTable *table) {
+    return {};
+}
+
+int StringObject::get_iteration_len() {
+    return get_len();
+}
+
+bool StringObject::iterate(int position, Value &element) {
+    if (position >= (int)length) {
+        return false;
+    }
+
+    element = from_char(get_value()[position]);
+    return true;
 }
 
-std::shared_ptr<Object> StringObject::duplicate() {
-    return std::make_shared<StringObject>(value);
+Value StringObject::concatenation(std::shared_ptr<std::string> buffer) {
+    size_t length = buffer->size();
+    auto result = std::make_shared<StringObject>(std::move(buffer), length);
+    result->appendable = true;
+    return Value(result);
 }
 
-std::shared_ptr<Object> StringObject::call(InterpreterVisitor *visitor, SymbolTable *table) {
-    return nullptr;
+Value StringObject::share_prefix(size_t prefix_length) const {
+    auto prefix = std::make_shared<StringObject>(*this);
+    prefix->length = prefix_length;
+    return Value(prefix);
 }
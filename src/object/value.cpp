@@ -0,0 +1,191 @@
+#include "object/value.h"
+#include "object/object.h"
+#include "object/string_object.h"
+#include "operators.h"
+#include <sstream>
+#include <utility>
+
+Value::Value(std::shared_ptr<Object> object) : object(std::move(object)) {
+    if (this->object) {
+        type = this->object->get_type();
+    }
+}
+
+Value Value::from_int(int value) {
+    Value result;
+    result.type = TYPE_INT;
+    result.int_value = value;
+    return result;
+}
+
+Value Value::from_float(float value) {
+    Value result;
+    result.type = TYPE_FLOAT;
+    result.float_value = value;
+    return result;
+}
+
+Value Value::from_bool(bool value) {
+    Value result;
+    result.type = TYPE_BOOL;
+    result.bool_value = value;
+    return result;
+}
+
+Value Value::make_void() {
+    Value result;
+    result.type = TYPE_VOID;
+    return result;
+}
+
+Value Value::add(const Value &other) const {
+    return apply_binary_operator(BINARY_ADD, *this, other);
+}
+
+Value Value::subtract(const Value &other) const {
+    return apply_binary_operator(BINARY_SUBTRACT, *this, other);
+}
+
+Value Value::positive() const {
+    return apply_unary_operator(UNARY_POSITIVE, *this);
+}
+
+Value Value::negative() const {
+    return apply_unary_operator(UNARY_NEGATIVE, *this);
+}
+
+Value Value::multiply(const Value &other) const {
+    return apply_binary_operator(BINARY_MULTIPLY, *this, other);
+}
+
+Value Value::divide(const Value &other) const {
+    return apply_binary_operator(BINARY_DIVIDE, *this, other);
+}
+
+Value Value::modulo(const Value &other) const {
+    return apply_binary_operator(BINARY_MODULO, *this, other);
+}
+
+Value Value::bitwise_and(const Value &other) const {
+    return apply_binary_operator(BINARY_BITWISE_AND, *this, other);
+}
+
+Value Value::bitwise_or(const Value &other) const {
+    return apply_binary_operator(BINARY_BITWISE_OR, *this, other);
+}
+
+Value Value::bitwise_xor(const Value &other) const {
+    return apply_binary_operator(BINARY_BITWISE_XOR, *this, other);
+}
+
+Value Value::bitwise_not() const {
+    return apply_unary_operator(UNARY_BITWISE_NOT, *this);
+}
+
+Value Value::equal(const Value &other) const {
+    return apply_binary_operator(BINARY_EQUAL, *this, other);
+}
+
+Value Value::not_equal(const Value &other) const {
+    return apply_binary_operator(BINARY_NOT_EQUAL, *this, other);
+}
+
+Value Value::less_than(const Value &other) const {
+    return apply_binary_operator(BINARY_LESS_THAN, *this, other);
+}
+
+Value Value::greater_than(const Value &other) const {
+    return apply_binary_operator(BINARY_GREATER_THAN, *this, other);
+}
+
+Value Value::less_than_equal(const Value &other) const {
+    return apply_binary_operator(BINARY_LESS_THAN_EQUAL, *this, other);
+}
+
+Value Value::greater_than_equal(const Value &other) const {
+    return apply_binary_operator(BINARY_GREATER_THAN_EQUAL, *this, other);
+}
+
+Value Value::logical_and(const Value &other) const {
+    return apply_binary_operator(BINARY_LOGICAL_AND, *this, other);
+}
+
+Value Value::logical_or(const Value &other) const {
+    return apply_binary_operator(BINARY_LOGICAL_OR, *this, other);
+}
+
+Value Value::logical_not() const {
+    return apply_unary_operator(UNARY_LOGICAL_NOT, *this);
+}
+
+Value Value::cast(Type type) const {
+    if (object) {
+        return object->cast(type);
+    }
+
+    switch (this->type) {
+    case TYPE_INT:
+        if (type == TYPE_INT) {
+            return *this;
+        } else if (type == TYPE_FLOAT) {
+            return from_float((float)int_value);
+        } else if (type == TYPE_BOOL) {
+            return from_bool(int_value != 0);
+        } else if (type == TYPE_STRING) {
+            return Value(std::make_shared<StringObject>(std::to_string(int_value)));
+        }
+        break;
+    case TYPE_FLOAT:
+        if (type == TYPE_INT) {
+            return from_int((int)float_value);
+        } else if (type == TYPE_FLOAT) {
+            return *this;
+        } else if (type == TYPE_BOOL) {
+            return from_bool(float_value != 0.0f);
+        } else if (type == TYPE_STRING) {
+            std::ostringstream oss;
+            oss << float_value;
+            return Value(std::make_shared<StringObject>(oss.str()));
+        }
+        break;
+    case TYPE_BOOL:
+        if (type == TYPE_BOOL) {
+            return *this;
+        } else if (type == TYPE_INT) {
+            return from_int(bool_value ? 1 : 0);
+        } else if (type == TYPE_FLOAT) {
+            return from_float(bool_value ? 1.0f : 0.0f);
+        } else if (type == TYPE_STRING) {
+            return Value(std::make_shared<StringObject>(bool_value ? "true" : "false"));
+        }
+        break;
+    default:
+        break;
+    }
+
+    return {};
+}
+
+Value Value::subscript(const Value &other) const {
+    if (object) {
+        return object->subscript(other);
+    }
+
+    return {};
+}
+
+Value Value::slice(const Value &start, const Value &end) const {
+    if (object) {
+        return object->slice(start, end);
+    }
+
+    return {};
+}
+
+Value Value::duplicate() const {
+    if (object) {
+        return object->duplicate();
+    }
+
+    return *this;
+}
@@ -1,97 +0,0 @@
-#include "object/void_object.h"
-
-std::shared_ptr<Object> VoidObject::add(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::subtract(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::positive() {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::negative() {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::multiply(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::divide(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::modulo(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::bitwise_and(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::bitwise_or(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::bitwise_xor(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::bitwise_not() {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::equal(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::not_equal(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::less_than(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::greater_than(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::less_than_equal(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::greater_than_equal(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::logical_and(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::logical_or(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::logical_not() {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::cast(Type type) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::subscript(std::shared_ptr<Object> other) {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::duplicate() {
-    return nullptr;
-}
-
-std::shared_ptr<Object> VoidObject::call(InterpreterVisitor *visitor, SymbolTable *table) {
-    return nullptr;
-}
@@ -1,45 +1,301 @@
 #include "operators.h"
+#include "object/array_object.h"
+#include <type_traits>
+#include <utility>
 
-const std::unordered_map<TokenType, BinaryOp> binary_ops = {
-    {ADDITION_OPERATOR, [](auto l, auto r) { return l->add(r); }},
-    {SUBTRACTION_OPERATOR, [](auto l, auto r) { return l->subtract(r); }},
-    {MULTIPLICATIVE_OPERATOR, [](auto l, auto r) { return l->multiply(r); }},
-    {DIVISION_OPERATOR, [](auto l, auto r) { return l->divide(r); }},
-    {MOD_OPERATOR, [](auto l, auto r) { return l->modulo(r); }},
-    {LOGICAL_AND_OPERATOR, [](auto l, auto r) { return l->logical_and(r); }},
-    {LOGICAL_OR_OPERATOR, [](auto l, auto r) { return l->logical_or(r); }},
-    {BITWISE_AND_OPERATOR, [](auto l, auto r) { return l->bitwise_and(r); }},
-    {BITWISE_OR_OPERATOR, [](auto l, auto r) { return l->bitwise_or(r); }},
-    {BITWISE_XOR_OPERATOR, [](auto l, auto r) { return l->bitwise_xor(r); }},
-    {LESS_THAN_OPERATOR, [](auto l, auto r) { return l->less_than(r); }},
-    {LESS_THAN_EQUAL_OPERATOR, [](auto l, auto r) { return l->less_than_equal(r); }},
-    {GREATER_THAN_OPERATOR, [](auto l, auto r) { return r->less_than(l); }},
-    {GREATER_THAN_EQUAL_OPERATOR, [](auto l, auto r) { return r->less_than_equal(l); }},
-    {EQUAL_OPERATOR, [](auto l, auto r) { return l->equal(r); }},
-    {NOT_EQUAL_OPERATOR, [](auto l, auto r) { return l->not_equal(r); }}
-};
-
-const std::unordered_map<TokenType, UnaryOp> unary_ops = {
-    {ADDITION_OPERATOR, [](auto o) { return o->positive(); }},
-    {SUBTRACTION_OPERATOR, [](auto o) { return o->negative(); }},
-    {LOGICAL_NOT_OPERATOR, [](auto o) { return o->logical_not(); }},
-    {BITWISE_NOT_OPERATOR, [](auto o) { return o->bitwise_not(); }}
-};
-
-BinaryOp get_binary_op_function(TokenType op) {
-    auto it = binary_ops.find(op);
-    if (it != binary_ops.end()) {
-        return it->second;
+namespace {
+/**
+ * @brief Check if values of a type are heap allocated objects.
+ * @param type The type.
+ * @return True for strings, arrays, functions and files.
+ */
+constexpr bool is_object_type(Type type) {
+    return type == TYPE_STRING || type == TYPE_ARRAY || type == TYPE_FUNCTION || type == TYPE_FILE;
+}
+
+/**
+ * @brief Check if a type is a number type.
+ * @param type The type.
+ * @return True for ints and floats.
+ */
+constexpr bool is_number_type(Type type) {
+    return type == TYPE_INT || type == TYPE_FLOAT;
+}
+
+/**
+ * @brief Get the value of a number of a known type as a float.
+ * @tparam T The type of the value, which must be a number type.
+ * @param value The value.
+ * @return The value as a float.
+ */
+template <Type T> float to_float(const Value &value) {
+    if constexpr (T == TYPE_INT) {
+        return (float)value.get_int();
+    } else {
+        return value.get_float();
+    }
+}
+
+/**
+ * @brief Apply a binary operator to two numbers of the same type.
+ *
+ * Modulo and bitwise operators only apply to ints, and logical operators don't apply to numbers.
+ * An int division by zero (or of the minimum int by -1) is invalid rather than trapping.
+ *
+ * @tparam Op The operator.
+ * @tparam T int or float.
+ * @param a The left operand.
+ * @param b The right operand.
+ * @return The result, or an undefined value if the operator does not apply to the numbers.
+ */
+template <BinaryOperator Op, typename T> Value number_kernel(T a, T b) {
+    // The operator is a constant, so the switch of the inline operators folds away
+    if constexpr (std::is_same_v<T, int>) {
+        return apply_int_operator(Op, a, b);
     } else {
-        return nullptr;
+        return apply_float_operator(Op, a, b);
     }
 }
 
-UnaryOp get_unary_op_function(TokenType op) {
-    auto it = unary_ops.find(op);
-    if (it != unary_ops.end()) {
-        return it->second;
+/**
+ * @brief Apply a binary operator to two bools.
+ * @tparam Op The operator.
+ * @param a The left operand.
+ * @param b The right operand.
+ * @return The result, or an undefined value if the operator does not apply to bools.
+ */
+template <BinaryOperator Op> Value bool_kernel(bool a, bool b) {
+    if constexpr (Op == BINARY_LOGICAL_AND) {
+        return Value::from_bool(a && b);
+    } else if constexpr (Op == BINARY_LOGICAL_OR) {
+        return Value::from_bool(a || b);
+    } else if constexpr (Op == BINARY_EQUAL) {
+        return Value::from_bool(a == b);
+    } else if constexpr (Op == BINARY_NOT_EQUAL) {
+        return Value::from_bool(a != b);
     } else {
-        return nullptr;
+        return {};
+    }
+}
+
+/**
+ * @brief Apply a binary operator to an object, through the operation of the object.
+ * @tparam Op The operator.
+ * @param object The left operand.
+ * @param right The right operand.
+ * @return The result of the operation.
+ */
+template <BinaryOperator Op> Value object_kernel(Object *object, const Value &right) {
+    if constexpr (Op == BINARY_ADD) {
+        return object->add(right);
+    } else if constexpr (Op == BINARY_SUBTRACT) {
+        return object->subtract(right);
+    } else if constexpr (Op == BINARY_MULTIPLY) {
+        return object->multiply(right);
+    } else if constexpr (Op == BINARY_DIVIDE) {
+        return object->divide(right);
+    } else if constexpr (Op == BINARY_MODULO) {
+        return object->modulo(right);
+    } else if constexpr (Op == BINARY_LOGICAL_AND) {
+        return object->logical_and(right);
+    } else if constexpr (Op == BINARY_LOGICAL_OR) {
+        return object->logical_or(right);
+    } else if constexpr (Op == BINARY_BITWISE_AND) {
+        return object->bitwise_and(right);
+    } else if constexpr (Op == BINARY_BITWISE_OR) {
+        return object->bitwise_or(right);
+    } else if constexpr (Op == BINARY_BITWISE_XOR) {
+        return object->bitwise_xor(right);
+    } else if constexpr (Op == BINARY_LESS_THAN) {
+        return object->less_than(right);
+    } else if constexpr (Op == BINARY_LESS_THAN_EQUAL) {
+        return object->less_than_equal(right);
+    } else if constexpr (Op == BINARY_GREATER_THAN) {
+        return object->greater_than(right);
+    } else if constexpr (Op == BINARY_GREATER_THAN_EQUAL) {
+        return object->greater_than_equal(right);
+    } else if constexpr (Op == BINARY_EQUAL) {
+        return object->equal(right);
+    } else {
+        return object->not_equal(right);
+    }
+}
+
+/**
+ * @brief Apply a binary operator to a single value and an array, element by element.
+ *
+ * @tparam Op The operator.
+ * @param left The single value on the left.
+ * @param array The array on the right.
+ * @return The result, or an undefined value if the operator does not apply to the operands.
+ */
+template <BinaryOperator Op> Value scalar_array_kernel(const Value &left, ArrayObject *array) {
+    if constexpr (Op == BINARY_ADD) {
+        return array->elementwise(left, ELEMENT_ADD, true);
+    } else if constexpr (Op == BINARY_SUBTRACT) {
+        return array->elementwise(left, ELEMENT_SUBTRACT, true);
+    } else if constexpr (Op == BINARY_MULTIPLY) {
+        return array->elementwise(left, ELEMENT_MULTIPLY, true);
+    } else if constexpr (Op == BINARY_DIVIDE) {
+        return array->elementwise(left, ELEMENT_DIVIDE, true);
+    } else if constexpr (Op == BINARY_MODULO) {
+        return array->elementwise(left, ELEMENT_MODULO, true);
+    } else if constexpr (Op == BINARY_BITWISE_AND) {
+        return array->elementwise(left, ELEMENT_BITWISE_AND, true);
+    } else if constexpr (Op == BINARY_BITWISE_OR) {
+        return array->elementwise(left, ELEMENT_BITWISE_OR, true);
+    } else if constexpr (Op == BINARY_BITWISE_XOR) {
+        return array->elementwise(left, ELEMENT_BITWISE_XOR, true);
+    } else if constexpr (Op == BINARY_LESS_THAN) {
+        return array->elementwise(left, ELEMENT_LESS_THAN, true);
+    } else if constexpr (Op == BINARY_LESS_THAN_EQUAL) {
+        return array->elementwise(left, ELEMENT_LESS_THAN_EQUAL, true);
+    } else if constexpr (Op == BINARY_GREATER_THAN) {
+        return array->elementwise(left, ELEMENT_GREATER_THAN, true);
+    } else if constexpr (Op == BINARY_GREATER_THAN_EQUAL) {
+        return array->elementwise(left, ELEMENT_GREATER_THAN_EQUAL, true);
+    } else {
+        return {};
+    }
+}
+
+/**
+ * @brief Apply a binary operator to operands of known types.
+ *
+ * Two ints give an int (or bool) result, and an int with a float is promoted to a float. An object
+ * on the left applies its own operation, which checks the type of the right operand, and a number
+ * or bool on the left of an array is applied to every element.
+ *
+ * @tparam Op The operator.
+ * @tparam Left The type of the left operand.
+ * @tparam Right The type of the right operand.
+ * @param left The left operand.
+ * @param right The right operand.
+ * @return The result, or an undefined value if the operator does not apply to the operands.
+ */
+template <BinaryOperator Op, Type Left, Type Right>
+Value binary_kernel(const Value &left, const Value &right) {
+    if constexpr (is_object_type(Left)) {
+        return object_kernel<Op>(left.get_object(), right);
+    } else if constexpr (Left == TYPE_INT && Right == TYPE_INT) {
+        return number_kernel<Op>(left.get_int(), right.get_int());
+    } else if constexpr (is_number_type(Left) && is_number_type(Right)) {
+        return number_kernel<Op>(to_float<Left>(left), to_float<Right>(right));
+    } else if constexpr (Left == TYPE_BOOL && Right == TYPE_BOOL) {
+        return bool_kernel<Op>(left.get_bool(), right.get_bool());
+    } else if constexpr ((is_number_type(Left) || Left == TYPE_BOOL) && Right == TYPE_ARRAY) {
+        return scalar_array_kernel<Op>(left, right.as<ArrayObject>());
+    } else {
+        return {};
+    }
+}
+
+/**
+ * @brief Apply a unary operator to an operand of a known type.
+ * @tparam Op The operator.
+ * @tparam T The type of the operand.
+ * @param operand The operand.
+ * @return The result, or an undefined value if the operator does not apply to the operand.
+ */
+template <UnaryOperator Op, Type T> Value unary_kernel(const Value &operand) {
+    if constexpr (is_object_type(T)) {
+        Object *object = operand.get_object();
+        if constexpr (Op == UNARY_POSITIVE) {
+            return object->positive();
+        } else if constexpr (Op == UNARY_NEGATIVE) {
+            return object->negative();
+        } else if constexpr (Op == UNARY_LOGICAL_NOT) {
+            return object->logical_not();
+        } else {
+            return object->bitwise_not();
+        }
+    } else if constexpr (Op == UNARY_POSITIVE && is_number_type(T)) {
+        return operand;
+    } else if constexpr (Op == UNARY_NEGATIVE && T == TYPE_INT) {
+        return Value::from_int(wrapping_subtract(0, operand.get_int()));
+    } else if constexpr (Op == UNARY_NEGATIVE && T == TYPE_FLOAT) {
+        return Value::from_float(-operand.get_float());
+    } else if constexpr (Op == UNARY_LOGICAL_NOT && T == TYPE_BOOL) {
+        return Value::from_bool(!operand.get_bool());
+    } else if constexpr (Op == UNARY_BITWISE_NOT && T == TYPE_INT) {
+        return Value::from_int(~operand.get_int());
+    } else {
+        return {};
+    }
+}
+
+template <size_t... I>
+constexpr std::array<BinaryKernel, sizeof...(I)> make_binary_kernels(std::index_sequence<I...>) {
+    return {{&binary_kernel<BinaryOperator(I / (TYPE_COUNT * TYPE_COUNT)),
+                            Type(I / TYPE_COUNT % TYPE_COUNT),
+                            Type(I % TYPE_COUNT)>...}};
+}
+
+template <size_t... I>
+constexpr std::array<UnaryKernel, sizeof...(I)> make_unary_kernels(std::index_sequence<I...>) {
+    return {{&unary_kernel<UnaryOperator(I / TYPE_COUNT), Type(I % TYPE_COUNT)>...}};
+}
+
+constexpr size_t BINARY_KERNEL_COUNT = BINARY_OPERATOR_COUNT * TYPE_COUNT * TYPE_COUNT;
+constexpr size_t UNARY_KERNEL_COUNT = UNARY_OPERATOR_COUNT * TYPE_COUNT;
+} // namespace
+
+const std::array<BinaryKernel, BINARY_KERNEL_COUNT> binary_kernels =
+    make_binary_kernels(std::make_index_sequence<BINARY_KERNEL_COUNT>());
+
+const std::array<UnaryKernel, UNARY_KERNEL_COUNT> unary_kernels =
+    make_unary_kernels(std::make_index_sequence<UNARY_KERNEL_COUNT>());
+
+BinaryOperator to_binary_operator(TokenType op) {
+    switch (op) {
+    case ADDITION_OPERATOR:
+        return BINARY_ADD;
+    case SUBTRACTION_OPERATOR:
+        return BINARY_SUBTRACT;
+    case MULTIPLICATIVE_OPERATOR:
+        return BINARY_MULTIPLY;
+    case DIVISION_OPERATOR:
+        return BINARY_DIVIDE;
+    case MOD_OPERATOR:
+        return BINARY_MODULO;
+    case LOGICAL_AND_OPERATOR:
+        return BINARY_LOGICAL_AND;
+    case LOGICAL_OR_OPERATOR:
+        return BINARY_LOGICAL_OR;
+    case BITWISE_AND_OPERATOR:
+        return BINARY_BITWISE_AND;
+    case BITWISE_OR_OPERATOR:
+        return BINARY_BITWISE_OR;
+    case BITWISE_XOR_OPERATOR:
+        return BINARY_BITWISE_XOR;
+    case LESS_THAN_OPERATOR:
+        return BINARY_LESS_THAN;
+    case LESS_THAN_EQUAL_OPERATOR:
+        return BINARY_LESS_THAN_EQUAL;
+    case GREATER_THAN_OPERATOR:
+        return BINARY_GREATER_THAN;
+    case GREATER_THAN_EQUAL_OPERATOR:
+        return BINARY_GREATER_THAN_EQUAL;
+    case EQUAL_OPERATOR:
+        return BINARY_EQUAL;
+    case NOT_EQUAL_OPERATOR:
+        return BINARY_NOT_EQUAL;
+    default:
+        return BINARY_OPERATOR_COUNT;
+    }
+}
+
+UnaryOperator to_unary_operator(TokenType op) {
+    switch (op) {
+    case ADDITION_OPERATOR:
+        return UNARY_POSITIVE;
+    case SUBTRACTION_OPERATOR:
+        return UNARY_NEGATIVE;
+    case LOGICAL_NOT_OPERATOR:
+        return UNARY_LOGICAL_NOT;
+    case BITWISE_NOT_OPERATOR:
+        return UNARY_BITWISE_NOT;
+    default:
+        return UNARY_OPERATOR_COUNT;
     }
 }
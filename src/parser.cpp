@@ -119,8 +119,9 @@ ASTNode *Parser::parse_array_literal() {
 
 ASTNode *Parser::parse_array_subscript() {
     /*
-        Example:
+        Examples:
         identifier[index1][index2]
+        identifier[start..end]
     */
 
     ASTNode *left_array = parse_identifier();
@@ -131,8 +132,18 @@ ASTNode *Parser::parse_array_subscript() {
         int line = cur_token().line, col = cur_token().column;
         auto *index = parse_primary_expression();
 
+        // A range as the index is a slice, with the bounds of the range
+        if (index->get_node_type() == RANGE_LITERAL_NODE) {
+            auto *range = static_cast<RangeLiteralNode *>(index);
+            left_array = new SliceOpNode(left_array, range->get_start(), range->get_end(), line, col);
+            range->set_start(nullptr);
+            range->set_end(nullptr);
+            delete range;
+        }
         // left_array becomes the left array at the specified index
-        left_array = new SubscriptOpNode(left_array, index, line, col);
+        else {
+            left_array = new SubscriptOpNode(left_array, index, line, col);
+        }
 
         expect(RBRACKET);
     }
@@ -225,7 +236,7 @@ ASTNode *Parser::parse_for_statement() {
     int line = cur_token().line, col = cur_token().column;
 
     expect(FOR_KEYWORD);
-    std::string identifier = cur_token().value;
+    std::string identifier(cur_token().value);
     expect(IDENTIFIER);
     expect(IN_KEYWORD);
     auto *iterable = parse_primary_expression();
@@ -305,7 +316,7 @@ ASTNode *Parser::parse_identifier() {
 
     int line = cur_token().line, col = cur_token().column;
 
-    std::string identifier = cur_token().value;
+    std::string identifier(cur_token().value);
     expect(IDENTIFIER);
 
     return new IdentifierNode(identifier, line, col);
@@ -324,7 +335,7 @@ ASTNode *Parser::parse_literal() {
 
     // Parse the literal value
     Type type = token_to_type(cur_token().type);
-    std::string value = cur_token().value;
+    std::string value(cur_token().value);
     next_token();
 
     return new LiteralNode(type, value, line, col);
@@ -348,7 +359,7 @@ ASTNode *Parser::parse_function_declaration() {
     std::vector<std::string> parameters;
     while (!check(RPAREN) && !check(END_OF_FILE)) {
         // Parse the identifier as a parameter
-        std::string parameter = cur_token().value;
+        std::string parameter(cur_token().value);
         expect(IDENTIFIER);
         parameters.push_back(parameter);
 
@@ -372,7 +383,7 @@ ASTNode *Parser::parse_call() {
 
     int line = cur_token().line, col = cur_token().column;
 
-    std::string identifier = cur_token().value;
+    std::string identifier(cur_token().value);
     expect(IDENTIFIER);
     expect(LPAREN);
 
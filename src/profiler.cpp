@@ -0,0 +1,177 @@
+#include "profiler.h"
+#include "object/object.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+/**
+ * @brief Print a table of measurements, sorted by exclusive time.
+ * @param stream The stream to print to.
+ * @param title The title of the table, which labels the last column.
+ * @param rows The label and measurements of each row.
+ * @param max_rows The maximum number of rows to print.
+ */
+void print_table(std::ostream &stream,
+                 const std::string &title,
+                 std::vector<std::pair<std::string, Profiler::Entry>> rows,
+                 size_t max_rows) {
+    std::sort(rows.begin(), rows.end(), [](const auto &a, const auto &b) {
+        return a.second.exclusive_ns > b.second.exclusive_ns;
+    });
+
+    stream << std::setw(10) << "Count" << std::setw(12) << "Incl (ms)" << std::setw(12)
+           << "Excl (ms)" << std::setw(10) << "Allocs"
+           << "  " << title << std::endl;
+    stream << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < rows.size() && i < max_rows; i++) {
+        const Profiler::Entry &entry = rows[i].second;
+        stream << std::setw(10) << entry.count << std::setw(12)
+               << (double)entry.inclusive_ns / 1e6 << std::setw(12)
+               << (double)entry.exclusive_ns / 1e6 << std::setw(10) << entry.allocations << "  "
+               << rows[i].first << std::endl;
+    }
+    stream << std::defaultfloat;
+}
+} // namespace
+
+void Profiler::enter_function(const std::string &name) {
+    enter_function(name, Clock::now());
+}
+
+void Profiler::enter_function(const std::string &name, Clock::time_point now) {
+    function_frames.push_back({name, now, (int64_t)Object::get_created_count()});
+    active_functions[name]++;
+
+    // Find the call stack extended by the function, or add it
+    int parent = function_stacks.empty() ? -1 : function_stacks.back();
+    auto child = stack_children.try_emplace({parent, name}, (int)stack_nodes.size());
+    if (child.second) {
+        stack_nodes.push_back({parent, name});
+    }
+    function_stacks.push_back(child.first->second);
+}
+
+void Profiler::exit_function() {
+    exit_function(Clock::now());
+}
+
+void Profiler::exit_function(Clock::time_point now) {
+    if (function_frames.back().has_tail_line) {
+        exit_frame(line_frames, lines, active_lines, now);
+    }
+
+    int64_t exclusive_ns = exit_frame(function_frames, functions, active_functions, now);
+    stack_nodes[function_stacks.back()].exclusive_ns += exclusive_ns;
+    function_stacks.pop_back();
+}
+
+void Profiler::enter_tail_call(const std::string &name, int line) {
+    // The frames are switched at a single point in time, so none of it is charged to the caller
+    Clock::time_point now = Clock::now();
+    exit_function(now);
+    enter_function(name, now);
+    line_frames.push_back({line, now, (int64_t)Object::get_created_count()});
+    line_frames.back().counted = false;
+    active_lines[line]++;
+    function_frames.back().has_tail_line = true;
+}
+
+void Profiler::enter_line(int line) {
+    line_frames.push_back({line, Clock::now(), (int64_t)Object::get_created_count()});
+    active_lines[line]++;
+}
+
+void Profiler::exit_line() {
+    exit_frame(line_frames, lines, active_lines, Clock::now());
+}
+
+void Profiler::finish() {
+    // The lines of tail calls are ended with the other lines
+    Clock::time_point now = Clock::now();
+    while (!line_frames.empty()) {
+        exit_frame(line_frames, lines, active_lines, now);
+    }
+    while (!function_frames.empty()) {
+        function_frames.back().has_tail_line = false;
+        exit_function(now);
+    }
+}
+
+template <typename Key, typename Entries>
+int64_t Profiler::exit_frame(std::vector<Frame<Key>> &frames,
+                             Entries &entries,
+                             std::unordered_map<Key, int> &active,
+                             Clock::time_point now) {
+    Frame<Key> frame = frames.back();
+    frames.pop_back();
+
+    int64_t inclusive_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - frame.start).count();
+    int64_t allocations = (int64_t)Object::get_created_count() - frame.start_allocations;
+
+    Entry &entry = entries[frame.key];
+    if (frame.counted) {
+        entry.count++;
+    }
+    entry.exclusive_ns += inclusive_ns - frame.child_ns;
+    entry.allocations += allocations - frame.child_allocations;
+    if (--active[frame.key] == 0) {
+        entry.inclusive_ns += inclusive_ns;
+    }
+
+    // The frame is part of the inclusive measurements of its parent
+    if (!frames.empty()) {
+        frames.back().child_ns += inclusive_ns;
+        frames.back().child_allocations += allocations;
+    }
+
+    return inclusive_ns - frame.child_ns;
+}
+
+void Profiler::report(std::ostream &stream, const SourceBuffer &source, size_t max_rows) const {
+    std::vector<std::pair<std::string, Entry>> function_rows(functions.begin(), functions.end());
+    print_table(stream, "Function", function_rows, max_rows);
+    stream << std::endl;
+
+    std::vector<std::pair<std::string, Entry>> line_rows;
+    for (auto &line : lines) {
+        // Label each line with its source code, without indentation
+        std::string_view code = source.get_line(line.first);
+        code.remove_prefix(std::min(code.find_first_not_of(" \t"), code.size()));
+        code = code.substr(0, code.find_last_not_of(" \t\r") + 1);
+        line_rows.emplace_back(std::to_string(line.first) + ": " + std::string(code), line.second);
+    }
+    print_table(stream, "Line", line_rows, max_rows);
+}
+
+void Profiler::write_folded_stacks(std::ostream &stream) const {
+    // The stacks are visited depth first, in order of name, and each stack extends the path of its
+    // caller (an explicit stack of pending calls, because recursion can make the tree deep)
+    std::string path;
+    std::vector<std::pair<int, size_t>> pending; // A stack and the length of the path of its caller
+    auto push_children = [&](int parent, size_t length) {
+        auto child = stack_children.lower_bound({parent + 1, std::string()});
+        while (child != stack_children.begin() && (--child)->first.first == parent) {
+            pending.emplace_back(child->second, length);
+        }
+    };
+
+    push_children(-1, 0);
+    while (!pending.empty()) {
+        auto [index, length] = pending.back();
+        pending.pop_back();
+
+        const StackNode &node = stack_nodes[index];
+        path.resize(length);
+        if (node.parent >= 0) {
+            path += ';';
+        }
+        path += node.name;
+
+        int64_t microseconds = node.exclusive_ns / 1000;
+        if (microseconds > 0) {
+            stream << path << " " << microseconds << "\n";
+        }
+        push_children(index, path.size());
+    }
+}
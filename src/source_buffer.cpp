@@ -0,0 +1,108 @@
+#include "source_buffer.h"
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SourceBuffer::~SourceBuffer() {
+    release();
+}
+
+bool SourceBuffer::load(const std::string &file_path) {
+    release();
+
+#ifndef _WIN32
+    int file = open(file_path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+
+    // Empty files can't be mapped, and have no text anyway
+    struct stat status {};
+    if (fstat(file, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+        void *mapping = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapping != MAP_FAILED) {
+            data = static_cast<const char *>(mapping);
+            size = (size_t)status.st_size;
+            mapped = true;
+            close(file);
+            return true;
+        }
+    }
+    close(file);
+#endif
+
+    // Fall back to reading the whole file at once
+    std::ifstream stream(file_path, std::ios::binary | std::ios::ate);
+    if (!stream.good()) {
+        return false;
+    }
+    std::streamoff length = stream.tellg();
+    contents.resize(length > 0 ? (size_t)length : 0);
+    stream.seekg(0);
+    stream.read(contents.data(), (std::streamsize)contents.size());
+    data = contents.data();
+    size = contents.size();
+    return true;
+}
+
+void SourceBuffer::assign(std::string text) {
+    release();
+    contents = std::move(text);
+    data = contents.data();
+    size = contents.size();
+}
+
+void SourceBuffer::release() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap(const_cast<char *>(data), size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    mapped = false;
+    contents.clear();
+    line_starts.clear();
+}
+
+size_t SourceBuffer::get_line_count() const {
+    index_lines();
+    return line_starts.size();
+}
+
+std::string_view SourceBuffer::get_line(int line) const {
+    index_lines();
+    if (line < 1 || (size_t)line > line_starts.size()) {
+        return {};
+    }
+
+    size_t start = line_starts[line - 1];
+    size_t end = (size_t)line < line_starts.size() ? line_starts[line] - 1 : size;
+    if (end > start && data[end - 1] == '\n') {
+        end--;
+    }
+    return {data + start, end - start};
+}
+
+void SourceBuffer::index_lines() const {
+    if (!line_starts.empty() || size == 0) {
+        return;
+    }
+
+    line_starts.push_back(0);
+    const char *position = data;
+    const char *end = data + size;
+    while ((position = static_cast<const char *>(std::memchr(position, '\n', end - position)))) {
+        position++;
+        if (position == end) {
+            break;
+        }
+        line_starts.push_back(position - data);
+    }
+}
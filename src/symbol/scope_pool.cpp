@@ -0,0 +1,38 @@
+#include "symbol/scope_pool.h"
+
+ScopePool::~ScopePool() {
+    for (auto *table : free_tables) {
+        delete table;
+    }
+}
+
+SymbolTable *ScopePool::acquire(SymbolTable *enclosing_scope, bool loop, bool function) {
+    SymbolTable *table;
+    if (free_tables.empty()) {
+        // Pooled tables are not owned by their enclosing scope
+        table = new SymbolTable(nullptr);
+        allocated_size++;
+    } else {
+        table = free_tables.back();
+        free_tables.pop_back();
+    }
+
+    table->reset(enclosing_scope, loop, function);
+    return table;
+}
+
+void ScopePool::release(SymbolTable *table) {
+    table->reset(nullptr);
+    free_tables.push_back(table);
+}
+
+size_t ScopePool::get_allocated_size() const {
+    return allocated_size;
+}
+
+PooledScope::PooledScope(ScopePool *pool, SymbolTable *enclosing_scope, bool loop, bool function)
+    : pool(pool), table(pool->acquire(enclosing_scope, loop, function)) {}
+
+PooledScope::~PooledScope() {
+    pool->release(table);
+}
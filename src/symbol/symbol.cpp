@@ -2,27 +2,23 @@
 #include <memory>
 #include <utility>
 
-Symbol::Symbol(std::string name) : name(std::move(name)), value(nullptr) {}
+Symbol::Symbol(std::string name) : name(std::move(name)) {}
 
-Symbol::Symbol(std::string name, std::shared_ptr<Object> value)
+Symbol::Symbol(std::string name, Value value)
     : name(std::move(name)), value(std::move(value)) {}
 
 std::string Symbol::get_name() const {
     return name;
 }
 
-void Symbol::set_value(std::shared_ptr<Object> value) {
+void Symbol::set_value(Value value) {
     this->value = std::move(value);
 }
 
-std::shared_ptr<Object> Symbol::get_value() const {
+Value Symbol::get_value() const {
     return value;
 }
 
 Type Symbol::get_type() const {
-    if (value) {
-        return value->get_type();
-    } else {
-        return Type::TYPE_UNDEF;
-    }
+    return value.get_type();
 }
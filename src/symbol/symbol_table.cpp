@@ -20,7 +20,20 @@ SymbolTable::~SymbolTable() {
     }
 }
 
+void SymbolTable::reset(SymbolTable *enclosing_scope, bool loop, bool function) {
+    this->enclosing_scope = enclosing_scope;
+    this->loop = loop;
+    this->function = function;
+    global_scope = enclosing_scope ? enclosing_scope->get_global_scope() : this;
+
+    // Clearing keeps the capacity of the slots for the next use of the table
+    symbols.clear();
+    slot_indices.clear();
+    slots.clear();
+}
+
 void SymbolTable::insert(Symbol symbol) {
+    set_slot(slot_index(symbol.get_name()), symbol.get_value());
     symbols[symbol.get_name()] = symbol;
 }
 
@@ -69,3 +82,93 @@ SymbolTable *SymbolTable::get_global_scope() const {
 void SymbolTable::add_child(SymbolTable *symbol_table) {
     child_scopes.push_back(symbol_table);
 }
+
+VariableSlot SymbolTable::resolve(const std::string &name) const {
+    int depth = 0;
+    for (const SymbolTable *scope = this; scope; scope = scope->enclosing_scope, depth++) {
+        // Only declared symbols are resolved (not reserved slots)
+        if (scope->symbols.find(name) == scope->symbols.end()) {
+            continue;
+        }
+
+        VariableSlot slot;
+        slot.depth = scope->is_global_scope() ? VariableSlot::GLOBAL_DEPTH : depth;
+        slot.slot = scope->slot_indices.at(name);
+        return slot;
+    }
+
+    return {};
+}
+
+int SymbolTable::slot_index(const std::string &name) {
+    auto it = slot_indices.find(name);
+    if (it != slot_indices.end()) {
+        return it->second;
+    }
+
+    int index = (int)slot_indices.size();
+    slot_indices[name] = index;
+    return index;
+}
+
+std::vector<std::string> SymbolTable::get_slot_names() const {
+    std::vector<std::string> names(slot_indices.size());
+    for (auto &slot_index : slot_indices) {
+        names[slot_index.second] = slot_index.first;
+    }
+
+    return names;
+}
+
+Value SymbolTable::get_slot(int index) const {
+    if (index < 0 || index >= (int)slots.size()) {
+        return {};
+    }
+
+    return slots[index];
+}
+
+void SymbolTable::set_slot(int index, Value value) {
+    if (index >= (int)slots.size()) {
+        slots.resize(index + 1);
+    }
+
+    slots[index] = std::move(value);
+}
+
+Value SymbolTable::load(const VariableSlot &slot) const {
+    Value value = get_scope(slot.depth)->get_slot(slot.slot);
+
+    // Fall back to the global while the local variable is undefined
+    if (!value.is_defined() && slot.has_global_fallback()) {
+        return global_scope->get_slot(slot.global_slot);
+    }
+
+    return value;
+}
+
+void SymbolTable::store(const VariableSlot &slot, Value value) {
+    SymbolTable *scope = get_scope(slot.depth);
+
+    // Update the global if it was declared before the local variable
+    if (slot.has_global_fallback() && !scope->get_slot(slot.slot).is_defined() &&
+        global_scope->get_slot(slot.global_slot).is_defined()) {
+        global_scope->set_slot(slot.global_slot, std::move(value));
+        return;
+    }
+
+    scope->set_slot(slot.slot, std::move(value));
+}
+
+SymbolTable *SymbolTable::get_scope(int depth) const {
+    if (depth == VariableSlot::GLOBAL_DEPTH) {
+        return global_scope;
+    }
+
+    auto *scope = const_cast<SymbolTable *>(this);
+    for (int i = 0; i < depth; i++) {
+        scope = scope->enclosing_scope;
+    }
+
+    return scope;
+}
@@ -2,7 +2,7 @@
 
 std::string type_to_string(Type type) {
     std::string type_names[]{
-        "int", "float", "bool", "string", "void", "array", "function", "<error>"};
+        "int", "float", "bool", "string", "void", "array", "function", "file", "<error>"};
     return type_names[type];
 }
 
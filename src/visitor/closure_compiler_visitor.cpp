@@ -0,0 +1,811 @@
+#include "visitor/closure_compiler_visitor.h"
+#include "AST/AST_nodes.h"
+#include "object/array_object.h"
+#include "object/function_object.h"
+#include "object/string_object.h"
+#include "operators.h"
+#include <array>
+#include <climits>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+/**
+ * @brief The number of levels of the AST between the nodes that check the space left on the stack.
+ */
+constexpr int STACK_CHECK_INTERVAL = 16;
+
+/**
+ * @brief Check if a variable is stored in the scope it is used in, and has no global fallback, so
+ * its slot can be accessed directly.
+ * @param slot The slot of the variable.
+ * @return True if the variable is local to the scope.
+ */
+bool is_local(const VariableSlot &slot) {
+    return slot.depth == 0 && !slot.has_global_fallback();
+}
+
+/**
+ * @brief Compile a binary operator known at compile time.
+ *
+ * Ints are computed inline, and other operands go through the kernel for their types.
+ *
+ * @tparam Op The operator.
+ * @param node The node of the operator.
+ * @param left The closure of the left operand.
+ * @param right The closure of the right operand.
+ * @param error_manager The error manager to report invalid operands to.
+ * @return The closure of the operator.
+ */
+template <BinaryOperator Op>
+Closure bind_binary_operator(BinOpNode *node,
+                             Closure left,
+                             Closure right,
+                             ErrorManager *error_manager) {
+    return [node, left = std::move(left), right = std::move(right), error_manager](
+               SymbolTable *table) {
+        Value left_value = left(table);
+        Value right_value = right(table);
+        Value result;
+        if (left_value.get_type() == TYPE_INT && right_value.get_type() == TYPE_INT) {
+            result = apply_int_operator(Op, left_value.get_int(), right_value.get_int());
+        } else {
+            result = apply_binary_operator(Op, left_value, right_value);
+        }
+
+        // An undefined result indicates an invalid operation
+        if (!result.is_defined()) {
+            error_manager->runtime_error("Invalid operands to binary operator " +
+                                             token_values[node->get_op()] + " (" +
+                                             type_to_string(left_value.get_type()) + " and " +
+                                             type_to_string(right_value.get_type()) + ")",
+                                         node->get_line(),
+                                         node->get_column());
+        }
+
+        return result;
+    };
+}
+
+using BinaryOperatorBinder = Closure (*)(BinOpNode *, Closure, Closure, ErrorManager *);
+
+template <size_t... I>
+constexpr std::array<BinaryOperatorBinder, sizeof...(I)>
+make_binary_operator_binders(std::index_sequence<I...>) {
+    return {{&bind_binary_operator<BinaryOperator(I)>...}};
+}
+
+/**
+ * @brief The compiler of each binary operator, by operator.
+ */
+const std::array<BinaryOperatorBinder, BINARY_OPERATOR_COUNT> binary_operator_binders =
+    make_binary_operator_binders(std::make_index_sequence<BINARY_OPERATOR_COUNT>());
+} // namespace
+
+ClosureCompilerVisitor::ClosureCompilerVisitor(ProgramNode *program_node,
+                                               ErrorManager *error_manager)
+    : error_manager(error_manager), program_node(program_node), built_in_functions(error_manager) {}
+
+void ClosureCompilerVisitor::interpret() {
+    // The whole program is compiled before any of it runs
+    Closure program = program_node->bind(this, 0);
+
+    // Deep recursion runs on a stack of its own, rather than on the stack of the calling thread
+    CallStack stack(max_call_depth);
+    call_stack = &stack;
+    stack.run([&program]() { program(nullptr); });
+    call_stack = nullptr;
+
+    built_in_functions.flush();
+}
+
+Closure ClosureCompilerVisitor::visit(ProgramNode *node, int arg) {
+    std::vector<Closure> statements;
+    for (auto &statement : *node->get_statements()) {
+        statements.push_back(bind_child(statement, arg));
+    }
+
+    return [this, statements = std::move(statements)](SymbolTable *table) {
+        // Create symbol table for the global scope
+        std::unique_ptr<SymbolTable> global_table(new SymbolTable(nullptr, false, false));
+
+        built_in_functions.register_built_in_functions(global_table.get());
+
+        for (auto &statement : statements) {
+            statement(global_table.get());
+        }
+
+        return Value();
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(BinOpNode *node, int arg) {
+    Closure left = bind_child(node->get_left_node(), arg);
+    Closure right = bind_child(node->get_right_node(), arg);
+
+    return binary_operator_binders[node->get_binary_operator()](
+        node, std::move(left), std::move(right), error_manager);
+}
+
+Closure ClosureCompilerVisitor::visit(CastOpNode *node, int arg) {
+    Closure operand = bind_child(node->get_operand(), arg);
+
+    return [this, node, operand = std::move(operand), type = node->get_type()](
+               SymbolTable *table) {
+        Value operand_value = operand(table);
+        Value result = operand_value.cast(type);
+
+        // An undefined result indicates an invalid operation
+        if (!result.is_defined()) {
+            runtime_error("Invalid cast from " + type_to_string(operand_value.get_type()) +
+                              " to " + type_to_string(type),
+                          node->get_line(),
+                          node->get_column());
+        }
+
+        return result;
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(SubscriptOpNode *node, int arg) {
+    Closure identifier = bind_child(node->get_identifier(), arg);
+    Closure index = bind_child(node->get_index(), arg);
+
+    return [this, node, identifier = std::move(identifier), index = std::move(index)](
+               SymbolTable *table) {
+        Value identifier_value = identifier(table);
+        Value index_value = index(table);
+        Value result;
+
+        // Read the element of an array directly, rather than through the subscript operation
+        if (identifier_value.get_type() == TYPE_ARRAY && index_value.get_type() == TYPE_INT) {
+            auto *array = identifier_value.as<ArrayObject>();
+            int i = index_value.get_int();
+            if (i >= 0 && i < array->get_len()) {
+                result = array->get_element(i);
+            }
+        } else {
+            result = identifier_value.subscript(index_value);
+        }
+
+        // An undefined result indicates an invalid operation
+        if (!result.is_defined()) {
+            runtime_error("Invalid subscript operation on " +
+                              type_to_string(identifier_value.get_type()),
+                          node->get_line(),
+                          node->get_column());
+        }
+
+        return result;
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(SliceOpNode *node, int arg) {
+    Closure identifier = bind_child(node->get_identifier(), arg);
+    Closure start = bind_child(node->get_start(), arg);
+    Closure end = bind_child(node->get_end(), arg);
+
+    return [this,
+            node,
+            identifier = std::move(identifier),
+            start = std::move(start),
+            end = std::move(end)](SymbolTable *table) {
+        Value identifier_value = identifier(table);
+        Value start_value = start(table);
+        Value end_value = end(table);
+        Value result = identifier_value.slice(start_value, end_value);
+
+        // An undefined result indicates an invalid operation
+        if (!result.is_defined()) {
+            runtime_error("Invalid slice operation on " +
+                              type_to_string(identifier_value.get_type()),
+                          node->get_line(),
+                          node->get_column());
+        }
+
+        return result;
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(UnaryOpNode *node, int arg) {
+    Closure operand = bind_child(node->get_operand(), arg);
+
+    return [this, node, operand = std::move(operand), op = node->get_unary_operator()](
+               SymbolTable *table) {
+        Value operand_value = operand(table);
+        Value result = apply_unary_operator(op, operand_value);
+
+        // An undefined result indicates an invalid operation
+        if (!result.is_defined()) {
+            runtime_error("Invalid operand to unary operator " + token_values[node->get_op()] +
+                              " (" + type_to_string(operand_value.get_type()) + ")",
+                          node->get_line(),
+                          node->get_column());
+        }
+
+        return result;
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(ArrayLiteralNode *node, int arg) {
+    std::vector<Closure> elements;
+    for (auto &element : *node->get_values()) {
+        elements.push_back(bind_child(element, arg));
+    }
+
+    return [elements = std::move(elements)](SymbolTable *table) {
+        // Create an array object from the values
+        std::vector<Value> values;
+        values.reserve(elements.size());
+        for (auto &element : elements) {
+            values.push_back(element(table));
+        }
+
+        return Value(std::make_shared<ArrayObject>(std::move(values)));
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(RangeLiteralNode *node, int arg) {
+    Closure start = bind_child(node->get_start(), arg);
+    Closure end = bind_child(node->get_end(), arg);
+
+    return [this, node, start = std::move(start), end = std::move(end)](SymbolTable *table) {
+        Value start_value = start(table);
+        Value end_value = end(table);
+
+        // The start value must be an integer
+        if (start_value.get_type() != TYPE_INT) {
+            runtime_error("Invalid type for start of range (expected int, got " +
+                              type_to_string(start_value.get_type()) + ")",
+                          node->get_start()->get_line(),
+                          node->get_start()->get_column());
+        }
+        // The end value must be an integer
+        else if (end_value.get_type() != TYPE_INT) {
+            runtime_error("Invalid type for end of range (expected int, got " +
+                              type_to_string(end_value.get_type()) + ")",
+                          node->get_end()->get_line(),
+                          node->get_end()->get_column());
+        }
+
+        // The elements of the range are only created if the array is modified
+        auto range = ArrayObject::from_range(start_value.get_int(), end_value.get_int());
+        if (!range) {
+            runtime_error("Range too long (more than " + std::to_string(INT_MAX) + " elements)",
+                          node->get_line(),
+                          node->get_column());
+        }
+        return Value(std::move(range));
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(AssignmentNode *node, int arg) {
+    Closure value = bind_child(node->get_value(), arg);
+
+    // Cannot assign to void
+    auto check_value = [this, node](const Value &value) {
+        if (value.get_type() == TYPE_VOID) {
+            runtime_error("Invalid assignment to void", node->get_line(), node->get_column());
+        }
+    };
+
+    // If the identifier is an array subscript operation
+    if (node->get_identifier()->get_node_type() == NodeType::SUBSCRIPT_OP_NODE) {
+        auto *left = static_cast<SubscriptOpNode *>(node->get_identifier());
+        Closure identifier = bind_child(left->get_identifier(), arg);
+        Closure index = bind_child(left->get_index(), arg);
+
+        return [this,
+                left,
+                check_value,
+                value = std::move(value),
+                identifier = std::move(identifier),
+                index = std::move(index)](SymbolTable *table) {
+            Value result = value(table);
+            check_value(result);
+
+            // Update the value at the index (only arrays can be updated, within their bounds)
+            Value identifier_value = identifier(table);
+            Value index_value = index(table);
+            if (identifier_value.get_type() != TYPE_ARRAY ||
+                !identifier_value.as<ArrayObject>()->subscript_update(index_value, result)
+                     .is_defined()) {
+                runtime_error("Invalid subscript operation on " +
+                                  type_to_string(identifier_value.get_type()),
+                              left->get_line(),
+                              left->get_column());
+            }
+            return result;
+        };
+    }
+
+    // If the identifier is just an identifier
+    if (node->get_identifier()->get_node_type() == NodeType::IDENTIFIER_NODE) {
+        const VariableSlot &slot = node->get_slot();
+        if (is_local(slot)) {
+            return [check_value, value = std::move(value), index = slot.slot](SymbolTable *table) {
+                Value result = value(table);
+                check_value(result);
+                table->set_slot(index, result);
+                return result;
+            };
+        }
+
+        // Update the variable (declaring it if this is its first assignment)
+        return [check_value, value = std::move(value), slot](SymbolTable *table) {
+            Value result = value(table);
+            check_value(result);
+            table->store(slot, result);
+            return result;
+        };
+    }
+
+    return [check_value, value = std::move(value)](SymbolTable *table) {
+        Value result = value(table);
+        check_value(result);
+        return result;
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(BreakStatementNode *node, int arg) {
+    return [this](SymbolTable *table) {
+        backtracking = true;
+        breaking = true;
+        return Value();
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(ContinueStatementNode *node, int arg) {
+    return [this](SymbolTable *table) {
+        backtracking = true;
+        return Value();
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(ReturnStatementNode *node, int arg) {
+    // No return value, so return void
+    if (!node->has_value()) {
+        return [this](SymbolTable *table) {
+            return_value = Value::make_void();
+            returning = true;
+            return Value();
+        };
+    }
+
+    Closure value = bind_child(node->get_value(), arg);
+    return [this, value = std::move(value)](SymbolTable *table) {
+        return_value = value(table);
+        returning = true;
+        return Value();
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(ForStatementNode *node, int arg) {
+    Closure iterable = bind_child(node->get_iterable(), arg);
+    Closure body = bind_child(node->get_body(), arg);
+
+    return [this, node, iterable = std::move(iterable), body = std::move(body)](
+               SymbolTable *table) {
+        Value iterable_value = iterable(table);
+
+        // Only arrays, strings and files can be iterated through
+        Type iterable_type = iterable_value.get_type();
+        if (iterable_type != TYPE_ARRAY && iterable_type != TYPE_STRING &&
+            iterable_type != TYPE_FILE) {
+            runtime_error("Invalid type for iterable (expected array, string or file, got " +
+                              type_to_string(iterable_type) + ")",
+                          node->get_iterable()->get_line(),
+                          node->get_iterable()->get_column());
+        }
+
+        // Create a new scope for the for loop (the iterator is its first slot)
+        PooledScope for_loop_scope(&scope_pool, table, true, table->is_function());
+        SymbolTable *for_loop_table = for_loop_scope.get();
+
+        // The number of iterations is fixed when the loop starts
+        Object *iterable_object = iterable_value.get_object();
+        int iteration_len = iterable_object->get_iteration_len();
+        Value element;
+        for (int i = 0; i < iteration_len && iterable_object->iterate(i, element); i++) {
+            // Set the value of the iterator
+            for_loop_table->set_slot(0, std::move(element));
+
+            body(for_loop_table);
+
+            // Handle breaking, continuing and returning
+            if (returning) {
+                break;
+            } else if (backtracking) {
+                backtracking = false;
+                if (breaking) {
+                    breaking = false;
+                    break;
+                }
+            }
+        }
+
+        return Value();
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(IfStatementNode *node, int arg) {
+    Closure condition = bind_child(node->get_condition(), arg);
+    Closure if_body = bind_child(node->get_if_body(), arg);
+    Closure else_body;
+    if (node->get_else_body() != nullptr) {
+        else_body = bind_child(node->get_else_body(), arg);
+    }
+
+    return [this,
+            node,
+            condition = std::move(condition),
+            if_body = std::move(if_body),
+            else_body = std::move(else_body)](SymbolTable *table) {
+        // Create a new scope for the if statement
+        PooledScope if_statement_scope(&scope_pool, table, table->is_loop(), table->is_function());
+        SymbolTable *if_statement_table = if_statement_scope.get();
+
+        Value condition_value = condition(if_statement_table);
+
+        // The condition must be a boolean
+        if (condition_value.get_type() != TYPE_BOOL) {
+            runtime_error("Invalid type for if condition (expected bool, got " +
+                              type_to_string(condition_value.get_type()) + ")",
+                          node->get_condition()->get_line(),
+                          node->get_condition()->get_column());
+        }
+        // If condition, then evaluate the if body
+        else if (condition_value.get_bool()) {
+            if_body(if_statement_table);
+        }
+        // Else, evaluate the else body (if it exists)
+        else if (else_body) {
+            else_body(if_statement_table);
+        }
+
+        return Value();
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(RepeatStatementNode *node, int arg) {
+    Closure count = bind_child(node->get_count(), arg);
+    Closure body = bind_child(node->get_body(), arg);
+
+    return [this, node, count = std::move(count), body = std::move(body)](SymbolTable *table) {
+        // Create a new scope for the repeat loop
+        PooledScope repeat_loop_scope(&scope_pool, table, true, table->is_function());
+        SymbolTable *repeat_loop_table = repeat_loop_scope.get();
+
+        // Count must be an integer
+        Value count_value = count(repeat_loop_table);
+        if (count_value.get_type() != TYPE_INT) {
+            runtime_error("Invalid type for repeat count (expected int, got " +
+                              type_to_string(count_value.get_type()) + ")",
+                          node->get_count()->get_line(),
+                          node->get_count()->get_column());
+        }
+
+        // Repeat the body `count` times
+        for (int i = 0; i < count_value.get_int(); i++) {
+            body(repeat_loop_table);
+
+            // Handle breaking, continuing and returning
+            if (returning) {
+                break;
+            } else if (backtracking) {
+                backtracking = false;
+                if (breaking) {
+                    breaking = false;
+                    break;
+                }
+            }
+        }
+
+        return Value();
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(WhileStatementNode *node, int arg) {
+    Closure condition = bind_child(node->get_condition(), arg);
+    Closure body = bind_child(node->get_body(), arg);
+
+    return [this, node, condition = std::move(condition), body = std::move(body)](
+               SymbolTable *table) {
+        // Create a new scope for the while loop
+        PooledScope while_loop_scope(&scope_pool, table, true, table->is_function());
+        SymbolTable *while_loop_table = while_loop_scope.get();
+
+        // The condition must be a boolean, checked before each iteration
+        while (true) {
+            Value condition_value = condition(while_loop_table);
+            if (condition_value.get_type() != TYPE_BOOL) {
+                runtime_error("Invalid type for while condition (expected bool, got " +
+                                  type_to_string(condition_value.get_type()) + ")",
+                              node->get_condition()->get_line(),
+                              node->get_condition()->get_column());
+            }
+            if (!condition_value.get_bool()) {
+                break;
+            }
+
+            body(while_loop_table);
+
+            // Handle breaking, continuing and returning
+            if (returning) {
+                break;
+            } else if (backtracking) {
+                backtracking = false;
+                if (breaking) {
+                    breaking = false;
+                    break;
+                }
+            }
+        }
+
+        return Value();
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(FunctionDeclarationNode *node, int arg) {
+    // The body is compiled once, and shared by the function objects of every evaluation
+    function_bodies.push_back(std::make_unique<Closure>(bind_child(node->get_body(), arg)));
+    const Closure *body = function_bodies.back().get();
+
+    return [node, body](SymbolTable *table) {
+        return Value(
+            std::make_shared<FunctionObject>(node->get_body(), *node->get_parameters(), body));
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(CallOpNode *node, int arg) {
+    std::vector<Closure> arguments;
+    for (size_t i = 0; i < node->get_arguments_size(); i++) {
+        arguments.push_back(bind_child(node->get_argument(i), arg));
+    }
+
+    // Calls to built-in functions were bound by semantic analysis
+    int built_in_id = node->get_built_in_id();
+    if (built_in_id >= 0) {
+        return [this, node, built_in_id, arguments = std::move(arguments)](SymbolTable *table) {
+            return call_built_in(node, built_in_id, arguments, table);
+        };
+    }
+
+    return [this, node, arguments = std::move(arguments)](SymbolTable *table) {
+        // Get the function object from its slot
+        Value function_value = table->load(node->get_slot());
+        if (!function_value.is_defined()) {
+            runtime_error("Undeclared identifier '" + node->get_identifier() + "'",
+                          node->get_line(),
+                          node->get_column());
+        }
+
+        auto *function_object = function_value.as<FunctionObject>();
+
+        // If the value is a function
+        if (function_value.get_type() == TYPE_FUNCTION) {
+            // Check if the number of arguments is correct
+            if (function_object->get_parameters_size() != arguments.size()) {
+                runtime_error("Incorrect number of arguments to function '" +
+                                  node->get_identifier() + "' (expected " +
+                                  std::to_string(function_object->get_parameters_size()) +
+                                  ", given " + std::to_string(arguments.size()) + ")",
+                              node->get_line(),
+                              node->get_column());
+            }
+        } else {
+            runtime_error("Identifier '" + node->get_identifier() + "' is not a function",
+                          node->get_line(),
+                          node->get_column());
+        }
+
+        if (function_object->is_built_in()) {
+            return call_built_in(node, function_object->get_built_in_id(), arguments, table);
+        }
+
+        // A call in tail position is handed to the call being returned from, which runs it in its
+        // own frame. Its arguments are evaluated first, as they may make (and hand over) calls of
+        // their own
+        if (node->is_tail_call()) {
+            for (auto &argument : arguments) {
+                tail_call_arguments.push_back(argument(table));
+            }
+            tail_call_function = std::move(function_value);
+            tail_call_node = node;
+            return Value::make_void();
+        }
+
+        return call_function(node, function_value, arguments, table);
+    };
+}
+
+Value ClosureCompilerVisitor::call_function(CallOpNode *node,
+                                            const Value &function,
+                                            const std::vector<Closure> &arguments,
+                                            SymbolTable *table) {
+    // Nested calls are limited by the maximum depth, and by the space left on the stack
+    if (call_depth >= max_call_depth || (call_stack && call_stack->is_exhausted())) {
+        recursion_error(node);
+    }
+    call_depth++;
+
+    // Create a new scope for the function with the arguments (in the first slots)
+    PooledScope function_scope(&scope_pool, table->get_global_scope(), false, true);
+    SymbolTable *function_table = function_scope.get();
+    for (size_t i = 0; i < arguments.size(); i++) {
+        function_table->set_slot((int)i, arguments[i](table));
+    }
+
+    (*function.as<FunctionObject>()->get_closure())(function_table);
+
+    // Calls in tail position replace the function in the same scope, so they don't nest
+    while (tail_call_node) {
+        CallOpNode *tail_node = tail_call_node;
+        Value tail_function = std::move(tail_call_function);
+        tail_call_node = nullptr;
+        returning = false;
+
+        function_table->reset(table->get_global_scope(), false, true);
+        size_t arguments_start = tail_call_arguments.size() - tail_node->get_arguments_size();
+        for (size_t i = 0; i < tail_node->get_arguments_size(); i++) {
+            function_table->set_slot((int)i, std::move(tail_call_arguments[arguments_start + i]));
+        }
+        tail_call_arguments.resize(arguments_start);
+
+        (*tail_function.as<FunctionObject>()->get_closure())(function_table);
+    }
+
+    returning = false;
+    call_depth--;
+
+    // Take the return value, leaving void for the next call that does not return a value
+    Value result = std::move(return_value);
+    return_value = Value::make_void();
+
+    return result;
+}
+
+Value ClosureCompilerVisitor::call_built_in(CallOpNode *node,
+                                            int built_in_id,
+                                            const std::vector<Closure> &arguments,
+                                            SymbolTable *table) {
+    const BuiltInFunction &built_in = BuiltInFunctions::get(built_in_id);
+    if (built_in.param_count != (int)arguments.size()) {
+        runtime_error("Incorrect number of arguments to function '" + node->get_identifier() +
+                          "' (expected " + std::to_string(built_in.param_count) + ", given " +
+                          std::to_string(arguments.size()) + ")",
+                      node->get_line(),
+                      node->get_column());
+    }
+
+    // Built-in functions take few arguments, which are evaluated into a fixed array
+    Value argument_values[BuiltInFunctions::MAX_PARAMETERS];
+    for (int i = 0; i < built_in.param_count; i++) {
+        argument_values[i] = arguments[i](table);
+    }
+
+    return built_in_functions.call(
+        built_in_id, argument_values, node->get_line(), node->get_column());
+}
+
+Closure ClosureCompilerVisitor::visit(CompoundStatementNode *node, int arg) {
+    std::vector<Closure> statements;
+    for (auto &statement : *node->get_statements()) {
+        statements.push_back(bind_child(statement, arg));
+    }
+
+    return [this, statements = std::move(statements)](SymbolTable *table) {
+        // Create a new scope for the compound statement
+        PooledScope compound_statement_scope(
+            &scope_pool, table, table->is_loop(), table->is_function());
+        SymbolTable *compound_statement_table = compound_statement_scope.get();
+
+        for (auto &statement : statements) {
+            // Handle breaking
+            if (backtracking || returning) {
+                break;
+            }
+
+            statement(compound_statement_table);
+        }
+
+        return Value();
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(IdentifierNode *node, int arg) {
+    auto undeclared = [this, node]() {
+        runtime_error("Undeclared identifier '" + node->get_name() + "'",
+                      node->get_line(),
+                      node->get_column());
+    };
+
+    const VariableSlot &slot = node->get_slot();
+    if (is_local(slot)) {
+        return [undeclared, index = slot.slot](SymbolTable *table) {
+            Value value = table->get_slot(index);
+            if (!value.is_defined()) {
+                undeclared();
+            }
+
+            return value;
+        };
+    }
+
+    // Get identifier value from its slot
+    return [undeclared, slot](SymbolTable *table) {
+        Value value = table->load(slot);
+        if (!value.is_defined()) {
+            undeclared();
+        }
+
+        return value;
+    };
+}
+
+Closure ClosureCompilerVisitor::visit(LiteralNode *node, int arg) {
+    // Convert the literal to a value once, unless it is out of range (an error at runtime)
+    Value value = node->get_constant();
+    if (!value.is_defined()) {
+        try {
+            switch (node->get_type()) {
+            case TYPE_INT:
+                value = Value::from_int(std::stoi(node->get_value()));
+                break;
+            case TYPE_FLOAT:
+                value = Value::from_float(std::stof(node->get_value()));
+                break;
+            case TYPE_BOOL:
+                value = Value::from_bool(node->get_value() == "true");
+                break;
+            case TYPE_STRING:
+                value = Value(StringObject::from_string_literal(node->get_value()));
+                break;
+            default:
+                break;
+            }
+        } catch (const std::out_of_range &e) {
+            std::string message = node->get_type() == TYPE_INT ? "Integer value out of range"
+                                                               : "Float value out of range";
+            return [this, node, message](SymbolTable *table) {
+                runtime_error(message, node->get_line(), node->get_column());
+                return Value();
+            };
+        }
+    }
+
+    return [value](SymbolTable *table) { return value; };
+}
+
+Closure ClosureCompilerVisitor::visit(ErrorNode *node, int arg) {
+    return [this, node](SymbolTable *table) {
+        // This should never occur!
+        runtime_error("Error node", node->get_line(), node->get_column());
+        return Value();
+    };
+}
+
+void ClosureCompilerVisitor::recursion_error(ASTNode *node) {
+    runtime_error("Maximum recursion depth exceeded (" + std::to_string(call_depth) +
+                      " nested calls)",
+                  node->get_line(),
+                  node->get_column());
+}
+
+Closure ClosureCompilerVisitor::bind_child(ASTNode *child, int depth) {
+    Closure closure = child->bind(this, depth + 1);
+    if ((depth + 1) % STACK_CHECK_INTERVAL != 0) {
+        return closure;
+    }
+
+    return [this, child, closure = std::move(closure)](SymbolTable *table) {
+        if (call_stack && call_stack->is_exhausted()) {
+            recursion_error(child);
+        }
+        return closure(table);
+    };
+}
+
+void ClosureCompilerVisitor::runtime_error(const std::string &message, int line, int column) {
+    error_manager->runtime_error(message, line, column);
+}
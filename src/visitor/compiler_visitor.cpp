@@ -0,0 +1,657 @@
+#include "visitor/compiler_visitor.h"
+#include "AST/AST_nodes.h"
+#include "object/function_object.h"
+#include "object/string_object.h"
+#include "operators.h"
+#include <stdexcept>
+
+namespace {
+// The opcodes of the operators are in the order of the operators, so the virtual machine indexes
+// the kernel tables with them
+static_assert(OP_NOT_EQUAL - OP_ADD + 1 == BINARY_OPERATOR_COUNT);
+static_assert(OP_BITWISE_NOT - OP_POSITIVE + 1 == UNARY_OPERATOR_COUNT);
+
+/**
+ * @brief Get the opcode of a binary operator.
+ * @param op The operator.
+ * @return The opcode.
+ */
+OpCode binary_opcode(BinaryOperator op) {
+    return (OpCode)(OP_ADD + op);
+}
+
+/**
+ * @brief Get the opcode of a unary operator.
+ * @param op The operator.
+ * @return The opcode.
+ */
+OpCode unary_opcode(UnaryOperator op) {
+    return (OpCode)(OP_POSITIVE + op);
+}
+
+/**
+ * @brief Check if evaluating a node could assign to a variable.
+ * @param node The node to check.
+ * @return True if the node contains an assignment (outside of function declarations).
+ */
+bool contains_assignment(ASTNode *node) {
+    switch (node->get_node_type()) {
+    case ASSIGNMENT_NODE:
+        return true;
+    case BIN_OP_NODE: {
+        auto *bin_op = static_cast<BinOpNode *>(node);
+        return contains_assignment(bin_op->get_left_node()) ||
+               contains_assignment(bin_op->get_right_node());
+    }
+    case CAST_OP_NODE:
+        return contains_assignment(static_cast<CastOpNode *>(node)->get_operand());
+    case UNARY_OP_NODE:
+        return contains_assignment(static_cast<UnaryOpNode *>(node)->get_operand());
+    case SLICE_OP_NODE: {
+        auto *slice = static_cast<SliceOpNode *>(node);
+        return contains_assignment(slice->get_identifier()) ||
+               contains_assignment(slice->get_start()) || contains_assignment(slice->get_end());
+    }
+    case SUBSCRIPT_OP_NODE: {
+        auto *subscript = static_cast<SubscriptOpNode *>(node);
+        return contains_assignment(subscript->get_identifier()) ||
+               contains_assignment(subscript->get_index());
+    }
+    case RANGE_LITERAL_NODE: {
+        auto *range = static_cast<RangeLiteralNode *>(node);
+        return contains_assignment(range->get_start()) || contains_assignment(range->get_end());
+    }
+    case ARRAY_LITERAL_NODE:
+        for (auto &value : *static_cast<ArrayLiteralNode *>(node)->get_values()) {
+            if (contains_assignment(value)) {
+                return true;
+            }
+        }
+        return false;
+    case CALL_NODE:
+        for (auto &argument : *static_cast<CallOpNode *>(node)->get_arguments()) {
+            if (contains_assignment(argument)) {
+                return true;
+            }
+        }
+        return false;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Check if a value can be void, so assigning it must be checked at runtime.
+ * @param node The value node.
+ * @return True if the value can be void.
+ */
+bool can_be_void(ASTNode *node) {
+    NodeType type = node->get_node_type();
+    return type == CALL_NODE || type == SUBSCRIPT_OP_NODE || type == IDENTIFIER_NODE;
+}
+
+/**
+ * @brief Get the type mask bit of a type, used by OP_CHECK_TYPE.
+ * @param type The type.
+ * @return The mask bit.
+ */
+int type_bit(Type type) {
+    return 1 << type;
+}
+} // namespace
+
+CompilerVisitor::CompilerVisitor(ProgramNode *program_node, ErrorManager *error_manager)
+    : error_manager(error_manager), program_node(program_node), built_in_functions(error_manager) {}
+
+BytecodeProgram *CompilerVisitor::compile() {
+    program = new BytecodeProgram();
+    program_node->compile(this, -1);
+
+    BytecodeProgram *result = program;
+    program = nullptr;
+    return result;
+}
+
+int CompilerVisitor::visit(ProgramNode *node, int dest) {
+    auto *main_function = new BytecodeFunction(0);
+    program->add_function(main_function);
+
+    // The globals are laid out in the slots given by semantic analysis. The built-in functions
+    // are globals that exist from the start.
+    std::unordered_map<std::string, Value> built_in_objects;
+    for (auto &built_in_function : built_in_functions.create_function_objects()) {
+        built_in_objects.insert(built_in_function);
+    }
+    for (auto &name : node->get_global_names()) {
+        auto it = built_in_objects.find(name);
+        program->add_global(name, it != built_in_objects.end() ? it->second : Value());
+    }
+
+    functions.emplace_back(main_function, true);
+    for (auto &statement : *node->get_statements()) {
+        compile_statement(statement);
+    }
+    emit(OP_RETURN_VOID, 0, 0, 0, node);
+    functions.pop_back();
+
+    return -1;
+}
+
+int CompilerVisitor::visit(BinOpNode *node, int dest) {
+    int left = compile_left_operand(node->get_left_node(), node->get_right_node());
+    int right = node->get_right_node()->compile(this, -1);
+    int target = target_register(dest);
+
+    emit(binary_opcode(node->get_binary_operator()), target, left, right, node);
+    return target;
+}
+
+int CompilerVisitor::visit(CastOpNode *node, int dest) {
+    int operand = node->get_operand()->compile(this, -1);
+    int target = target_register(dest);
+
+    emit(OP_CAST, target, operand, node->get_type(), node);
+    return target;
+}
+
+int CompilerVisitor::visit(SubscriptOpNode *node, int dest) {
+    int identifier = compile_left_operand(node->get_identifier(), node->get_index());
+    int index = node->get_index()->compile(this, -1);
+    int target = target_register(dest);
+
+    emit(OP_SUBSCRIPT, target, identifier, index, node);
+    return target;
+}
+
+int CompilerVisitor::visit(SliceOpNode *node, int dest) {
+    // The bounds are evaluated into consecutive registers, so the array is copied out of its
+    // variable if either of them could assign to it
+    ASTNode *assigning_bound =
+        contains_assignment(node->get_start()) ? node->get_start() : node->get_end();
+    int identifier = compile_left_operand(node->get_identifier(), assigning_bound);
+
+    int bounds = allocate_registers(2);
+    node->get_start()->compile(this, bounds);
+    node->get_end()->compile(this, bounds + 1);
+    int target = target_register(dest);
+
+    emit(OP_SLICE, target, identifier, bounds, node);
+    return target;
+}
+
+int CompilerVisitor::visit(UnaryOpNode *node, int dest) {
+    int operand = node->get_operand()->compile(this, -1);
+    int target = target_register(dest);
+
+    emit(unary_opcode(node->get_unary_operator()), target, operand, 0, node);
+    return target;
+}
+
+int CompilerVisitor::visit(ArrayLiteralNode *node, int dest) {
+    // The elements are evaluated into consecutive registers
+    int count = (int)node->get_values()->size();
+    int base = allocate_registers(count);
+    for (int i = 0; i < count; i++) {
+        node->get_values()->at(i)->compile(this, base + i);
+    }
+
+    int target = target_register(dest);
+    emit(OP_NEW_ARRAY, target, base, count, node);
+    return target;
+}
+
+int CompilerVisitor::visit(RangeLiteralNode *node, int dest) {
+    int start = compile_left_operand(node->get_start(), node->get_end());
+    int end = node->get_end()->compile(this, -1);
+
+    // Both bounds are evaluated before either of them is checked
+    emit(OP_CHECK_TYPE, start, type_bit(TYPE_INT), CHECK_RANGE_START, node->get_start());
+    emit(OP_CHECK_TYPE, end, type_bit(TYPE_INT), CHECK_RANGE_END, node->get_end());
+
+    int target = target_register(dest);
+    emit(OP_NEW_RANGE, target, start, end, node);
+    return target;
+}
+
+int CompilerVisitor::visit(AssignmentNode *node, int dest) {
+    ASTNode *value_node = node->get_value();
+    bool check_void = can_be_void(value_node);
+
+    // Assign to an element of an array
+    if (node->get_identifier()->get_node_type() == NodeType::SUBSCRIPT_OP_NODE) {
+        auto *left = static_cast<SubscriptOpNode *>(node->get_identifier());
+
+        int value = value_node->compile(this, dest);
+        if (check_void) {
+            emit(OP_CHECK_ASSIGN, value, 0, 0, node);
+        }
+
+        int identifier = compile_left_operand(left->get_identifier(), left->get_index());
+        int index = left->get_index()->compile(this, -1);
+        emit(OP_SUBSCRIPT_STORE, identifier, index, value, left);
+        return value;
+    }
+
+    if (node->get_identifier()->get_node_type() != NodeType::IDENTIFIER_NODE) {
+        return value_node->compile(this, dest);
+    }
+
+    const VariableSlot &slot = node->get_slot();
+
+    // Update or declare a global variable
+    if (slot.is_global()) {
+        int value = value_node->compile(this, dest);
+        if (check_void) {
+            emit(OP_CHECK_ASSIGN, value, 0, 0, node);
+        }
+
+        emit(OP_STORE_GLOBAL, value, slot.slot, 0, node);
+        return value;
+    }
+
+    // Update a variable of an enclosing block
+    if (Variable *variable = find_variable(slot)) {
+        if (variable->kind == Variable::LOCAL) {
+            int value = value_node->compile(this, variable->reg);
+            if (check_void) {
+                emit(OP_CHECK_ASSIGN, value, 0, 0, node);
+            }
+            return move_to(value, dest, node);
+        }
+
+        Variable dynamic = *variable;
+        int value = value_node->compile(this, dest);
+        if (check_void) {
+            emit(OP_CHECK_ASSIGN, value, 0, 0, node);
+        }
+        emit(OP_STORE_DYNAMIC, value, dynamic.reg, dynamic.global, node);
+        return value;
+    }
+
+    // Declare a variable in the current block. The variable is only visible once it is assigned.
+    int reg = allocate_local();
+    if (slot.has_global_fallback()) {
+        // The global may be declared before the function is called
+        int value = value_node->compile(this, -1);
+        if (check_void) {
+            emit(OP_CHECK_ASSIGN, value, 0, 0, node);
+        }
+
+        emit(OP_CLEAR, reg, 0, 0, node);
+        emit(OP_STORE_DYNAMIC, value, reg, slot.global_slot, node);
+        declare_variable(slot.slot, {Variable::DYNAMIC, reg, slot.global_slot});
+        return move_to(value, dest, node);
+    }
+
+    int value = value_node->compile(this, reg);
+    if (check_void) {
+        emit(OP_CHECK_ASSIGN, value, 0, 0, node);
+    }
+    declare_variable(slot.slot, {Variable::LOCAL, reg, -1});
+    return move_to(value, dest, node);
+}
+
+int CompilerVisitor::visit(BreakStatementNode *node, int dest) {
+    FunctionState &state = current();
+    if (!state.loops.empty()) {
+        state.loops.back().break_jumps.push_back(emit(OP_JUMP, -1, 0, 0, node));
+    }
+
+    return -1;
+}
+
+int CompilerVisitor::visit(ContinueStatementNode *node, int dest) {
+    FunctionState &state = current();
+    if (!state.loops.empty()) {
+        emit(OP_JUMP, state.loops.back().continue_target, 0, 0, node);
+    }
+
+    return -1;
+}
+
+int CompilerVisitor::visit(ReturnStatementNode *node, int dest) {
+    if (node->has_value()) {
+        int value = node->get_value()->compile(this, -1);
+        emit(OP_RETURN, value, 0, 0, node);
+    } else {
+        emit(OP_RETURN_VOID, 0, 0, 0, node);
+    }
+
+    return -1;
+}
+
+int CompilerVisitor::visit(ForStatementNode *node, int dest) {
+    // The iterable, the current index and the number of iterations live in three hidden registers
+    int base = allocate_registers(3);
+    node->get_iterable()->compile(this, base);
+    emit(OP_CHECK_TYPE,
+         base,
+         type_bit(TYPE_ARRAY) | type_bit(TYPE_STRING) | type_bit(TYPE_FILE),
+         CHECK_FOR_ITERABLE,
+         node->get_iterable());
+    emit(OP_FOR_START, base, 0, 0, node);
+
+    // The loop variable is the first slot of the scope of the loop
+    push_scope();
+    int iterator = allocate_local();
+    declare_variable(0, {Variable::LOCAL, iterator, -1});
+
+    int loop_start = emit(OP_FOR_NEXT, base, iterator, -1, node);
+    current().loops.push_back({loop_start, {}});
+    compile_statement(node->get_body());
+    emit(OP_JUMP, loop_start, 0, 0, node);
+
+    current().function->patch_jump(loop_start, current().function->get_code_size());
+    pop_loop();
+    pop_scope();
+
+    return -1;
+}
+
+int CompilerVisitor::visit(IfStatementNode *node, int dest) {
+    // The condition is evaluated in the scope of the if statement
+    push_scope();
+
+    int condition = node->get_condition()->compile(this, -1);
+    int jump_to_else =
+        emit(OP_JUMP_IF_FALSE, condition, -1, CHECK_IF_CONDITION, node->get_condition());
+    compile_statement(node->get_if_body());
+
+    BytecodeFunction *function = current().function;
+    if (node->get_else_body() != nullptr) {
+        int jump_to_end = emit(OP_JUMP, -1, 0, 0, node);
+        function->patch_jump(jump_to_else, function->get_code_size());
+        compile_statement(node->get_else_body());
+        function->patch_jump(jump_to_end, function->get_code_size());
+    } else {
+        function->patch_jump(jump_to_else, function->get_code_size());
+    }
+
+    pop_scope();
+    return -1;
+}
+
+int CompilerVisitor::visit(RepeatStatementNode *node, int dest) {
+    // The count and the current iteration live in two hidden registers. The count is evaluated in
+    // the scope of the loop.
+    int base = allocate_registers(2);
+    push_scope();
+    node->get_count()->compile(this, base);
+    emit(OP_CHECK_TYPE, base, type_bit(TYPE_INT), CHECK_REPEAT_COUNT, node->get_count());
+    emit(OP_LOAD_CONST,
+         base + 1,
+         current().function->add_constant(Value::from_int(0)),
+         0,
+         node);
+
+    int loop_start = emit(OP_REPEAT_NEXT, base, 0, -1, node);
+    current().loops.push_back({loop_start, {}});
+    compile_statement(node->get_body());
+    emit(OP_JUMP, loop_start, 0, 0, node);
+
+    current().function->patch_jump(loop_start, current().function->get_code_size());
+    pop_loop();
+    pop_scope();
+
+    return -1;
+}
+
+int CompilerVisitor::visit(WhileStatementNode *node, int dest) {
+    // The condition is evaluated in the scope of the loop
+    push_scope();
+    int loop_start = current().function->get_code_size();
+    int mark = current().free_register;
+    int condition = node->get_condition()->compile(this, -1);
+    int exit_jump =
+        emit(OP_JUMP_IF_FALSE, condition, -1, CHECK_WHILE_CONDITION, node->get_condition());
+    current().free_register = std::max(mark, current().locals_top);
+
+    current().loops.push_back({loop_start, {}});
+    compile_statement(node->get_body());
+    emit(OP_JUMP, loop_start, 0, 0, node);
+
+    current().function->patch_jump(exit_jump, current().function->get_code_size());
+    pop_loop();
+    pop_scope();
+
+    return -1;
+}
+
+int CompilerVisitor::visit(FunctionDeclarationNode *node, int dest) {
+    BytecodeFunction *function = compile_function(node);
+
+    // The function object is created once and shared by every evaluation of the declaration
+    Value function_object(
+        std::make_shared<FunctionObject>(node->get_body(), *node->get_parameters(), function));
+
+    int target = target_register(dest);
+    emit(OP_LOAD_CONST, target, current().function->add_constant(function_object), 0, node);
+    return target;
+}
+
+int CompilerVisitor::visit(CallOpNode *node, int dest) {
+    // The function and its arguments are placed in consecutive registers
+    int arguments_size = (int)node->get_arguments_size();
+    int base = allocate_registers(1 + arguments_size);
+
+    // Calls to built-in functions were bound by semantic analysis, so they are called by id
+    int built_in_id = node->get_built_in_id();
+    if (built_in_id < 0) {
+        load_variable(node->get_slot(), node->get_identifier(), base, node);
+    }
+    for (int i = 0; i < arguments_size; i++) {
+        node->get_argument(i)->compile(this, base + 1 + i);
+    }
+
+    if (built_in_id >= 0) {
+        emit(OP_CALL_BUILT_IN, base, arguments_size, built_in_id, node);
+        return move_to(base, dest, node);
+    }
+
+    // A call in tail position is followed by the return of its result, which is only reached if
+    // the callee turns out to be a built-in function
+    int name = current().function->add_name(node->get_identifier());
+    emit(node->is_tail_call() ? OP_TAIL_CALL : OP_CALL, base, arguments_size, name, node);
+    return move_to(base, dest, node);
+}
+
+int CompilerVisitor::visit(CompoundStatementNode *node, int dest) {
+    push_scope();
+    for (auto &statement : *node->get_statements()) {
+        compile_statement(statement);
+    }
+    pop_scope();
+
+    return -1;
+}
+
+int CompilerVisitor::visit(IdentifierNode *node, int dest) {
+    return load_variable(node->get_slot(), node->get_name(), dest, node);
+}
+
+int CompilerVisitor::visit(LiteralNode *node, int dest) {
+    // Literals are converted to values once, at compile time (or already by the optimizer)
+    Value value = node->get_constant();
+    if (!node->has_constant()) {
+        value = literal_value(node);
+    }
+
+    int target = target_register(dest);
+    if (value.is_defined()) {
+        emit(OP_LOAD_CONST, target, current().function->add_constant(value), 0, node);
+    }
+    return target;
+}
+
+int CompilerVisitor::visit(ErrorNode *node, int dest) {
+    // This should never occur!
+    emit(OP_RAISE, current().function->add_name("Error node"), 0, 0, node);
+    return target_register(dest);
+}
+
+Value CompilerVisitor::literal_value(LiteralNode *node) {
+    switch (node->get_type()) {
+    case TYPE_INT:
+        try {
+            return Value::from_int(std::stoi(node->get_value()));
+        } catch (const std::out_of_range &e) {
+            int message = current().function->add_name("Integer value out of range");
+            emit(OP_RAISE, message, 0, 0, node);
+        }
+        break;
+    case TYPE_FLOAT:
+        try {
+            return Value::from_float(std::stof(node->get_value()));
+        } catch (const std::out_of_range &e) {
+            int message = current().function->add_name("Float value out of range");
+            emit(OP_RAISE, message, 0, 0, node);
+        }
+        break;
+    case TYPE_BOOL:
+        return Value::from_bool(node->get_value() == "true");
+    case TYPE_STRING:
+        return Value(StringObject::from_string_literal(node->get_value()));
+    default:
+        break;
+    }
+
+    return {};
+}
+
+void CompilerVisitor::compile_statement(ASTNode *node) {
+    // Temporaries are released after each statement, but variables declared by it are kept
+    int mark = current().free_register;
+    node->compile(this, -1);
+    current().free_register = std::max(mark, current().locals_top);
+}
+
+int CompilerVisitor::compile_left_operand(ASTNode *left, ASTNode *right) {
+    NodeType type = left->get_node_type();
+    if ((type == IDENTIFIER_NODE || type == ASSIGNMENT_NODE) && contains_assignment(right)) {
+        return left->compile(this, allocate_registers());
+    }
+
+    return left->compile(this, -1);
+}
+
+BytecodeFunction *CompilerVisitor::compile_function(FunctionDeclarationNode *node) {
+    int parameters_size = (int)node->get_parameters_size();
+    auto *function = new BytecodeFunction(parameters_size);
+    program->add_function(function);
+
+    // The parameters occupy the first registers of the call frame
+    functions.emplace_back(function, false);
+    push_scope();
+    for (int i = 0; i < parameters_size; i++) {
+        declare_variable(i, {Variable::LOCAL, allocate_local(), -1});
+    }
+
+    compile_statement(node->get_body());
+    emit(OP_RETURN_VOID, 0, 0, 0, node);
+    functions.pop_back();
+
+    return function;
+}
+
+CompilerVisitor::Variable *CompilerVisitor::find_variable(const VariableSlot &slot) {
+    // The blocks of the current function mirror the scopes of semantic analysis
+    std::vector<Scope> &scopes = current().scopes;
+    if (slot.depth >= (int)scopes.size()) {
+        return nullptr;
+    }
+
+    std::vector<Variable> &variables = scopes[scopes.size() - 1 - slot.depth].variables;
+    if (slot.slot >= (int)variables.size() || variables[slot.slot].reg < 0) {
+        return nullptr;
+    }
+
+    return &variables[slot.slot];
+}
+
+void CompilerVisitor::declare_variable(int slot, const Variable &variable) {
+    std::vector<Variable> &variables = current().scopes.back().variables;
+    if (slot >= (int)variables.size()) {
+        variables.resize(slot + 1, {Variable::LOCAL, -1, -1});
+    }
+
+    variables[slot] = variable;
+}
+
+int CompilerVisitor::load_variable(const VariableSlot &slot,
+                                   const std::string &name,
+                                   int dest,
+                                   ASTNode *node) {
+    if (slot.is_resolved() && slot.is_global()) {
+        int target = target_register(dest);
+        emit(OP_LOAD_GLOBAL, target, slot.slot, 0, node);
+        return target;
+    }
+
+    // The variable is not declared, or is read before it is first assigned
+    Variable *variable = slot.is_resolved() ? find_variable(slot) : nullptr;
+    if (variable == nullptr) {
+        int message = current().function->add_name("Undeclared identifier '" + name + "'");
+        emit(OP_RAISE, message, 0, 0, node);
+        return target_register(dest);
+    }
+
+    if (variable->kind == Variable::LOCAL) {
+        return move_to(variable->reg, dest, node);
+    }
+
+    int target = target_register(dest);
+    emit(OP_LOAD_DYNAMIC, target, variable->reg, variable->global, node);
+    return target;
+}
+
+int CompilerVisitor::emit(OpCode op, int a, int b, int c, ASTNode *node) {
+    return current().function->emit({op, a, b, c}, node->get_line(), node->get_column());
+}
+
+int CompilerVisitor::allocate_registers(int count) {
+    FunctionState &state = current();
+    int first = state.free_register;
+    state.free_register += count;
+    state.function->reserve_registers(state.free_register);
+    return first;
+}
+
+int CompilerVisitor::allocate_local() {
+    int reg = allocate_registers();
+    current().locals_top = current().free_register;
+    return reg;
+}
+
+int CompilerVisitor::target_register(int dest) {
+    return dest >= 0 ? dest : allocate_registers();
+}
+
+int CompilerVisitor::move_to(int reg, int dest, ASTNode *node) {
+    if (dest < 0 || dest == reg) {
+        return reg;
+    }
+
+    emit(OP_MOVE, dest, reg, 0, node);
+    return dest;
+}
+
+void CompilerVisitor::push_scope() {
+    FunctionState &state = current();
+    state.scopes.push_back({{}, state.free_register, state.locals_top});
+}
+
+void CompilerVisitor::pop_scope() {
+    FunctionState &state = current();
+    state.free_register = state.scopes.back().start_register;
+    state.locals_top = state.scopes.back().start_locals_top;
+    state.scopes.pop_back();
+}
+
+void CompilerVisitor::pop_loop() {
+    FunctionState &state = current();
+    int loop_end = state.function->get_code_size();
+    for (int jump : state.loops.back().break_jumps) {
+        state.function->patch_jump(jump, loop_end);
+    }
+    state.loops.pop_back();
+}
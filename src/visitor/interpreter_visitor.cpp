@@ -2,46 +2,185 @@
 #include "AST/AST_nodes.h"
 #include "built_in_functions.h"
 #include "object/array_object.h"
-#include "object/bool_object.h"
-#include "object/float_object.h"
 #include "object/function_object.h"
-#include "object/int_object.h"
 #include "object/string_object.h"
-#include "object/void_object.h"
 #include "operators.h"
+#include <climits>
 #include <stdexcept>
+#include <string_view>
+
+namespace {
+/**
+ * @brief Compare two strings inline, for a node quickened to string comparisons.
+ * @param op The operator, which must be a comparison.
+ * @param a The left operand.
+ * @param b The right operand.
+ * @return The result of the comparison.
+ */
+inline Value compare_strings(BinaryOperator op, std::string_view a, std::string_view b) {
+    switch (op) {
+    case BINARY_LESS_THAN:
+        return Value::from_bool(a < b);
+    case BINARY_LESS_THAN_EQUAL:
+        return Value::from_bool(a <= b);
+    case BINARY_GREATER_THAN:
+        return Value::from_bool(a > b);
+    case BINARY_GREATER_THAN_EQUAL:
+        return Value::from_bool(a >= b);
+    case BINARY_EQUAL:
+        return Value::from_bool(a == b);
+    default:
+        return Value::from_bool(a != b);
+    }
+}
+
+/**
+ * @brief Quicken a binary operator node for the types of its first operands, or deoptimize it if
+ * it has already been quickened for other types.
+ * @param node The node.
+ * @param left The type of the left operand.
+ * @param right The type of the right operand.
+ */
+void quicken(BinOpNode *node, Type left, Type right) {
+    TypeFeedback &feedback = node->get_feedback();
+    if (feedback.state != QUICK_UNINITIALIZED) {
+        feedback.deoptimize();
+        return;
+    }
+
+    BinaryOperator op = node->get_binary_operator();
+    Quickening state = QUICK_MONOMORPHIC;
+    if (left == TYPE_INT && right == TYPE_INT) {
+        state = QUICK_INT;
+    } else if (left == TYPE_FLOAT && right == TYPE_FLOAT) {
+        state = QUICK_FLOAT;
+    } else if (left == TYPE_STRING && right == TYPE_STRING && op >= BINARY_LESS_THAN) {
+        state = QUICK_STRING;
+    }
+
+    feedback.quicken(state, left, right);
+    node->set_kernel(get_binary_kernel(op, left, right));
+}
+
+/**
+ * @brief Quicken a cast node for the type of its first operand, or deoptimize it.
+ * @param node The node.
+ * @param type The type of the operand.
+ */
+void quicken(CastOpNode *node, Type type) {
+    TypeFeedback &feedback = node->get_feedback();
+    bool is_number_cast = node->get_type() == TYPE_INT || node->get_type() == TYPE_FLOAT;
+    if (feedback.state != QUICK_UNINITIALIZED || !is_number_cast) {
+        feedback.deoptimize();
+    } else if (type == TYPE_INT) {
+        feedback.quicken(QUICK_INT, type);
+    } else if (type == TYPE_FLOAT) {
+        feedback.quicken(QUICK_FLOAT, type);
+    } else {
+        feedback.deoptimize();
+    }
+}
+
+/**
+ * @brief Quicken a subscript node for an array and an int index, or deoptimize it.
+ * @param node The node.
+ * @param type The type of the subscripted value.
+ * @param index The type of the index.
+ */
+void quicken(SubscriptOpNode *node, Type type, Type index) {
+    TypeFeedback &feedback = node->get_feedback();
+    if (feedback.state == QUICK_UNINITIALIZED && type == TYPE_ARRAY && index == TYPE_INT) {
+        feedback.quicken(QUICK_ARRAY_INT, type, index);
+    } else {
+        feedback.deoptimize();
+    }
+}
+} // namespace
 
 InterpreterVisitor::InterpreterVisitor(ProgramNode *program_node, ErrorManager *error_manager)
     : program_node(program_node), error_manager(error_manager), built_in_functions(error_manager) {}
 
 void InterpreterVisitor::interpret() {
-    program_node->evaluate(this, nullptr);
+    // Deep recursion runs on a stack of its own, rather than on the stack of the calling thread
+    CallStack stack(max_call_depth);
+    call_stack = &stack;
+    stack.run([this]() { program_node->evaluate(this, nullptr); });
+    call_stack = nullptr;
+
+    built_in_functions.flush();
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(ProgramNode *node, SymbolTable *table) {
+Value InterpreterVisitor::visit(ProgramNode *node, SymbolTable *table) {
     // Create symbol table for the global scope
     auto *global_table = new SymbolTable(nullptr, false, false);
 
     built_in_functions.register_built_in_functions(global_table);
 
+    if (profiler) {
+        profiler->enter_function(Profiler::MAIN_FUNCTION);
+    }
+
     for (auto &statement : *node->get_statements()) {
-        statement->evaluate(this, global_table);
+        if (profiler) {
+            evaluate_profiled_statement(statement, global_table);
+        } else {
+            statement->evaluate(this, global_table);
+        }
+    }
+
+    if (profiler) {
+        profiler->exit_function();
     }
 
     delete global_table;
-    return nullptr;
+    return {};
+}
+
+void InterpreterVisitor::evaluate_profiled_statement(ASTNode *statement, SymbolTable *table) {
+    profiler->enter_line(statement->get_line());
+    statement->evaluate(this, table);
+    profiler->exit_line();
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(BinOpNode *node, SymbolTable *table) {
-    std::shared_ptr<Object> left = node->get_left_node()->evaluate(this, table);
-    std::shared_ptr<Object> right = node->get_right_node()->evaluate(this, table);
-    std::shared_ptr<Object> result = get_binary_op_function(node->get_op())(left, right);
+Value InterpreterVisitor::visit(BinOpNode *node, SymbolTable *table) {
+    check_stack(node);
+    Value left = node->get_left_node()->evaluate(this, table);
+    Value right = node->get_right_node()->evaluate(this, table);
+    BinaryOperator op = node->get_binary_operator();
+    TypeFeedback &feedback = node->get_feedback();
+    Value result;
+
+    // A quickened node only takes its specialization if the operands pass the guard on their types
+    if (feedback.matches(left.get_type(), right.get_type())) {
+        switch (feedback.state) {
+        case QUICK_INT:
+            result = apply_int_operator(op, left.get_int(), right.get_int());
+            break;
+        case QUICK_FLOAT:
+            result = apply_float_operator(op, left.get_float(), right.get_float());
+            break;
+        case QUICK_STRING:
+            result = compare_strings(op,
+                                     left.as<StringObject>()->get_value(),
+                                     right.as<StringObject>()->get_value());
+            break;
+        case QUICK_MONOMORPHIC:
+            result = node->get_kernel()(left, right);
+            break;
+        default:
+            result = apply_binary_operator(op, left, right);
+            break;
+        }
+    } else {
+        quicken(node, left.get_type(), right.get_type());
+        result = apply_binary_operator(op, left, right);
+    }
 
-    // nullptr result indicates an invalid operation
-    if (result == nullptr) {
+    // An undefined result indicates an invalid operation
+    if (!result.is_defined()) {
         runtime_error("Invalid operands to binary operator " + token_values[node->get_op()] + " (" +
-                          type_to_string(left->get_type()) + " and " +
-                          type_to_string(right->get_type()) + ")",
+                          type_to_string(left.get_type()) + " and " +
+                          type_to_string(right.get_type()) + ")",
                       node->get_line(),
                       node->get_column());
     }
@@ -49,13 +188,34 @@ std::shared_ptr<Object> InterpreterVisitor::visit(BinOpNode *node, SymbolTable *
     return result;
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(CastOpNode *node, SymbolTable *table) {
-    std::shared_ptr<Object> operand = node->get_operand()->evaluate(this, table);
-    std::shared_ptr<Object> result = operand->cast(node->get_type());
+Value InterpreterVisitor::visit(CastOpNode *node, SymbolTable *table) {
+    check_stack(node);
+    Value operand = node->get_operand()->evaluate(this, table);
+    TypeFeedback &feedback = node->get_feedback();
+    Value result;
+
+    if (feedback.matches(operand.get_type())) {
+        switch (feedback.state) {
+        case QUICK_INT:
+            result = node->get_type() == TYPE_FLOAT ? Value::from_float((float)operand.get_int())
+                                                    : operand;
+            break;
+        case QUICK_FLOAT:
+            result = node->get_type() == TYPE_INT ? Value::from_int((int)operand.get_float())
+                                                  : operand;
+            break;
+        default:
+            result = operand.cast(node->get_type());
+            break;
+        }
+    } else {
+        quicken(node, operand.get_type());
+        result = operand.cast(node->get_type());
+    }
 
-    // nullptr result indicates an invalid operation
-    if (result == nullptr) {
-        runtime_error("Invalid cast from " + type_to_string(operand->get_type()) + " to " +
+    // An undefined result indicates an invalid operation
+    if (!result.is_defined()) {
+        runtime_error("Invalid cast from " + type_to_string(operand.get_type()) + " to " +
                           type_to_string(node->get_type()),
                       node->get_line(),
                       node->get_column());
@@ -64,14 +224,46 @@ std::shared_ptr<Object> InterpreterVisitor::visit(CastOpNode *node, SymbolTable
     return result;
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(SubscriptOpNode *node, SymbolTable *table) {
-    std::shared_ptr<Object> identifier = node->get_identifier()->evaluate(this, table);
-    std::shared_ptr<Object> index = node->get_index()->evaluate(this, table);
-    std::shared_ptr<Object> result = identifier->subscript(index);
+Value InterpreterVisitor::visit(SubscriptOpNode *node, SymbolTable *table) {
+    check_stack(node);
+    Value identifier = node->get_identifier()->evaluate(this, table);
+    Value index = node->get_index()->evaluate(this, table);
+    TypeFeedback &feedback = node->get_feedback();
+    Value result;
+
+    if (feedback.matches(identifier.get_type(), index.get_type()) &&
+        feedback.state == QUICK_ARRAY_INT) {
+        // Read the element directly, rather than through the subscript operation of the object
+        auto *array = identifier.as<ArrayObject>();
+        int i = index.get_int();
+        if (i >= 0 && i < array->get_len()) {
+            result = array->get_element(i);
+        }
+    } else {
+        quicken(node, identifier.get_type(), index.get_type());
+        result = identifier.subscript(index);
+    }
+
+    // An undefined result indicates an invalid operation
+    if (!result.is_defined()) {
+        runtime_error("Invalid subscript operation on " + type_to_string(identifier.get_type()),
+                      node->get_line(),
+                      node->get_column());
+    }
+
+    return result;
+}
+
+Value InterpreterVisitor::visit(SliceOpNode *node, SymbolTable *table) {
+    check_stack(node);
+    Value identifier = node->get_identifier()->evaluate(this, table);
+    Value start = node->get_start()->evaluate(this, table);
+    Value end = node->get_end()->evaluate(this, table);
+    Value result = identifier.slice(start, end);
 
-    // nullptr result indicates an invalid operation
-    if (result == nullptr) {
-        runtime_error("Invalid subscript operation on " + type_to_string(identifier->get_type()),
+    // An undefined result indicates an invalid operation
+    if (!result.is_defined()) {
+        runtime_error("Invalid slice operation on " + type_to_string(identifier.get_type()),
                       node->get_line(),
                       node->get_column());
     }
@@ -79,14 +271,15 @@ std::shared_ptr<Object> InterpreterVisitor::visit(SubscriptOpNode *node, SymbolT
     return result;
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(UnaryOpNode *node, SymbolTable *table) {
-    std::shared_ptr<Object> operand = node->get_operand()->evaluate(this, table);
-    std::shared_ptr<Object> result = get_unary_op_function(node->get_op())(operand);
+Value InterpreterVisitor::visit(UnaryOpNode *node, SymbolTable *table) {
+    check_stack(node);
+    Value operand = node->get_operand()->evaluate(this, table);
+    Value result = apply_unary_operator(node->get_unary_operator(), operand);
 
-    // nullptr result indicates an invalid operation
-    if (result == nullptr) {
+    // An undefined result indicates an invalid operation
+    if (!result.is_defined()) {
         runtime_error("Invalid operand to unary operator " + token_values[node->get_op()] + " (" +
-                          type_to_string(operand->get_type()) + ")",
+                          type_to_string(operand.get_type()) + ")",
                       node->get_line(),
                       node->get_column());
     }
@@ -94,59 +287,53 @@ std::shared_ptr<Object> InterpreterVisitor::visit(UnaryOpNode *node, SymbolTable
     return result;
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(ArrayLiteralNode *node, SymbolTable *table) {
+Value InterpreterVisitor::visit(ArrayLiteralNode *node, SymbolTable *table) {
+    check_stack(node);
+
     // Create an array object from the values
-    std::vector<std::shared_ptr<Object>> values;
+    std::vector<Value> values;
     for (auto &element : *node->get_values()) {
         values.push_back(element->evaluate(this, table));
     }
 
-    return std::make_shared<ArrayObject>(values);
+    return Value(std::make_shared<ArrayObject>(std::move(values)));
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(RangeLiteralNode *node, SymbolTable *table) {
-    std::shared_ptr<Object> start = node->get_start()->evaluate(this, table);
-    std::shared_ptr<Object> end = node->get_end()->evaluate(this, table);
+Value InterpreterVisitor::visit(RangeLiteralNode *node, SymbolTable *table) {
+    check_stack(node);
+    Value start = node->get_start()->evaluate(this, table);
+    Value end = node->get_end()->evaluate(this, table);
 
     // The start value must be an integer
-    if (start->get_type() != TYPE_INT) {
+    if (start.get_type() != TYPE_INT) {
         runtime_error("Invalid type for start of range (expected int, got " +
-                          type_to_string(start->get_type()) + ")",
+                          type_to_string(start.get_type()) + ")",
                       node->get_start()->get_line(),
                       node->get_start()->get_column());
     }
     // The end value must be an integer
-    else if (end->get_type() != TYPE_INT) {
+    else if (end.get_type() != TYPE_INT) {
         runtime_error("Invalid type for end of range (expected int, got " +
-                          type_to_string(start->get_type()) + ")",
+                          type_to_string(end.get_type()) + ")",
                       node->get_end()->get_line(),
                       node->get_end()->get_column());
     }
 
-    int start_val = std::static_pointer_cast<IntObject>(start)->get_value();
-    int end_val = std::static_pointer_cast<IntObject>(end)->get_value();
-    std::vector<std::shared_ptr<Object>> values;
-
-    // Iterate from start to end (inclusive of both) and add each value to the array
-    int dir = (start_val < end_val) ? 1 : -1;
-    bool last_equal = false;
-    int cur_val = start_val;
-
-    // Iterate and add values
-    while (!last_equal) {
-        last_equal = cur_val == end_val;
-        values.push_back(std::make_shared<IntObject>(cur_val));
-        cur_val += dir;
+    // The elements of the range are only created if the array is modified
+    auto range = ArrayObject::from_range(start.get_int(), end.get_int());
+    if (!range) {
+        runtime_error("Range too long (more than " + std::to_string(INT_MAX) + " elements)",
+                      node->get_line(),
+                      node->get_column());
     }
-
-    return std::make_shared<ArrayObject>(values);
+    return Value(std::move(range));
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(AssignmentNode *node, SymbolTable *table) {
-    std::shared_ptr<Object> value = node->get_value()->evaluate(this, table);
+Value InterpreterVisitor::visit(AssignmentNode *node, SymbolTable *table) {
+    Value value = node->get_value()->evaluate(this, table);
 
     // Cannot assign to void
-    if (value->get_type() == TYPE_VOID) {
+    if (value.get_type() == TYPE_VOID) {
         runtime_error("Invalid assignment to void", node->get_line(), node->get_column());
     }
 
@@ -154,179 +341,179 @@ std::shared_ptr<Object> InterpreterVisitor::visit(AssignmentNode *node, SymbolTa
     if (node->get_identifier()->get_node_type() == NodeType::SUBSCRIPT_OP_NODE) {
         // Evaluate the expression on the left
         auto *left = static_cast<SubscriptOpNode *>(node->get_identifier());
-        std::shared_ptr<ArrayObject> identifier =
-            std::static_pointer_cast<ArrayObject>(left->get_identifier()->evaluate(this, table));
-
-        // Update the value at the index
-        std::shared_ptr<Object> index = left->get_index()->evaluate(this, table);
-        identifier->subscript_update(index, value);
+        Value identifier = left->get_identifier()->evaluate(this, table);
+
+        // Update the value at the index (only arrays can be updated, within their bounds)
+        Value index = left->get_index()->evaluate(this, table);
+        if (identifier.get_type() != TYPE_ARRAY ||
+            !identifier.as<ArrayObject>()->subscript_update(index, value).is_defined()) {
+            runtime_error("Invalid subscript operation on " + type_to_string(identifier.get_type()),
+                          left->get_line(),
+                          left->get_column());
+        }
     }
     // If the identifier is just an identifier
     else if (node->get_identifier()->get_node_type() == NodeType::IDENTIFIER_NODE) {
-        auto identifier_node = static_cast<IdentifierNode *>(node->get_identifier());
-        std::string name = identifier_node->get_name();
-
-        if (table->contains(name, false)) {
-            // Update the value of the existing symbol
-            Symbol *symbol = table->get(name, false);
-            symbol->set_value(value);
-        } else {
-            // Create a new symbol with the value
-            Symbol symbol(name, value);
-            table->insert(symbol);
-        }
+        // Update the variable (declaring it if this is its first assignment)
+        table->store(node->get_slot(), value);
     }
 
     return value;
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(BreakStatementNode *node, SymbolTable *table) {
+Value InterpreterVisitor::visit(BreakStatementNode *node, SymbolTable *table) {
     backtracking = true;
     breaking = true;
 
-    return nullptr;
+    return {};
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(ContinueStatementNode *node, SymbolTable *table) {
+Value InterpreterVisitor::visit(ContinueStatementNode *node, SymbolTable *table) {
     backtracking = true;
 
-    return nullptr;
+    return {};
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(ReturnStatementNode *node, SymbolTable *table) {
+Value InterpreterVisitor::visit(ReturnStatementNode *node, SymbolTable *table) {
     // Evaluate the return value
     if (node->has_value()) {
-        return_values.top() = node->get_value()->evaluate(this, table);
+        return_value = node->get_value()->evaluate(this, table);
     }
     // No return value, so return void
     else {
-        return_values.top() = std::make_shared<VoidObject>();
+        return_value = Value::make_void();
     }
 
     returning = true;
 
-    return nullptr;
+    return {};
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(ForStatementNode *node, SymbolTable *table) {
-    std::string identifier = node->get_identifier();
-
-    std::shared_ptr<Object> iterable = node->get_iterable()->evaluate(this, table);
-    int iterable_len = 0;
+Value InterpreterVisitor::visit(ForStatementNode *node, SymbolTable *table) {
+    Value iterable = node->get_iterable()->evaluate(this, table);
 
-    // Iterate through an array
-    if (iterable->get_type() == TYPE_ARRAY) {
-        iterable_len = (int)std::static_pointer_cast<ArrayObject>(iterable)->get_value()->size();
-    }
-    // Iterate through a string
-    else if (iterable->get_type() == TYPE_STRING) {
-        iterable_len = (int)std::static_pointer_cast<StringObject>(iterable)->get_value().size();
-    } else {
-        runtime_error("Invalid type for iterable (expected array or string, got " +
-                          type_to_string(iterable->get_type()) + ")",
+    // Only arrays, strings and files can be iterated through
+    Type iterable_type = iterable.get_type();
+    if (iterable_type != TYPE_ARRAY && iterable_type != TYPE_STRING && iterable_type != TYPE_FILE) {
+        runtime_error("Invalid type for iterable (expected array, string or file, got " +
+                          type_to_string(iterable.get_type()) + ")",
                       node->get_iterable()->get_line(),
                       node->get_iterable()->get_column());
     }
 
-    // Create a new scope for the for loop
-    auto *for_loop_table = new SymbolTable(table, true, table->is_function());
-    for_loop_table->insert(Symbol(identifier));
+    // Create a new scope for the for loop (the iterator is its first slot)
+    PooledScope for_loop_scope(&scope_pool, table, true, table->is_function());
+    SymbolTable *for_loop_table = for_loop_scope.get();
 
-    for (int i = 0; i < iterable_len; i++) {
-        // Handle breaking
-        if (backtracking || returning) {
+    // The number of iterations is fixed when the loop starts
+    Object *iterable_object = iterable.get_object();
+    int iteration_len = iterable_object->get_iteration_len();
+    Value element;
+    for (int i = 0; i < iteration_len && iterable_object->iterate(i, element); i++) {
+        // Set the value of the iterator
+        for_loop_table->set_slot(0, std::move(element));
+
+        node->get_body()->evaluate(this, for_loop_table);
+
+        // Handle breaking, continuing and returning
+        if (returning) {
+            break;
+        } else if (backtracking) {
             backtracking = false;
             if (breaking) {
                 breaking = false;
                 break;
             }
         }
-
-        // Set the value of the iterator
-        Symbol *iterator_symbol = for_loop_table->get(identifier, false);
-        iterator_symbol->set_value(iterable->subscript(std::make_shared<IntObject>(i)));
-
-        node->get_body()->evaluate(this, for_loop_table);
     }
 
-    return nullptr;
+    return {};
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(IfStatementNode *node, SymbolTable *table) {
+Value InterpreterVisitor::visit(IfStatementNode *node, SymbolTable *table) {
     // Create a new scope for the if statement
-    SymbolTable *if_statement_table =
-        new SymbolTable(table, table->is_loop(), table->is_function());
+    PooledScope if_statement_scope(&scope_pool, table, table->is_loop(), table->is_function());
+    SymbolTable *if_statement_table = if_statement_scope.get();
 
-    std::shared_ptr<Object> condition = node->get_condition()->evaluate(this, if_statement_table);
+    Value condition = node->get_condition()->evaluate(this, if_statement_table);
 
     // The condition must be a boolean
-    if (condition->get_type() != TYPE_BOOL) {
+    if (condition.get_type() != TYPE_BOOL) {
         runtime_error("Invalid type for if condition (expected bool, got " +
-                          type_to_string(condition->get_type()) + ")",
+                          type_to_string(condition.get_type()) + ")",
                       node->get_condition()->get_line(),
                       node->get_condition()->get_column());
     }
     // If condition, then evaluate the if body
-    else if (std::static_pointer_cast<BoolObject>(condition)->get_value()) {
+    else if (condition.get_bool()) {
         node->get_if_body()->evaluate(this, if_statement_table);
-        return nullptr;
+        return {};
     }
     // Else, evaluate the else body (if it exists)
     else if (node->get_else_body() != nullptr) {
         node->get_else_body()->evaluate(this, if_statement_table);
-        return nullptr;
+        return {};
     }
 
-    return nullptr;
+    return {};
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(RepeatStatementNode *node, SymbolTable *table) {
+Value InterpreterVisitor::visit(RepeatStatementNode *node, SymbolTable *table) {
     // Create a new scope for the repeat loop
-    auto *repeat_loop_table = new SymbolTable(table, true, table->is_function());
+    PooledScope repeat_loop_scope(&scope_pool, table, true, table->is_function());
+    SymbolTable *repeat_loop_table = repeat_loop_scope.get();
 
     // Count must be an integer
-    std::shared_ptr<Object> count = node->get_count()->evaluate(this, table);
-    if (count->get_type() != TYPE_INT) {
+    Value count = node->get_count()->evaluate(this, repeat_loop_table);
+    if (count.get_type() != TYPE_INT) {
         runtime_error("Invalid type for repeat count (expected int, got " +
-                          type_to_string(count->get_type()) + ")",
+                          type_to_string(count.get_type()) + ")",
                       node->get_count()->get_line(),
                       node->get_count()->get_column());
     }
 
     // Repeat the body `count` times
-    for (int i = 0; i < std::static_pointer_cast<IntObject>(count)->get_value(); i++) {
-        // Handle breaking
-        if (backtracking || returning) {
+    for (int i = 0; i < count.get_int(); i++) {
+        node->get_body()->evaluate(this, repeat_loop_table);
+
+        // Handle breaking, continuing and returning
+        if (returning) {
+            break;
+        } else if (backtracking) {
             backtracking = false;
             if (breaking) {
                 breaking = false;
                 break;
             }
         }
-
-        node->get_body()->evaluate(this, repeat_loop_table);
     }
 
-    return nullptr;
+    return {};
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(WhileStatementNode *node, SymbolTable *table) {
+Value InterpreterVisitor::visit(WhileStatementNode *node, SymbolTable *table) {
     // Create a new scope for the while loop
-    auto *while_loop_table = new SymbolTable(table, true, table->is_function());
+    PooledScope while_loop_scope(&scope_pool, table, true, table->is_function());
+    SymbolTable *while_loop_table = while_loop_scope.get();
 
     // The condition must be a boolean
-    std::shared_ptr<Object> condition = node->get_condition()->evaluate(this, table);
-    if (condition->get_type() != TYPE_BOOL) {
+    Value condition = node->get_condition()->evaluate(this, while_loop_table);
+    if (condition.get_type() != TYPE_BOOL) {
         runtime_error("Invalid type for while condition (expected bool, got " +
-                          type_to_string(condition->get_type()) + ")",
+                          type_to_string(condition.get_type()) + ")",
                       node->get_condition()->get_line(),
                       node->get_condition()->get_column());
     }
 
     // While the condition is true, evaluate the body
-    while (std::static_pointer_cast<BoolObject>(condition)->get_value()) {
-        // Handle breaking
-        if (backtracking || returning) {
+    while (condition.get_bool()) {
+        // Evalulate the body
+        node->get_body()->evaluate(this, while_loop_table);
+
+        // Handle breaking, continuing and returning
+        if (returning) {
+            break;
+        } else if (backtracking) {
             backtracking = false;
             if (breaking) {
                 breaking = false;
@@ -334,40 +521,46 @@ std::shared_ptr<Object> InterpreterVisitor::visit(WhileStatementNode *node, Symb
             }
         }
 
-        // Evalulate the body
-        node->get_body()->evaluate(this, while_loop_table);
-
         // Update the condition
-        condition = node->get_condition()->evaluate(this, table);
-        if (condition->get_type() != TYPE_BOOL) {
+        condition = node->get_condition()->evaluate(this, while_loop_table);
+        if (condition.get_type() != TYPE_BOOL) {
             runtime_error("Invalid type for while condition (expected bool, got " +
-                              type_to_string(condition->get_type()) + ")",
+                              type_to_string(condition.get_type()) + ")",
                           node->get_condition()->get_line(),
                           node->get_condition()->get_column());
         }
     }
 
-    return nullptr;
+    return {};
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(FunctionDeclarationNode *node,
-                                                  SymbolTable *table) {
+Value InterpreterVisitor::visit(FunctionDeclarationNode *node, SymbolTable *table) {
     // Create a symbol for the function
-    std::shared_ptr<Object> function_object =
-        std::make_shared<FunctionObject>(node->get_body(), *node->get_parameters());
+    Value function_object(
+        std::make_shared<FunctionObject>(node->get_body(), *node->get_parameters()));
 
     return function_object;
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(CallOpNode *node, SymbolTable *table) {
+Value InterpreterVisitor::visit(CallOpNode *node, SymbolTable *table) {
+    check_stack(node);
+
+    // Calls to built-in functions were bound by semantic analysis
+    if (node->get_built_in_id() >= 0) {
+        return call_built_in(node, node->get_built_in_id(), table);
+    }
+
     // Get the function object from the symbol table
-    std::string name = node->get_identifier();
-    Symbol *function_symbol = table->get(name, false);
-    std::shared_ptr<FunctionObject> function_object =
-        std::static_pointer_cast<FunctionObject>(function_symbol->get_value());
+    const std::string &name = node->get_identifier();
+    Value function_value = table->load(node->get_slot());
+    if (!function_value.is_defined()) {
+        runtime_error("Undeclared identifier '" + name + "'", node->get_line(), node->get_column());
+    }
+
+    auto *function_object = function_value.as<FunctionObject>();
 
-    // If the symbol is a function
-    if (function_symbol->get_type() == TYPE_FUNCTION) {
+    // If the value is a function
+    if (function_value.get_type() == TYPE_FUNCTION) {
         // Check if the number of arguments is correct
         if (function_object->get_parameters_size() != node->get_arguments_size()) {
             runtime_error("Incorrect number of arguments to function '" + name + "' (expected " +
@@ -381,90 +574,193 @@ std::shared_ptr<Object> InterpreterVisitor::visit(CallOpNode *node, SymbolTable
             "Identifier '" + name + "' is not a function", node->get_line(), node->get_column());
     }
 
-    // Handle built-in functions
     if (function_object->is_built_in()) {
-        std::vector<std::shared_ptr<Object>> arguments;
-        for (auto &argument : *node->get_arguments()) {
-            arguments.push_back(argument->evaluate(this, table));
-        }
+        return call_built_in(node, function_object->get_built_in_id(), table);
+    }
 
-        return built_in_functions.handle_built_in_function(
-            name, &arguments, node->get_line(), node->get_column());
+    // A call in tail position is handed to the call being returned from, which runs it in its own
+    // frame. Its arguments are evaluated first, as they may make (and hand over) calls of their own
+    if (node->is_tail_call()) {
+        for (size_t i = 0; i < node->get_arguments_size(); i++) {
+            tail_call_arguments.push_back(node->get_argument(i)->evaluate(this, table));
+        }
+        tail_call_function = std::move(function_value);
+        tail_call_node = node;
+        return Value::make_void();
     }
 
-    // Push a new return value to the stack
-    return_values.push(std::make_shared<VoidObject>());
+    // Nested calls are limited by the maximum depth (and by the space left on the stack, which was
+    // checked when the call was visited)
+    if (call_depth >= max_call_depth) {
+        recursion_error(node);
+    }
+    call_depth++;
 
-    // Create a new scope for the function with the arguments
-    auto *function_table = new SymbolTable(table->get_global_scope(), false, true);
+    // Create a new scope for the function with the arguments (in the first slots)
+    PooledScope function_scope(&scope_pool, table->get_global_scope(), false, true);
+    SymbolTable *function_table = function_scope.get();
     for (size_t i = 0; i < node->get_arguments_size(); i++) {
-        std::string arg_name = function_object->get_parameters()->at(i);
-        std::shared_ptr<Object> arg_value = node->get_arguments()->at(i)->evaluate(this, table);
-        function_table->insert(Symbol(arg_name, arg_value));
+        Value arg_value = node->get_arguments()->at(i)->evaluate(this, table);
+        function_table->set_slot((int)i, arg_value);
     }
 
     // Evaluate the function body
+    if (profiler) {
+        profiler->enter_function(name);
+    }
+
     function_object->call(this, function_table);
 
+    // Calls in tail position replace the function in the same scope, so they don't nest
+    while (tail_call_node) {
+        CallOpNode *tail_node = tail_call_node;
+        Value tail_function = std::move(tail_call_function);
+        tail_call_node = nullptr;
+        returning = false;
+
+        if (profiler) {
+            profiler->enter_tail_call(tail_node->get_identifier(), tail_node->get_line());
+        }
+
+        function_table->reset(table->get_global_scope(), false, true);
+        size_t arguments_start = tail_call_arguments.size() - tail_node->get_arguments_size();
+        for (size_t i = 0; i < tail_node->get_arguments_size(); i++) {
+            function_table->set_slot((int)i, std::move(tail_call_arguments[arguments_start + i]));
+        }
+        tail_call_arguments.resize(arguments_start);
+
+        tail_function.as<FunctionObject>()->call(this, function_table);
+    }
+
+    if (profiler) {
+        profiler->exit_function();
+    }
+
     returning = false;
+    call_depth--;
+
+    // Take the return value, leaving void for the next call that does not return a value
+    Value result = std::move(return_value);
+    return_value = Value::make_void();
+
+    return result;
+}
+
+Value InterpreterVisitor::call_built_in(CallOpNode *node, int built_in_id, SymbolTable *table) {
+    const BuiltInFunction &built_in = BuiltInFunctions::get(built_in_id);
+    if (built_in.param_count != (int)node->get_arguments_size()) {
+        runtime_error("Incorrect number of arguments to function '" + node->get_identifier() +
+                          "' (expected " + std::to_string(built_in.param_count) + ", given " +
+                          std::to_string(node->get_arguments_size()) + ")",
+                      node->get_line(),
+                      node->get_column());
+    }
+
+    // Built-in functions take few arguments, which are evaluated into a fixed array
+    Value arguments[BuiltInFunctions::MAX_PARAMETERS];
+    for (int i = 0; i < built_in.param_count; i++) {
+        arguments[i] = node->get_argument(i)->evaluate(this, table);
+    }
+
+    if (profiler) {
+        profiler->enter_function(node->get_identifier());
+    }
+
+    Value result =
+        built_in_functions.call(built_in_id, arguments, node->get_line(), node->get_column());
 
-    // Get the return value from the top of the stack
-    std::shared_ptr<Object> return_value = return_values.top();
-    return_values.pop();
+    if (profiler) {
+        profiler->exit_function();
+    }
 
-    return return_value;
+    return result;
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(CompoundStatementNode *node, SymbolTable *table) {
+Value InterpreterVisitor::visit(CompoundStatementNode *node, SymbolTable *table) {
+    check_stack(node);
+
     // Create a new scope for the compound statement
-    auto *compound_statement_table = new SymbolTable(table, table->is_loop(), table->is_function());
+    PooledScope compound_statement_scope(
+        &scope_pool, table, table->is_loop(), table->is_function());
+    SymbolTable *compound_statement_table = compound_statement_scope.get();
 
     for (auto &statement : *node->get_statements()) {
         // Handle breaking
         if (backtracking || returning) {
-            return nullptr;
+            return {};
         }
 
-        statement->evaluate(this, compound_statement_table);
+        if (profiler) {
+            evaluate_profiled_statement(statement, compound_statement_table);
+        } else {
+            statement->evaluate(this, compound_statement_table);
+        }
     }
 
-    return nullptr;
+    return {};
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(IdentifierNode *node, SymbolTable *table) {
-    // Get identifier value from the symbol table
-    std::string name = node->get_name();
-    return table->get(name, false)->get_value();
+Value InterpreterVisitor::visit(IdentifierNode *node, SymbolTable *table) {
+    // Get identifier value from its slot
+    Value value = table->load(node->get_slot());
+    if (!value.is_defined()) {
+        runtime_error("Undeclared identifier '" + node->get_name() + "'",
+                      node->get_line(),
+                      node->get_column());
+    }
+
+    return value;
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(LiteralNode *node, SymbolTable *table) {
+Value InterpreterVisitor::visit(LiteralNode *node, SymbolTable *table) {
+    // Use the value materialized by the optimizer or by an earlier evaluation, if any
+    if (node->has_constant()) {
+        return node->get_constant();
+    }
+
     // Create an object from the literal value
+    Value value;
     switch (node->get_type()) {
     case TYPE_INT:
         try {
-            return std::make_shared<IntObject>(node->get_value());
+            value = Value::from_int(std::stoi(node->get_value()));
         } catch (const std::out_of_range &e) {
             runtime_error("Integer value out of range", node->get_line(), node->get_column());
         }
+        break;
     case TYPE_FLOAT:
         try {
-            return std::make_shared<FloatObject>(node->get_value());
+            value = Value::from_float(std::stof(node->get_value()));
         } catch (const std::out_of_range &e) {
             runtime_error("Float value out of range", node->get_line(), node->get_column());
         }
+        break;
     case TYPE_BOOL:
-        return std::make_shared<BoolObject>(node->get_value());
+        value = Value::from_bool(node->get_value() == "true");
+        break;
     case TYPE_STRING:
-        return StringObject::from_string_literal(node->get_value());
+        value = Value(StringObject::from_string_literal(node->get_value()));
+        break;
     default:
-        return nullptr;
+        return {};
     }
+
+    // The node keeps its value, so later evaluations don't convert the literal again
+    node->set_constant(value);
+    return value;
 }
 
-std::shared_ptr<Object> InterpreterVisitor::visit(ErrorNode *node, SymbolTable *table) {
+Value InterpreterVisitor::visit(ErrorNode *node, SymbolTable *table) {
     // This should never occur!
     runtime_error("Error node", node->get_line(), node->get_column());
-    return nullptr;
+    return {};
+}
+
+void InterpreterVisitor::recursion_error(ASTNode *node) {
+    runtime_error("Maximum recursion depth exceeded (" + std::to_string(call_depth) +
+                      " nested calls)",
+                  node->get_line(),
+                  node->get_column());
 }
 
 void InterpreterVisitor::runtime_error(const std::string &message, int line, int column) {
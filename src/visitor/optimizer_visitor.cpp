@@ -0,0 +1,258 @@
+#include "visitor/optimizer_visitor.h"
+#include "AST/AST_nodes.h"
+#include "object/string_object.h"
+#include "operators.h"
+#include <stdexcept>
+
+OptimizerVisitor::OptimizerVisitor(ProgramNode *program_node, ErrorManager *error_manager)
+    : program_node(program_node), error_manager(error_manager) {}
+
+void OptimizerVisitor::optimize() {
+    program_node->optimize(this, 0);
+}
+
+ASTNode *OptimizerVisitor::visit(ProgramNode *node, int arg) {
+    optimize_statements(node->get_statements());
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(BinOpNode *node, int arg) {
+    node->set_left_node(optimize(node->get_left_node()));
+    node->set_right_node(optimize(node->get_right_node()));
+
+    Value left = get_constant(node->get_left_node());
+    Value right = get_constant(node->get_right_node());
+    if (!left.is_defined() || !right.is_defined()) {
+        return node;
+    }
+
+    // Integer division by zero (or of the minimum int by -1) traps, so it is left to the runtime
+    bool integer_division = (node->get_op() == DIVISION_OPERATOR ||
+                             node->get_op() == MOD_OPERATOR) &&
+                            right.get_type() == TYPE_INT;
+    if (integer_division && (right.get_int() == 0 || right.get_int() == -1)) {
+        return node;
+    }
+
+    return replace_with_constant(node,
+                                 apply_binary_operator(node->get_binary_operator(), left, right));
+}
+
+ASTNode *OptimizerVisitor::visit(CastOpNode *node, int arg) {
+    node->set_operand(optimize(node->get_operand()));
+
+    Value operand = get_constant(node->get_operand());
+    if (!operand.is_defined()) {
+        return node;
+    }
+
+    // An invalid cast is undefined, and left to the runtime to report
+    return replace_with_constant(node, operand.cast(node->get_type()));
+}
+
+ASTNode *OptimizerVisitor::visit(SubscriptOpNode *node, int arg) {
+    node->set_identifier(optimize(node->get_identifier()));
+    node->set_index(optimize(node->get_index()));
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(SliceOpNode *node, int arg) {
+    node->set_identifier(optimize(node->get_identifier()));
+    node->set_start(optimize(node->get_start()));
+    node->set_end(optimize(node->get_end()));
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(UnaryOpNode *node, int arg) {
+    node->set_operand(optimize(node->get_operand()));
+
+    Value operand = get_constant(node->get_operand());
+    if (!operand.is_defined()) {
+        return node;
+    }
+
+    return replace_with_constant(node, apply_unary_operator(node->get_unary_operator(), operand));
+}
+
+ASTNode *OptimizerVisitor::visit(ArrayLiteralNode *node, int arg) {
+    optimize_expressions(node->get_values());
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(RangeLiteralNode *node, int arg) {
+    node->set_start(optimize(node->get_start()));
+    node->set_end(optimize(node->get_end()));
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(AssignmentNode *node, int arg) {
+    node->set_identifier(optimize(node->get_identifier()));
+    node->set_value(optimize(node->get_value()));
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(BreakStatementNode *node, int arg) {
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(ContinueStatementNode *node, int arg) {
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(ReturnStatementNode *node, int arg) {
+    node->set_value(optimize(node->get_value()));
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(ForStatementNode *node, int arg) {
+    node->set_iterable(optimize(node->get_iterable()));
+    node->set_body(optimize(node->get_body()));
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(IfStatementNode *node, int arg) {
+    node->set_condition(optimize(node->get_condition()));
+    node->set_if_body(optimize(node->get_if_body()));
+    node->set_else_body(optimize(node->get_else_body()));
+
+    // A condition that is not a bool is an error at runtime
+    Value condition = get_constant(node->get_condition());
+    if (condition.get_type() != TYPE_BOOL) {
+        return node;
+    }
+
+    // Take the branch out of the if statement
+    ASTNode *branch;
+    if (condition.get_bool()) {
+        branch = node->get_if_body();
+        node->set_if_body(nullptr);
+    } else {
+        branch = node->get_else_body();
+        node->set_else_body(nullptr);
+    }
+
+    int line = node->get_line(), col = node->get_column();
+    delete node;
+
+    if (branch == nullptr) {
+        return nullptr;
+    }
+
+    // The branch keeps the scope of the if statement, which its variable slots are relative to
+    return new CompoundStatementNode({branch}, line, col);
+}
+
+ASTNode *OptimizerVisitor::visit(RepeatStatementNode *node, int arg) {
+    node->set_count(optimize(node->get_count()));
+    node->set_body(optimize(node->get_body()));
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(WhileStatementNode *node, int arg) {
+    node->set_condition(optimize(node->get_condition()));
+    node->set_body(optimize(node->get_body()));
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(FunctionDeclarationNode *node, int arg) {
+    node->set_body(optimize(node->get_body()));
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(CallOpNode *node, int arg) {
+    optimize_expressions(node->get_arguments());
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(CompoundStatementNode *node, int arg) {
+    optimize_statements(node->get_statements());
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(IdentifierNode *node, int arg) {
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(LiteralNode *node, int arg) {
+    if (node->has_constant()) {
+        return node;
+    }
+
+    // Convert the literal to a value once, unless it is out of range (an error at runtime)
+    try {
+        switch (node->get_type()) {
+        case TYPE_INT:
+            node->set_constant(Value::from_int(std::stoi(node->get_value())));
+            break;
+        case TYPE_FLOAT:
+            node->set_constant(Value::from_float(std::stof(node->get_value())));
+            break;
+        case TYPE_BOOL:
+            node->set_constant(Value::from_bool(node->get_value() == "true"));
+            break;
+        case TYPE_STRING:
+            node->set_constant(Value(StringObject::from_string_literal(node->get_value())));
+            break;
+        default:
+            break;
+        }
+    } catch (const std::out_of_range &e) {
+    }
+
+    return node;
+}
+
+ASTNode *OptimizerVisitor::visit(ErrorNode *node, int arg) {
+    return node;
+}
+
+ASTNode *OptimizerVisitor::optimize(ASTNode *node) {
+    return node == nullptr ? nullptr : node->optimize(this, 0);
+}
+
+void OptimizerVisitor::optimize_expressions(std::vector<ASTNode *> *expressions) {
+    for (auto &expression : *expressions) {
+        expression = optimize(expression);
+    }
+}
+
+void OptimizerVisitor::optimize_statements(std::vector<ASTNode *> *statements) {
+    size_t kept = 0;
+    for (auto &statement : *statements) {
+        ASTNode *optimized = optimize(statement);
+        if (optimized != nullptr) {
+            (*statements)[kept++] = optimized;
+        }
+    }
+    statements->resize(kept);
+}
+
+Value OptimizerVisitor::get_constant(ASTNode *node) {
+    if (node->get_node_type() != LITERAL_NODE) {
+        return {};
+    }
+    return static_cast<LiteralNode *>(node)->get_constant();
+}
+
+ASTNode *OptimizerVisitor::replace_with_constant(ASTNode *node, const Value &constant) {
+    Type type = constant.get_type();
+    if (type != TYPE_INT && type != TYPE_FLOAT && type != TYPE_BOOL && type != TYPE_STRING) {
+        return node;
+    }
+
+    // The text of the literal, as it would be written in the code
+    std::string text(constant.cast(TYPE_STRING).as<StringObject>()->get_value());
+    if (type == TYPE_STRING) {
+        text = "\"" + text + "\"";
+    }
+
+    // A folded string gets a buffer of its own, which is never appended to in place
+    Value value = constant;
+    if (type == TYPE_STRING) {
+        value = Value(StringObject::from_string_literal(text));
+    }
+
+    auto *literal = new LiteralNode(type, text, value, node->get_line(), node->get_column());
+    delete node;
+    return literal;
+}
@@ -39,6 +39,14 @@ void PrintVisitor::visit(SubscriptOpNode *node, int indentation) {
     node->get_index()->accept(this, indentation + 1);
 }
 
+void PrintVisitor::visit(SliceOpNode *node, int indentation) {
+    std::cout << std::string(indentation, '\t') << "SliceOpNode" << std::endl;
+
+    node->get_identifier()->accept(this, indentation + 1);
+    node->get_start()->accept(this, indentation + 1);
+    node->get_end()->accept(this, indentation + 1);
+}
+
 void PrintVisitor::visit(UnaryOpNode *node, int indentation) {
     std::cout << std::string(indentation, '\t') << "UnaryOpNode " << token_values[node->get_op()]
               << std::endl;
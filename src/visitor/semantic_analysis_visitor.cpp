@@ -15,10 +15,17 @@ void SemanticAnalysisVisitor::visit(ProgramNode *node, SymbolTable *table) {
     auto *global_table = new SymbolTable(nullptr, false, false);
     built_in_functions.register_built_in_functions(global_table);
 
+    // Find the globals that functions may assign to before they are declared
+    global_names.clear();
+    for (auto &statement : *node->get_statements()) {
+        collect_global_names(statement);
+    }
+
     for (auto &statement : *node->get_statements()) {
         statement->analyze(this, global_table);
     }
 
+    node->set_global_names(global_table->get_slot_names());
     delete global_table;
 }
 
@@ -36,6 +43,12 @@ void SemanticAnalysisVisitor::visit(SubscriptOpNode *node, SymbolTable *table) {
     node->get_index()->analyze(this, table);
 }
 
+void SemanticAnalysisVisitor::visit(SliceOpNode *node, SymbolTable *table) {
+    node->get_identifier()->analyze(this, table);
+    node->get_start()->analyze(this, table);
+    node->get_end()->analyze(this, table);
+}
+
 void SemanticAnalysisVisitor::visit(UnaryOpNode *node, SymbolTable *table) {
     node->get_operand()->analyze(this, table);
 }
@@ -68,6 +81,7 @@ void SemanticAnalysisVisitor::visit(AssignmentNode *node, SymbolTable *table) {
         if (!table->contains(name, false)) {
             table->insert(Symbol(name));
         }
+        node->set_slot(resolve(name, table));
     } else {
         semantic_error("Invalid assignment operand", node->get_line(), node->get_column());
     }
@@ -101,6 +115,13 @@ void SemanticAnalysisVisitor::visit(ReturnStatementNode *node, SymbolTable *tabl
 
     if (node->has_value()) {
         node->get_value()->analyze(this, table);
+
+        // A call whose result is returned directly is in tail position, so it can reuse the frame
+        // of the function that returns it
+        if (node->get_value()->get_node_type() == CALL_NODE) {
+            auto *call = static_cast<CallOpNode *>(node->get_value());
+            call->set_tail_call(call->get_built_in_id() < 0 && table->is_function());
+        }
     }
 }
 
@@ -123,7 +144,7 @@ void SemanticAnalysisVisitor::visit(IfStatementNode *node, SymbolTable *table) {
     node->get_if_body()->analyze(this, if_statement_table);
 
     if (node->get_else_body() != nullptr) {
-        node->get_else_body()->analyze(this, table);
+        node->get_else_body()->analyze(this, if_statement_table);
     }
 }
 
@@ -145,11 +166,12 @@ void SemanticAnalysisVisitor::visit(WhileStatementNode *node, SymbolTable *table
 
 void SemanticAnalysisVisitor::visit(FunctionDeclarationNode *node, SymbolTable *table) {
     // Insert the function into the symbol table
-    std::shared_ptr<Object> function_object =
-        std::make_shared<FunctionObject>(node->get_body(), *node->get_parameters());
+    Value function_object(
+        std::make_shared<FunctionObject>(node->get_body(), *node->get_parameters()));
 
-    // New scope for the function (includes the function's parameters)
-    auto *function_table = new SymbolTable(table, table->is_loop(), true);
+    // New scope for the function (includes the function's parameters). Functions can only see
+    // their own variables and the globals.
+    auto *function_table = new SymbolTable(table->get_global_scope(), false, true);
     for (auto &param : *node->get_parameters()) {
         function_table->insert(Symbol(param));
     }
@@ -161,11 +183,18 @@ void SemanticAnalysisVisitor::visit(CallOpNode *node, SymbolTable *table) {
     std::string name = node->get_identifier();
 
     // The function must be declared before it is called
-    bool function_exists = table->contains(name, false);
-    if (!function_exists) {
+    VariableSlot slot = resolve(name, table);
+    if (!slot.is_resolved()) {
         semantic_error(
             "Undeclared identifier '" + name + "'", node->get_line(), node->get_column());
     }
+    node->set_slot(slot);
+
+    // Built-in functions can't be reassigned, so their calls are bound to them once
+    Symbol *symbol = table->get(name, false);
+    if (symbol != nullptr && symbol->get_type() == TYPE_FUNCTION) {
+        node->set_built_in_id(symbol->get_value().as<FunctionObject>()->get_built_in_id());
+    }
 
     for (auto &param : *node->get_arguments()) {
         param->analyze(this, table);
@@ -185,7 +214,9 @@ void SemanticAnalysisVisitor::visit(IdentifierNode *node, SymbolTable *table) {
     std::string name = node->get_name();
 
     // Check if the identifier was declared
-    if (!table->contains(name, false)) {
+    VariableSlot slot = resolve(name, table);
+    node->set_slot(slot);
+    if (!slot.is_resolved()) {
         semantic_error(
             "Undeclared identifier '" + name + "'", node->get_line(), node->get_column());
     }
@@ -220,6 +251,86 @@ std::string SemanticAnalysisVisitor::get_array_identifier(SubscriptOpNode *node,
     }
 }
 
+VariableSlot SemanticAnalysisVisitor::resolve(const std::string &name, SymbolTable *table) {
+    VariableSlot slot = table->resolve(name);
+
+    // A function may assign to a global before the global is declared, so its local variables
+    // refer to the global of the same name if it exists
+    if (slot.is_resolved() && !slot.is_global() && table->is_function() &&
+        global_names.count(name)) {
+        slot.global_slot = table->get_global_scope()->slot_index(name);
+    }
+
+    return slot;
+}
+
+void SemanticAnalysisVisitor::collect_global_names(ASTNode *node) {
+    // Only the parts of a top level statement that are evaluated in the global scope can declare
+    // globals; blocks have their own scope and function bodies are not evaluated
+    switch (node->get_node_type()) {
+    case ASSIGNMENT_NODE: {
+        auto *assignment = static_cast<AssignmentNode *>(node);
+        if (assignment->get_identifier()->get_node_type() == IDENTIFIER_NODE) {
+            global_names.insert(
+                static_cast<IdentifierNode *>(assignment->get_identifier())->get_name());
+        } else {
+            collect_global_names(assignment->get_identifier());
+        }
+        collect_global_names(assignment->get_value());
+        break;
+    }
+    case BIN_OP_NODE:
+        collect_global_names(static_cast<BinOpNode *>(node)->get_left_node());
+        collect_global_names(static_cast<BinOpNode *>(node)->get_right_node());
+        break;
+    case CAST_OP_NODE:
+        collect_global_names(static_cast<CastOpNode *>(node)->get_operand());
+        break;
+    case UNARY_OP_NODE:
+        collect_global_names(static_cast<UnaryOpNode *>(node)->get_operand());
+        break;
+    case SUBSCRIPT_OP_NODE:
+        collect_global_names(static_cast<SubscriptOpNode *>(node)->get_identifier());
+        collect_global_names(static_cast<SubscriptOpNode *>(node)->get_index());
+        break;
+    case SLICE_OP_NODE:
+        collect_global_names(static_cast<SliceOpNode *>(node)->get_identifier());
+        collect_global_names(static_cast<SliceOpNode *>(node)->get_start());
+        collect_global_names(static_cast<SliceOpNode *>(node)->get_end());
+        break;
+    case RANGE_LITERAL_NODE:
+        collect_global_names(static_cast<RangeLiteralNode *>(node)->get_start());
+        collect_global_names(static_cast<RangeLiteralNode *>(node)->get_end());
+        break;
+    case ARRAY_LITERAL_NODE:
+        for (auto &value : *static_cast<ArrayLiteralNode *>(node)->get_values()) {
+            collect_global_names(value);
+        }
+        break;
+    case CALL_NODE:
+        for (auto &argument : *static_cast<CallOpNode *>(node)->get_arguments()) {
+            collect_global_names(argument);
+        }
+        break;
+    case RETURN_STATEMENT_NODE:
+        if (static_cast<ReturnStatementNode *>(node)->has_value()) {
+            collect_global_names(static_cast<ReturnStatementNode *>(node)->get_value());
+        }
+        break;
+    case FOR_STATEMENT_NODE:
+        collect_global_names(static_cast<ForStatementNode *>(node)->get_iterable());
+        break;
+    case REPEAT_STATEMENT_NODE:
+        collect_global_names(static_cast<RepeatStatementNode *>(node)->get_count());
+        break;
+    case WHILE_STATEMENT_NODE:
+        collect_global_names(static_cast<WhileStatementNode *>(node)->get_condition());
+        break;
+    default:
+        break;
+    }
+}
+
 void SemanticAnalysisVisitor::semantic_error(const std::string &message, int line, int column) {
     error_manager->error_at_pos(message, line, column, true);
 }
@@ -0,0 +1,39 @@
+#include "vm/bytecode_function.h"
+#include <algorithm>
+
+int BytecodeFunction::emit(Instruction instruction, int line, int column) {
+    code.push_back(instruction);
+    positions.push_back({line, column});
+    return (int)code.size() - 1;
+}
+
+void BytecodeFunction::patch_jump(int index, int target) {
+    // The jump target is stored in a different operand depending on the instruction
+    Instruction &instruction = code[index];
+    if (instruction.op == OP_JUMP) {
+        instruction.a = target;
+    } else if (instruction.op == OP_JUMP_IF_FALSE) {
+        instruction.b = target;
+    } else {
+        instruction.c = target;
+    }
+}
+
+int BytecodeFunction::add_constant(Value constant) {
+    constants.push_back(std::move(constant));
+    return (int)constants.size() - 1;
+}
+
+int BytecodeFunction::add_name(const std::string &name) {
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it != names.end()) {
+        return (int)(it - names.begin());
+    }
+
+    names.push_back(name);
+    return (int)names.size() - 1;
+}
+
+void BytecodeFunction::reserve_registers(int count) {
+    register_count = std::max(register_count, count);
+}
@@ -0,0 +1,18 @@
+#include "vm/bytecode_program.h"
+
+BytecodeProgram::~BytecodeProgram() {
+    for (auto *function : functions) {
+        delete function;
+    }
+}
+
+int BytecodeProgram::add_function(BytecodeFunction *function) {
+    functions.push_back(function);
+    return (int)functions.size() - 1;
+}
+
+int BytecodeProgram::add_global(const std::string &name, Value initial_value) {
+    global_names.push_back(name);
+    global_values.push_back(std::move(initial_value));
+    return (int)global_names.size() - 1;
+}
@@ -0,0 +1,478 @@
+#include "vm/virtual_machine.h"
+#include "object/array_object.h"
+#include "object/function_object.h"
+#include "object/string_object.h"
+#include "operators.h"
+#include <climits>
+
+namespace {
+/**
+ * @brief Get the operator token of an arithmetic, logical or comparison opcode.
+ * @param op The opcode.
+ * @return The operator token, used in error messages.
+ */
+TokenType operator_token(OpCode op) {
+    switch (op) {
+    case OP_ADD:
+    case OP_POSITIVE:
+        return ADDITION_OPERATOR;
+    case OP_SUBTRACT:
+    case OP_NEGATIVE:
+        return SUBTRACTION_OPERATOR;
+    case OP_MULTIPLY:
+        return MULTIPLICATIVE_OPERATOR;
+    case OP_DIVIDE:
+        return DIVISION_OPERATOR;
+    case OP_MODULO:
+        return MOD_OPERATOR;
+    case OP_LOGICAL_AND:
+        return LOGICAL_AND_OPERATOR;
+    case OP_LOGICAL_OR:
+        return LOGICAL_OR_OPERATOR;
+    case OP_LOGICAL_NOT:
+        return LOGICAL_NOT_OPERATOR;
+    case OP_BITWISE_AND:
+        return BITWISE_AND_OPERATOR;
+    case OP_BITWISE_OR:
+        return BITWISE_OR_OPERATOR;
+    case OP_BITWISE_XOR:
+        return BITWISE_XOR_OPERATOR;
+    case OP_BITWISE_NOT:
+        return BITWISE_NOT_OPERATOR;
+    case OP_LESS_THAN:
+        return LESS_THAN_OPERATOR;
+    case OP_LESS_THAN_EQUAL:
+        return LESS_THAN_EQUAL_OPERATOR;
+    case OP_GREATER_THAN:
+        return GREATER_THAN_OPERATOR;
+    case OP_GREATER_THAN_EQUAL:
+        return GREATER_THAN_EQUAL_OPERATOR;
+    case OP_EQUAL:
+        return EQUAL_OPERATOR;
+    default:
+        return NOT_EQUAL_OPERATOR;
+    }
+}
+
+/**
+ * @brief Get the error message of a failed type check.
+ * @param kind The kind of check.
+ * @param type The type that was found.
+ * @return The error message.
+ */
+std::string check_error_message(CheckKind kind, Type type) {
+    std::string expected;
+    switch (kind) {
+    case CHECK_RANGE_START:
+        expected = "start of range (expected int";
+        break;
+    case CHECK_RANGE_END:
+        expected = "end of range (expected int";
+        break;
+    case CHECK_FOR_ITERABLE:
+        expected = "iterable (expected array, string or file";
+        break;
+    case CHECK_IF_CONDITION:
+        expected = "if condition (expected bool";
+        break;
+    case CHECK_WHILE_CONDITION:
+        expected = "while condition (expected bool";
+        break;
+    case CHECK_REPEAT_COUNT:
+        expected = "repeat count (expected int";
+        break;
+    }
+
+    return "Invalid type for " + expected + ", got " + type_to_string(type) + ")";
+}
+} // namespace
+
+VirtualMachine::VirtualMachine(BytecodeProgram *program, ErrorManager *error_manager)
+    : program(program), error_manager(error_manager), built_in_functions(error_manager) {}
+
+void VirtualMachine::run() {
+    globals = program->get_global_values();
+
+    BytecodeFunction *main_function = program->get_main_function();
+    registers.assign(main_function->get_register_count(), Value());
+    frames.push_back({main_function, 0, 0, -1});
+
+    // The state of the current frame is cached in locals, and reloaded on calls and returns
+    BytecodeFunction *function = main_function;
+    const Instruction *code = function->get_code();
+    const Value *constants = function->get_constants();
+    Value *regs = registers.data();
+    int pc = 0;
+
+    while (true) {
+        const Instruction &instruction = code[pc++];
+
+        switch (instruction.op) {
+        case OP_LOAD_CONST:
+            regs[instruction.a] = constants[instruction.b];
+            break;
+        case OP_MOVE:
+            regs[instruction.a] = regs[instruction.b];
+            break;
+        case OP_LOAD_GLOBAL: {
+            const Value &value = globals[instruction.b];
+            if (!value.is_defined()) {
+                runtime_error("Undeclared identifier '" +
+                                  program->get_global_name(instruction.b) + "'",
+                              function,
+                              pc - 1);
+            }
+            regs[instruction.a] = value;
+            break;
+        }
+        case OP_STORE_GLOBAL:
+            globals[instruction.b] = regs[instruction.a];
+            break;
+        case OP_LOAD_DYNAMIC:
+            if (regs[instruction.b].is_defined()) {
+                regs[instruction.a] = regs[instruction.b];
+            } else if (globals[instruction.c].is_defined()) {
+                regs[instruction.a] = globals[instruction.c];
+            } else {
+                runtime_error("Undeclared identifier '" +
+                                  program->get_global_name(instruction.c) + "'",
+                              function,
+                              pc - 1);
+            }
+            break;
+        case OP_STORE_DYNAMIC:
+            if (regs[instruction.b].is_defined() || !globals[instruction.c].is_defined()) {
+                regs[instruction.b] = regs[instruction.a];
+            } else {
+                globals[instruction.c] = regs[instruction.a];
+            }
+            break;
+        case OP_CLEAR:
+            regs[instruction.a] = Value();
+            break;
+
+        case OP_ADD:
+        case OP_SUBTRACT:
+        case OP_MULTIPLY:
+        case OP_DIVIDE:
+        case OP_MODULO:
+        case OP_LOGICAL_AND:
+        case OP_LOGICAL_OR:
+        case OP_BITWISE_AND:
+        case OP_BITWISE_OR:
+        case OP_BITWISE_XOR:
+        case OP_LESS_THAN:
+        case OP_LESS_THAN_EQUAL:
+        case OP_GREATER_THAN:
+        case OP_GREATER_THAN_EQUAL:
+        case OP_EQUAL:
+        case OP_NOT_EQUAL: {
+            const Value &left = regs[instruction.b];
+            const Value &right = regs[instruction.c];
+            auto op = (BinaryOperator)(instruction.op - OP_ADD);
+            Value result = apply_binary_operator(op, left, right);
+
+            // An undefined result indicates an invalid operation
+            if (!result.is_defined()) {
+                runtime_error("Invalid operands to binary operator " +
+                                  token_values[operator_token(instruction.op)] + " (" +
+                                  type_to_string(left.get_type()) + " and " +
+                                  type_to_string(right.get_type()) + ")",
+                              function,
+                              pc - 1);
+            }
+            regs[instruction.a] = std::move(result);
+            break;
+        }
+
+        case OP_POSITIVE:
+        case OP_NEGATIVE:
+        case OP_LOGICAL_NOT:
+        case OP_BITWISE_NOT: {
+            const Value &operand = regs[instruction.b];
+            auto op = (UnaryOperator)(instruction.op - OP_POSITIVE);
+            Value result = apply_unary_operator(op, operand);
+
+            // An undefined result indicates an invalid operation
+            if (!result.is_defined()) {
+                runtime_error("Invalid operand to unary operator " +
+                                  token_values[operator_token(instruction.op)] + " (" +
+                                  type_to_string(operand.get_type()) + ")",
+                              function,
+                              pc - 1);
+            }
+            regs[instruction.a] = std::move(result);
+            break;
+        }
+
+        case OP_CAST: {
+            const Value &operand = regs[instruction.b];
+            Value result = operand.cast((Type)instruction.c);
+            if (!result.is_defined()) {
+                runtime_error("Invalid cast from " + type_to_string(operand.get_type()) + " to " +
+                                  type_to_string((Type)instruction.c),
+                              function,
+                              pc - 1);
+            }
+            regs[instruction.a] = std::move(result);
+            break;
+        }
+        case OP_SUBSCRIPT: {
+            const Value &identifier = regs[instruction.b];
+            Value result = identifier.subscript(regs[instruction.c]);
+            if (!result.is_defined()) {
+                runtime_error("Invalid subscript operation on " +
+                                  type_to_string(identifier.get_type()),
+                              function,
+                              pc - 1);
+            }
+            regs[instruction.a] = std::move(result);
+            break;
+        }
+        case OP_SLICE: {
+            const Value &identifier = regs[instruction.b];
+            Value result = identifier.slice(regs[instruction.c], regs[instruction.c + 1]);
+            if (!result.is_defined()) {
+                runtime_error("Invalid slice operation on " +
+                                  type_to_string(identifier.get_type()),
+                              function,
+                              pc - 1);
+            }
+            regs[instruction.a] = std::move(result);
+            break;
+        }
+        case OP_SUBSCRIPT_STORE: {
+            // Only arrays can be updated, within their bounds
+            const Value &identifier = regs[instruction.a];
+            if (identifier.get_type() != TYPE_ARRAY ||
+                !identifier.as<ArrayObject>()
+                     ->subscript_update(regs[instruction.b], regs[instruction.c])
+                     .is_defined()) {
+                runtime_error("Invalid subscript operation on " +
+                                  type_to_string(identifier.get_type()),
+                              function,
+                              pc - 1);
+            }
+            break;
+        }
+        case OP_NEW_ARRAY: {
+            std::vector<Value> values(regs + instruction.b, regs + instruction.b + instruction.c);
+            regs[instruction.a] = Value(std::make_shared<ArrayObject>(std::move(values)));
+            break;
+        }
+        case OP_NEW_RANGE: {
+            // The elements of the range are only created if the array is modified
+            int start = regs[instruction.b].get_int();
+            int end = regs[instruction.c].get_int();
+            auto range = ArrayObject::from_range(start, end);
+            if (!range) {
+                runtime_error("Range too long (more than " + std::to_string(INT_MAX) + " elements)",
+                              function,
+                              pc - 1);
+            }
+            regs[instruction.a] = Value(std::move(range));
+            break;
+        }
+
+        case OP_CHECK_TYPE: {
+            Type type = regs[instruction.a].get_type();
+            if (((instruction.b >> type) & 1) == 0) {
+                runtime_error(
+                    check_error_message((CheckKind)instruction.c, type), function, pc - 1);
+            }
+            break;
+        }
+        case OP_CHECK_ASSIGN:
+            if (regs[instruction.a].get_type() == TYPE_VOID) {
+                runtime_error("Invalid assignment to void", function, pc - 1);
+            }
+            break;
+        case OP_RAISE:
+            runtime_error(function->get_name(instruction.a), function, pc - 1);
+            break;
+
+        case OP_JUMP:
+            pc = instruction.a;
+            break;
+        case OP_JUMP_IF_FALSE: {
+            const Value &condition = regs[instruction.a];
+            if (condition.get_type() != TYPE_BOOL) {
+                runtime_error(check_error_message((CheckKind)instruction.c, condition.get_type()),
+                              function,
+                              pc - 1);
+            }
+            if (!condition.get_bool()) {
+                pc = instruction.b;
+            }
+            break;
+        }
+        case OP_FOR_START:
+            // The iterable was checked to be an array, a string or a file before the loop
+            regs[instruction.a + 1] = Value::from_int(0);
+            regs[instruction.a + 2] =
+                Value::from_int(regs[instruction.a].get_object()->get_iteration_len());
+            break;
+        case OP_FOR_NEXT: {
+            Value &index = regs[instruction.a + 1];
+            int i = index.get_int();
+            if (i >= regs[instruction.a + 2].get_int() ||
+                !regs[instruction.a].get_object()->iterate(i, regs[instruction.b])) {
+                pc = instruction.c;
+                break;
+            }
+
+            index = Value::from_int(i + 1);
+            break;
+        }
+        case OP_REPEAT_NEXT: {
+            Value &counter = regs[instruction.a + 1];
+            int i = counter.get_int();
+            if (i >= regs[instruction.a].get_int()) {
+                pc = instruction.c;
+                break;
+            }
+
+            counter = Value::from_int(i + 1);
+            break;
+        }
+        case OP_CALL:
+        case OP_TAIL_CALL: {
+            const std::string &name = function->get_name(instruction.c);
+            const Value &callee = regs[instruction.a];
+
+            if (callee.get_type() != TYPE_FUNCTION) {
+                runtime_error("Identifier '" + name + "' is not a function", function, pc - 1);
+            }
+
+            // Check if the number of arguments is correct
+            auto *function_object = callee.as<FunctionObject>();
+            if ((int)function_object->get_parameters_size() != instruction.b) {
+                runtime_error("Incorrect number of arguments to function '" + name +
+                                  "' (expected " +
+                                  std::to_string(function_object->get_parameters_size()) +
+                                  ", given " + std::to_string(instruction.b) + ")",
+                              function,
+                              pc - 1);
+            }
+
+            // Handle built-in functions
+            if (function_object->is_built_in()) {
+                const SourcePosition &position = function->get_position(pc - 1);
+                regs[instruction.a] = built_in_functions.call(function_object->get_built_in_id(),
+                                                              regs + instruction.a + 1,
+                                                              position.line,
+                                                              position.column);
+                break;
+            }
+
+            BytecodeFunction *callee_function = function_object->get_bytecode();
+
+            // A tail call replaces the function of the current frame, with the arguments moved
+            // into its first registers (each argument is after the register it moves to)
+            if (instruction.op == OP_TAIL_CALL) {
+                for (int i = 0; i < instruction.b; i++) {
+                    regs[i] = std::move(regs[instruction.a + 1 + i]);
+                }
+                for (int i = instruction.b; i < function->get_register_count(); i++) {
+                    regs[i] = Value();
+                }
+
+                CallFrame &frame = frames.back();
+                size_t frame_end = (size_t)frame.base + callee_function->get_register_count();
+                if (registers.size() < frame_end) {
+                    registers.resize(frame_end);
+                    regs = registers.data() + frame.base;
+                }
+
+                frame.function = callee_function;
+                function = callee_function;
+                code = function->get_code();
+                constants = function->get_constants();
+                pc = 0;
+                break;
+            }
+
+            // The main function has a frame of its own, which is not a nested call
+            int call_depth = (int)frames.size() - 1;
+            if (call_depth >= max_call_depth) {
+                runtime_error("Maximum recursion depth exceeded (" + std::to_string(call_depth) +
+                                  " nested calls)",
+                              function,
+                              pc - 1);
+            }
+
+            // The new frame starts after the registers of the current frame
+            CallFrame &frame = frames.back();
+            frame.pc = pc;
+            int base = frame.base + function->get_register_count();
+            int return_register = frame.base + instruction.a;
+
+            size_t frame_end = (size_t)base + callee_function->get_register_count();
+            if (registers.size() < frame_end) {
+                registers.resize(frame_end);
+                regs = registers.data() + frame.base;
+            }
+
+            // Move the arguments into the parameter registers
+            for (int i = 0; i < instruction.b; i++) {
+                registers[base + i] = std::move(regs[instruction.a + 1 + i]);
+            }
+
+            frames.push_back({callee_function, 0, base, return_register});
+            function = callee_function;
+            code = function->get_code();
+            constants = function->get_constants();
+            regs = registers.data() + base;
+            pc = 0;
+            break;
+        }
+        case OP_CALL_BUILT_IN: {
+            const BuiltInFunction &built_in = BuiltInFunctions::get(instruction.c);
+            if (built_in.param_count != instruction.b) {
+                runtime_error("Incorrect number of arguments to function '" +
+                                  std::string(built_in.name) + "' (expected " +
+                                  std::to_string(built_in.param_count) + ", given " +
+                                  std::to_string(instruction.b) + ")",
+                              function,
+                              pc - 1);
+            }
+
+            const SourcePosition &position = function->get_position(pc - 1);
+            regs[instruction.a] = built_in_functions.call(
+                instruction.c, regs + instruction.a + 1, position.line, position.column);
+            break;
+        }
+        case OP_RETURN:
+        case OP_RETURN_VOID: {
+            Value result =
+                instruction.op == OP_RETURN ? std::move(regs[instruction.a]) : Value::make_void();
+
+            // Release the registers of the finished frame
+            for (int i = 0; i < function->get_register_count(); i++) {
+                regs[i] = Value();
+            }
+
+            int return_register = frames.back().return_register;
+            frames.pop_back();
+            if (frames.empty()) {
+                built_in_functions.flush();
+                return;
+            }
+
+            CallFrame &frame = frames.back();
+            function = frame.function;
+            code = function->get_code();
+            constants = function->get_constants();
+            regs = registers.data() + frame.base;
+            pc = frame.pc;
+            registers[return_register] = std::move(result);
+            break;
+        }
+        }
+    }
+}
+
+void VirtualMachine::runtime_error(const std::string &message, BytecodeFunction *function, int pc) {
+    const SourcePosition &position = function->get_position(pc);
+    error_manager->runtime_error(message, position.line, position.column);
+}
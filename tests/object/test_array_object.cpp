@@ -0,0 +1,223 @@
+#include "object/array_object.h"
+#include "object/string_object.h"
+#include "object/value.h"
+#include "operators.h"
+#include <climits>
+#include <doctest/doctest.h>
+
+TEST_CASE("Array ranges are lazy") {
+    auto range = ArrayObject::from_range(2, 6);
+    auto down = ArrayObject::from_range(3, -1);
+    Value range_value(range);
+
+    // Reading a range never creates its elements
+    CHECK_EQ(range->get_len(), 5);
+    CHECK_EQ(down->get_len(), 5);
+    CHECK_EQ(ArrayObject::from_range(4, 4)->get_len(), 1);
+
+    // A range can hold up to INT_MAX elements
+    auto longest = ArrayObject::from_range(1, INT_MAX);
+    CHECK_EQ(longest->get_len(), INT_MAX);
+    CHECK_EQ(longest->subscript(Value::from_int(INT_MAX - 1)).get_int(), INT_MAX);
+    CHECK_EQ(ArrayObject::from_range(0, INT_MAX), nullptr);
+    CHECK_EQ(ArrayObject::from_range(INT_MAX, INT_MIN), nullptr);
+    CHECK_EQ(range->subscript(Value::from_int(0)).get_int(), 2);
+    CHECK_EQ(range->subscript(Value::from_int(4)).get_int(), 6);
+    CHECK_EQ(down->subscript(Value::from_int(4)).get_int(), -1);
+    CHECK_FALSE(range->subscript(Value::from_int(5)).is_defined());
+    CHECK_EQ(range->cast(TYPE_STRING).as<StringObject>()->get_value(), "[2, 3, 4, 5, 6]");
+
+    Value copy = range_value.duplicate();
+    CHECK(copy.as<ArrayObject>()->is_range());
+    CHECK(range_value.equal(copy).get_bool());
+
+    Value concatenated = range_value.add(Value(down));
+    CHECK_EQ(concatenated.as<ArrayObject>()->get_len(), 10);
+    CHECK_EQ(concatenated.subscript(Value::from_int(5)).get_int(), 3);
+    CHECK(range->is_range());
+    CHECK(down->is_range());
+
+    // Mutating a range creates its elements in place, for every reference to it
+    Value alias = range_value;
+    range->subscript_update(Value::from_int(1), Value::from_int(9));
+    CHECK_FALSE(range->is_range());
+    CHECK_EQ(alias.cast(TYPE_STRING).as<StringObject>()->get_value(), "[2, 9, 4, 5, 6]");
+    CHECK(copy.as<ArrayObject>()->is_range());
+    CHECK_FALSE(range_value.equal(copy).get_bool());
+}
+
+TEST_CASE("Array copies share their elements until modified") {
+    Value array(std::make_shared<ArrayObject>(
+        std::vector<Value>{Value::from_int(1), Value(std::make_shared<StringObject>("a"))}));
+    Value copy = array.cast(TYPE_ARRAY);
+    Value duplicate = array.duplicate();
+    Value concatenated = array.add(Value(std::make_shared<ArrayObject>(std::vector<Value>())));
+
+    // Modifying a copy copies its elements first
+    copy.as<ArrayObject>()->subscript_update(Value::from_int(0), Value::from_int(5));
+    duplicate.as<ArrayObject>()->subscript_update(Value::from_int(1), Value::from_int(6));
+    CHECK_EQ(array.cast(TYPE_STRING).as<StringObject>()->get_value(), "[1, a]");
+    CHECK_EQ(copy.cast(TYPE_STRING).as<StringObject>()->get_value(), "[5, a]");
+    CHECK_EQ(duplicate.cast(TYPE_STRING).as<StringObject>()->get_value(), "[1, 6]");
+    CHECK(concatenated.equal(array).get_bool());
+
+    // Nested arrays are still duplicated when an array is repeated
+    Value nested(std::make_shared<ArrayObject>(std::vector<Value>{array}));
+    Value repeated = nested.as<ArrayObject>()->repeat(2);
+    repeated.subscript(Value::from_int(0)).as<ArrayObject>()->subscript_update(
+        Value::from_int(0), Value::from_int(7));
+    CHECK_EQ(repeated.cast(TYPE_STRING).as<StringObject>()->get_value(), "[[7, a], [1, a]]");
+    CHECK_EQ(array.cast(TYPE_STRING).as<StringObject>()->get_value(), "[1, a]");
+}
+
+TEST_CASE("Array slices") {
+    Value array(std::make_shared<ArrayObject>(
+        std::vector<Value>{Value::from_int(1), Value::from_int(2), Value::from_int(3)}));
+    auto as_string = [](const Value &value) {
+        return std::string(value.cast(TYPE_STRING).as<StringObject>()->get_value());
+    };
+
+    CHECK_EQ(as_string(array.slice(Value::from_int(1), Value::from_int(2))), "[2, 3]");
+    CHECK_EQ(as_string(array.slice(Value::from_int(2), Value::from_int(0))), "[3, 2, 1]");
+    CHECK_FALSE(array.slice(Value::from_int(1), Value::from_int(3)).is_defined());
+    CHECK_FALSE(array.slice(Value::from_int(0), Value::from_float(1.0f)).is_defined());
+
+    // A slice of part of an array copies its elements, and a slice of the whole array shares them
+    // until either is modified
+    Value part = array.slice(Value::from_int(0), Value::from_int(1));
+    Value whole = array.slice(Value::from_int(0), Value::from_int(2));
+    part.as<ArrayObject>()->subscript_update(Value::from_int(0), Value::from_int(5));
+    whole.as<ArrayObject>()->subscript_update(Value::from_int(1), Value::from_int(6));
+    CHECK_EQ(as_string(part), "[5, 2]");
+    CHECK_EQ(as_string(whole), "[1, 6, 3]");
+    CHECK_EQ(as_string(array), "[1, 2, 3]");
+
+    // Slices of ranges stay lazy
+    Value range_slice = Value(ArrayObject::from_range(10, 0)).slice(Value::from_int(2),
+                                                                    Value::from_int(4));
+    CHECK(range_slice.as<ArrayObject>()->is_range());
+    CHECK_EQ(as_string(range_slice), "[8, 7, 6]");
+
+    // Growing an array in place
+    array.as<ArrayObject>()->push(Value::from_int(4));
+    CHECK_EQ(array.as<ArrayObject>()->get_len(), 4);
+}
+
+TEST_CASE("Arrays of numbers are packed") {
+    auto as_string = [](const Value &value) {
+        return std::string(value.cast(TYPE_STRING).as<StringObject>()->get_value());
+    };
+    Value ints(std::make_shared<ArrayObject>(
+        std::vector<Value>{Value::from_int(1), Value::from_int(2), Value::from_int(3)}));
+    Value floats(std::make_shared<ArrayObject>(
+        std::vector<Value>{Value::from_float(0.5f), Value::from_float(1.25f)}));
+    auto *int_array = ints.as<ArrayObject>();
+    auto *float_array = floats.as<ArrayObject>();
+
+    CHECK_EQ(int_array->get_storage(), ArrayObject::STORAGE_INTS);
+    CHECK_EQ(float_array->get_storage(), ArrayObject::STORAGE_FLOATS);
+    CHECK_EQ(as_string(floats), "[0.5, 1.25]");
+    CHECK_EQ(int_array->packed_sum().get_int(), 6);
+    CHECK_EQ(float_array->packed_product().get_float(), 0.625f);
+    CHECK(ints.equal(Value(ArrayObject::from_range(1, 3))).get_bool());
+
+    // Operations keep the elements packed
+    CHECK_EQ(ints.add(ints).as<ArrayObject>()->get_storage(), ArrayObject::STORAGE_INTS);
+    CHECK_EQ(floats.multiply(Value::from_int(3)).as<ArrayObject>()->get_storage(),
+             ArrayObject::STORAGE_FLOATS);
+    CHECK_EQ(float_array->repeat(3).as<ArrayObject>()->get_storage(), ArrayObject::STORAGE_FLOATS);
+    CHECK_EQ(ints.add(floats).as<ArrayObject>()->get_storage(), ArrayObject::STORAGE_VALUES);
+    CHECK_EQ(as_string(ints.add(floats)), "[1, 2, 3, 0.5, 1.25]");
+
+    // An empty array takes the type of its first element
+    Value empty(std::make_shared<ArrayObject>(std::vector<Value>()));
+    empty.as<ArrayObject>()->push(Value::from_float(2.0f));
+    CHECK_EQ(empty.as<ArrayObject>()->get_storage(), ArrayObject::STORAGE_FLOATS);
+
+    // Storing an element of another type converts the array to values, keeping its elements
+    Value copy = ints.cast(TYPE_ARRAY);
+    int_array->push(Value::from_int(4));
+    int_array->subscript_update(Value::from_int(0), Value::from_float(1.5f));
+    CHECK_EQ(int_array->get_storage(), ArrayObject::STORAGE_VALUES);
+    CHECK_FALSE(int_array->packed_sum().is_defined());
+    CHECK_EQ(as_string(ints), "[1.5, 2, 3, 4]");
+    CHECK_EQ(as_string(copy), "[1, 2, 3]");
+    CHECK_EQ(copy.as<ArrayObject>()->get_storage(), ArrayObject::STORAGE_INTS);
+}
+
+TEST_CASE("Array element-wise operators") {
+    auto as_string = [](const Value &value) {
+        return std::string(value.cast(TYPE_STRING).as<StringObject>()->get_value());
+    };
+    std::vector<int> many(1000);
+    for (int i = 0; i < 1000; i++) {
+        many[i] = i - 500;
+    }
+    Value ints(std::make_shared<ArrayObject>(std::move(many)));
+    Value floats(std::make_shared<ArrayObject>(
+        std::vector<Value>{Value::from_float(0.5f), Value::from_float(-2.0f)}));
+    Value pair(std::make_shared<ArrayObject>(
+        std::vector<Value>{Value::from_int(3), Value::from_int(4)}));
+
+    // Long arrays go through the vectorized loops, which must match single values
+    Value scalar = Value::from_int(7);
+    std::vector<std::pair<TokenType, Value>> operations = {
+        {ADDITION_OPERATOR, scalar},       {SUBTRACTION_OPERATOR, scalar},
+        {MULTIPLICATIVE_OPERATOR, ints},   {BITWISE_XOR_OPERATOR, ints},
+        {LESS_THAN_OPERATOR, scalar},      {GREATER_THAN_EQUAL_OPERATOR, ints},
+        {DIVISION_OPERATOR, scalar},       {MOD_OPERATOR, Value::from_int(-3)},
+    };
+    for (const auto &[op, right] : operations) {
+        CAPTURE(op);
+        Value result = apply_binary_operator(to_binary_operator(op), ints, right);
+        REQUIRE(result.is_defined());
+        for (int i = 0; i < 1000; i++) {
+            Value element = ints.subscript(Value::from_int(i));
+            Value right_element = right.get_type() == TYPE_ARRAY ? element : right;
+            Value expected =
+                apply_binary_operator(to_binary_operator(op), element, right_element);
+            CHECK(result.subscript(Value::from_int(i)).equal(expected).get_bool());
+        }
+    }
+
+    // A single value on the left is applied to every element as the left operand
+    for (TokenType op : {SUBTRACTION_OPERATOR, BITWISE_OR_OPERATOR, LESS_THAN_OPERATOR,
+                         GREATER_THAN_EQUAL_OPERATOR}) {
+        CAPTURE(op);
+        Value result = apply_binary_operator(to_binary_operator(op), scalar, ints);
+        REQUIRE(result.is_defined());
+        for (int i = 0; i < 1000; i++) {
+            Value element = ints.subscript(Value::from_int(i));
+            Value expected = apply_binary_operator(to_binary_operator(op), scalar, element);
+            CHECK(result.subscript(Value::from_int(i)).equal(expected).get_bool());
+        }
+    }
+
+    CHECK_EQ(as_string(pair.multiply(floats)), "[1.5, -8]");
+    CHECK_EQ(as_string(apply_binary_operator(BINARY_DIVIDE, Value::from_int(12), pair)),
+             "[4, 3]");
+    CHECK_EQ(as_string(apply_binary_operator(BINARY_SUBTRACT, Value::from_int(1), floats)),
+             "[0.5, 3]");
+    CHECK_EQ(as_string(apply_binary_operator(BINARY_LESS_THAN, Value::from_int(3), pair)),
+             "[false, true]");
+    CHECK_EQ(as_string(floats.divide(Value::from_int(2))), "[0.25, -1]");
+    CHECK_EQ(as_string(pair.modulo(Value::from_int(2))), "[1, 0]");
+    CHECK_EQ(as_string(floats.less_than(pair)), "[true, true]");
+
+    // Adding arrays concatenates them, and multiplying by an int or a float multiplies every
+    // element
+    CHECK_EQ(as_string(pair.add(pair)), "[3, 4, 3, 4]");
+    CHECK_EQ(as_string(pair.multiply(Value::from_int(2))), "[6, 8]");
+    CHECK_EQ(as_string(pair.multiply(Value::from_float(0.5f))), "[1.5, 2]");
+    CHECK_EQ(as_string(apply_binary_operator(BINARY_MULTIPLY, Value::from_int(2), pair)),
+             "[6, 8]");
+    CHECK_EQ(as_string(pair.as<ArrayObject>()->repeat(2)), "[3, 4, 3, 4]");
+
+    // Invalid operations on any element are invalid for the array
+    CHECK_FALSE(pair.subtract(floats.add(floats)).is_defined());
+    CHECK_FALSE(pair.divide(Value::from_int(0)).is_defined());
+    CHECK_FALSE(apply_binary_operator(BINARY_DIVIDE, scalar, ints).is_defined());
+    CHECK_FALSE(apply_binary_operator(BINARY_MODULO, Value::from_float(1.0f), pair).is_defined());
+    CHECK_FALSE(floats.modulo(Value::from_int(2)).is_defined());
+    CHECK_FALSE(pair.subtract(Value(std::make_shared<StringObject>("a"))).is_defined());
+}
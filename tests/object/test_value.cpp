@@ -0,0 +1,167 @@
+#include "object/array_object.h"
+#include "object/string_object.h"
+#include "object/value.h"
+#include "operators.h"
+#include <climits>
+#include <doctest/doctest.h>
+
+TEST_CASE("Value inline arithmetic") {
+    Value two = Value::from_int(2);
+    Value half = Value::from_float(0.5f);
+
+    // Ints stay ints, and mixing with a float gives a float
+    Value sum = two.add(Value::from_int(3));
+    CHECK_EQ(sum.get_type(), TYPE_INT);
+    CHECK_EQ(sum.get_int(), 5);
+    CHECK_EQ(sum.get_object(), nullptr);
+
+    Value product = two.multiply(half);
+    CHECK_EQ(product.get_type(), TYPE_FLOAT);
+    CHECK_EQ(product.get_float(), 1.0f);
+
+    Value less = half.less_than(two);
+    CHECK_EQ(less.get_type(), TYPE_BOOL);
+    CHECK(less.get_bool());
+
+    CHECK_EQ(two.modulo(Value::from_int(2)).get_int(), 0);
+    CHECK_EQ(two.negative().get_int(), -2);
+}
+
+TEST_CASE("Value invalid operations are undefined") {
+    Value number = Value::from_int(1);
+    Value flag = Value::from_bool(true);
+
+    CHECK_FALSE(Value().is_defined());
+    CHECK_FALSE(number.add(flag).is_defined());
+    CHECK_FALSE(number.equal(flag).is_defined());
+    CHECK_FALSE(number.logical_and(flag).is_defined());
+    CHECK_FALSE(flag.logical_and(number).is_defined());
+    CHECK_FALSE(Value::from_float(1.0f).modulo(number).is_defined());
+    CHECK_FALSE(number.divide(Value::from_int(0)).is_defined());
+    CHECK_FALSE(number.modulo(Value::from_int(0)).is_defined());
+    CHECK_FALSE(Value::from_int(INT_MIN).divide(Value::from_int(-1)).is_defined());
+    CHECK_FALSE(apply_int_operator(BINARY_MODULO, INT_MIN, -1).is_defined());
+    CHECK_FALSE(number.subscript(number).is_defined());
+}
+
+TEST_CASE("Value casts and objects") {
+    Value text = Value::from_int(42).cast(TYPE_STRING);
+    REQUIRE_EQ(text.get_type(), TYPE_STRING);
+    CHECK_EQ(text.as<StringObject>()->get_value(), "42");
+    CHECK_EQ(Value::from_bool(false).cast(TYPE_STRING).as<StringObject>()->get_value(), "false");
+    CHECK_EQ(text.cast(TYPE_INT).get_int(), 42);
+
+    // Operations on objects are delegated to the object
+    Value array(std::make_shared<ArrayObject>(
+        std::vector<Value>{Value::from_int(1), Value::from_bool(false)}));
+    CHECK_EQ(array.get_type(), TYPE_ARRAY);
+    CHECK_EQ(array.cast(TYPE_STRING).as<StringObject>()->get_value(), "[1, false]");
+    CHECK(array.equal(array.duplicate()).get_bool());
+    CHECK_FALSE(array.subscript(Value::from_int(2)).is_defined());
+    CHECK_FALSE(text.subscript(Value::from_int(5)).is_defined());
+}
+
+TEST_CASE("Value iteration") {
+    Value text(std::make_shared<StringObject>("aba"));
+    Value array(std::make_shared<ArrayObject>(
+        std::vector<Value>{Value::from_int(1), Value::from_bool(false)}));
+    Value element;
+
+    // The characters of a string are interned (on first use), so iterating does not allocate
+    StringObject::from_char('a');
+    size_t created = Object::get_created_count();
+    REQUIRE(text.get_object()->iterate(0, element));
+    CHECK_EQ(element.as<StringObject>()->get_value(), "a");
+    REQUIRE(text.get_object()->iterate(2, element));
+    CHECK_EQ(element.get_object(), text.subscript(Value::from_int(0)).get_object());
+    CHECK_FALSE(text.get_object()->iterate(3, element));
+    CHECK_EQ(Object::get_created_count(), created);
+
+    REQUIRE(array.get_object()->iterate(1, element));
+    CHECK_EQ(element.get_type(), TYPE_BOOL);
+    CHECK_FALSE(array.get_object()->iterate(2, element));
+    CHECK(ArrayObject::from_range(3, 1)->iterate(2, element));
+    CHECK_EQ(element.get_int(), 1);
+}
+
+TEST_CASE("Value string appends") {
+    Value empty(std::make_shared<StringObject>(""));
+    Value a = empty.add(Value(std::make_shared<StringObject>("ab")));
+    Value b = a.add(StringObject::from_char('c'));
+
+    // The strings share a buffer, but each keeps its own characters
+    Value c = a.add(StringObject::from_char('d'));
+    Value d = b.add(b);
+    CHECK_EQ(empty.as<StringObject>()->get_value(), "");
+    CHECK_EQ(a.as<StringObject>()->get_value(), "ab");
+    CHECK_EQ(b.as<StringObject>()->get_value(), "abc");
+    CHECK_EQ(c.as<StringObject>()->get_value(), "abd");
+    CHECK_EQ(d.as<StringObject>()->get_value(), "abcabc");
+    CHECK(b.duplicate().equal(b).get_bool());
+    CHECK_FALSE(b.add(Value::from_int(1)).is_defined());
+
+    // Building a string in a loop appends to the same buffer
+    Value text(std::make_shared<StringObject>(""));
+    for (int i = 0; i < 1000; i++) {
+        text = text.add(StringObject::from_char((char)('a' + i % 26)));
+    }
+    CHECK_EQ(text.as<StringObject>()->get_len(), 1000);
+    CHECK_EQ(text.subscript(Value::from_int(27)).as<StringObject>()->get_value(), "b");
+    CHECK(text.as<StringObject>()->is_appendable());
+
+    // Interned characters and literals are copied rather than appended to, as they stay shared
+    const Value &character = StringObject::from_char('x');
+    Value literal(StringObject::from_string_literal("\"lit\""));
+    CHECK_FALSE(character.as<StringObject>()->is_appendable());
+    CHECK_FALSE(literal.as<StringObject>()->is_appendable());
+    Value joined = character.add(literal).add(character);
+    CHECK_EQ(joined.as<StringObject>()->get_value(), "xlitx");
+    CHECK_EQ(character.as<StringObject>()->get_value(), "x");
+    CHECK_EQ(literal.add(character).as<StringObject>()->get_value(), "litx");
+}
+
+TEST_CASE("Value operator kernel tables") {
+    Value values[] = {Value::from_int(6),
+                      Value::from_float(1.5f),
+                      Value::from_bool(true),
+                      Value(std::make_shared<StringObject>("ab")),
+                      Value::make_void(),
+                      Value(std::make_shared<ArrayObject>(std::vector<int>{1, 2})),
+                      Value()};
+
+    // Every operator has a kernel for every pair of types, which returns a value of the type the
+    // operator gives, or an undefined value (comparisons with arrays compare every element)
+    for (int op = 0; op < BINARY_OPERATOR_COUNT; op++) {
+        for (const Value &left : values) {
+            for (const Value &right : values) {
+                Value result = apply_binary_operator((BinaryOperator)op, left, right);
+                if (result.is_defined() && op >= BINARY_LESS_THAN && left.get_object() == nullptr &&
+                    right.get_type() != TYPE_ARRAY) {
+                    CHECK_EQ(result.get_type(), TYPE_BOOL);
+                }
+            }
+        }
+    }
+
+    CHECK_EQ(apply_binary_operator(BINARY_MODULO, values[0], Value::from_int(4)).get_int(), 2);
+    CHECK_EQ(apply_binary_operator(BINARY_SUBTRACT, values[1], values[0]).get_float(), -4.5f);
+    CHECK(apply_binary_operator(BINARY_GREATER_THAN_EQUAL, values[0], values[1]).get_bool());
+    CHECK(apply_binary_operator(BINARY_LOGICAL_OR, values[2], values[2]).get_bool());
+    CHECK_FALSE(apply_binary_operator(BINARY_BITWISE_AND, values[1], values[0]).is_defined());
+    CHECK_FALSE(apply_binary_operator(BINARY_EQUAL, values[4], values[4]).is_defined());
+    Value text = apply_binary_operator(BINARY_ADD, values[3], values[3]);
+    REQUIRE_EQ(text.get_type(), TYPE_STRING);
+    CHECK_EQ(text.as<StringObject>()->get_value(), "abab");
+    CHECK(apply_binary_operator(BINARY_EQUAL, values[5], values[5]).get_bool());
+    CHECK_EQ(apply_binary_operator(BINARY_LESS_THAN, values[0], values[5]).get_type(), TYPE_ARRAY);
+
+    CHECK_EQ(apply_unary_operator(UNARY_BITWISE_NOT, values[0]).get_int(), -7);
+    CHECK_EQ(apply_unary_operator(UNARY_POSITIVE, values[1]).get_float(), 1.5f);
+    CHECK_FALSE(apply_unary_operator(UNARY_NEGATIVE, values[2]).is_defined());
+    CHECK_FALSE(apply_unary_operator(UNARY_LOGICAL_NOT, values[6]).is_defined());
+
+    // Operator tokens are resolved to their operator once
+    CHECK_EQ(to_binary_operator(MOD_OPERATOR), BINARY_MODULO);
+    CHECK_EQ(to_binary_operator(LOGICAL_NOT_OPERATOR), BINARY_OPERATOR_COUNT);
+    CHECK_EQ(to_unary_operator(SUBTRACTION_OPERATOR), UNARY_NEGATIVE);
+}
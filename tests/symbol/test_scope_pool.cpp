@@ -0,0 +1,41 @@
+#include "symbol/scope_pool.h"
+#include <doctest/doctest.h>
+
+TEST_CASE("Scope pool reuses released tables") {
+    ScopePool pool;
+    SymbolTable global_table(nullptr);
+
+    // Tables are allocated while scopes are nested
+    SymbolTable *outer = pool.acquire(&global_table, true, false);
+    SymbolTable *inner = pool.acquire(outer, outer->is_loop(), true);
+    CHECK_EQ(pool.get_allocated_size(), 2);
+    CHECK_EQ(inner->get_scope(1), outer);
+    CHECK_EQ(inner->get_global_scope(), &global_table);
+    CHECK(inner->is_loop());
+    CHECK(inner->is_function());
+
+    // Released tables are reused instead of allocating new ones
+    inner->set_slot(0, Value::from_int(1));
+    pool.release(inner);
+    SymbolTable *reused = pool.acquire(outer);
+    CHECK_EQ(reused, inner);
+    CHECK_FALSE(reused->get_slot(0).is_defined());
+    CHECK_FALSE(reused->is_loop());
+    CHECK_EQ(pool.get_allocated_size(), 2);
+
+    pool.release(reused);
+    pool.release(outer);
+}
+
+TEST_CASE("Scope pool bounds tables of repeated scopes") {
+    ScopePool pool;
+    SymbolTable global_table(nullptr);
+
+    // Entering the same scopes many times only allocates a table per level of nesting
+    for (int i = 0; i < 1000; i++) {
+        PooledScope loop_scope(&pool, &global_table, true);
+        PooledScope block_scope(&pool, loop_scope.get(), true);
+        block_scope.get()->set_slot(i % 3, Value::from_int(i));
+    }
+    CHECK_EQ(pool.get_allocated_size(), 2);
+}
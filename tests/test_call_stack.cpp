@@ -0,0 +1,23 @@
+#include "call_stack.h"
+#include <doctest/doctest.h>
+#include <functional>
+
+TEST_CASE("Call stack reports exhaustion before overflowing") {
+    CallStack stack(16);
+
+    // Recursing until the stack is exhausted stops within the space reserved for the calls and the
+    // frames before them (each frame takes more than a kilobyte)
+    int depth = 0;
+    std::function<void()> recurse = [&]() {
+        volatile char frame[1024] = {};
+        frame[0] = 1;
+        if (!stack.is_exhausted()) {
+            depth++;
+            recurse();
+            frame[1] = frame[0]; // Keeps the call from being a tail call
+        }
+    };
+    stack.run(recurse);
+    CHECK_GT(depth, 0);
+    CHECK_LE(depth, (16 * (int)CallStack::BYTES_PER_CALL + (int)CallStack::BASE_SIZE) / 1024);
+}
@@ -66,9 +66,10 @@ TEST_CASE("ErrorManager error at pos") {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    // Set file lines
-    std::vector<std::string> lines = {"line 1\n", "line 2\n", "line 3\n"};
-    error_manager.set_file_lines(lines);
+    // Set file source
+    SourceBuffer source;
+    source.assign("line 1\nline 2\nline 3\n");
+    error_manager.set_source(&source);
 
     // Add an error message at a position.
     stream_redirect.run([&]() { error_manager.error_at_pos("Error message", 1, 2, false); });
@@ -117,9 +118,10 @@ TEST_CASE("ErrorManager runtime error") {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    // Set file lines
-    std::vector<std::string> lines = {"line 1\n", "line 2\n", "line 3\n"};
-    error_manager.set_file_lines(lines);
+    // Set file source
+    SourceBuffer source;
+    source.assign("line 1\nline 2\nline 3\n");
+    error_manager.set_source(&source);
 
     // Add a runtime error message.
     stream_redirect.run([&]() {
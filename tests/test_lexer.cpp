@@ -2,6 +2,86 @@
 #include "tokens.h"
 #include "utils/stream_redirect.h"
 #include <doctest/doctest.h>
+#include <random>
+#include <regex>
+
+/**
+ * @brief Tokenize code with the regexes of the tokens, as the lexer used to.
+ * @param code The code to be parsed.
+ * @return The tokens, including escaped new lines and the end of file token.
+ */
+static std::vector<Token> regex_tokens(const std::string &code) {
+    // Line and line start of each character, where escaped new lines don't start a new line
+    std::vector<int> lines(code.size() + 1), line_starts(code.size() + 1);
+    int line = 1, line_start = 0;
+    for (size_t i = 0; i <= code.size(); i++) {
+        lines[i] = line;
+        line_starts[i] = line_start;
+        if (i < code.size() && code[i] == '\n' && !(i != 0 && code[i - 1] == '\\')) {
+            line++;
+            line_start = (int)i + 1;
+        }
+    }
+
+    std::string token_regex;
+    for (auto &token_expr : token_regexs) {
+        token_regex += "(" + token_expr.second + ")|";
+    }
+    token_regex.pop_back();
+
+    std::vector<Token> tokens;
+    std::regex reg(token_regex);
+    std::smatch match;
+    auto start = code.cbegin();
+    while (std::regex_search(start, code.cend(), match, reg)) {
+        for (size_t i = 1; i < match.size(); i++) {
+            if (match[i].length() > 0) {
+                int position = (int)(match[i].second - code.cbegin()) - 1;
+                size_t offset = match[i].first - code.cbegin();
+                tokens.emplace_back(token_regexs[i - 1].first,
+                                    std::string_view(code).substr(offset, match[i].length()),
+                                    lines[position],
+                                    position - line_starts[position] + 1);
+                start = match[i].second;
+                break;
+            }
+        }
+    }
+    tokens.emplace_back(END_OF_FILE,
+                        "",
+                        lines[code.size()],
+                        (int)code.size() - line_starts[code.size()] + 1);
+
+    return tokens;
+}
+
+/**
+ * @brief Check that the lexer produces the same tokens as the token regexes.
+ * @param code The code to be parsed.
+ */
+static void check_matches_regex_tokens(const std::string &code) {
+    ErrorManager error_manager;
+    StreamRedirect stream_redirect;
+    Lexer lexer(code, &error_manager);
+    std::vector<Token> tokens;
+    stream_redirect.run([&]() { tokens = lexer.parse_tokens(); });
+
+    std::vector<Token> expected;
+    int undefined_count = 0;
+    for (auto &token : regex_tokens(code)) {
+        undefined_count += token.type == UNDEFINED;
+        if (token.type != ESCAPED_NEW_LINE) {
+            expected.push_back(token);
+        }
+    }
+
+    CAPTURE(code);
+    REQUIRE_EQ(tokens.size(), expected.size());
+    for (size_t i = 0; i < tokens.size(); i++) {
+        CHECK_EQ(tokens[i], expected[i]);
+    }
+    CHECK_EQ(error_manager.get_error_count(), undefined_count);
+}
 
 TEST_CASE("Lexer simple arithmetic") {
     ErrorManager error_manager;
@@ -175,6 +255,66 @@ TEST_CASE("Lexer newlines") {
     CHECK_FALSE(error_manager.check_error());
 }
 
+TEST_CASE("Lexer comments") {
+    ErrorManager error_manager;
+    StreamRedirect stream_redirect;
+
+    std::string comments =
+        "# This is commented\n"
+        "# Comment\n"
+        "Single-line comments end after the line\n"
+        "## Multi-line comments\n"
+        "can span\n"
+        "multiple lines ##\n"
+        "They can also ## occur in the middle of a ## line\n"
+        "But \"## no comments\" ## should occur in uncommented \"string literals ##\"\"\n"
+        "Even \"# these ones\" # this works though\n"
+        "##\n"
+        "Multi-line comment\n"
+        "# Comment within multi-line comment\n"
+        "Still multi-line comment \\\n"
+        "##\n"
+        "# Comment ## Multi-line comment\n"
+        "Not a comment @#undefined\n"
+        "escaped \\ # new line\n"
+        "## Tabs: \"	\", Spaces: \" \", and newlines: \"\n"
+        "\" are preserved in comments ##\n";
+
+    // Comments are skipped as if they were whitespace (keeping the new lines)
+    std::string comments_clean =
+        "                   \n"
+        "         \n"
+        "Single-line comments end after the line\n"
+        "                      \n"
+        "        \n"
+        "                 \n"
+        "They can also                                line\n"
+        "But \"## no comments\"                                                   \"\"\n"
+        "Even \"# these ones\"                    \n"
+        "  \n"
+        "                  \n"
+        "                                   \n"
+        "                          \n"
+        "  \n"
+        "                               \n"
+        "Not a comment @          \n"
+        "escaped \\           \n"
+        "          	                               \n"
+        "                              \n";
+
+    std::vector<Token> tokens, clean_tokens;
+    stream_redirect.run([&]() {
+        tokens = Lexer(comments, &error_manager).parse_tokens();
+        clean_tokens = Lexer(comments_clean, &error_manager).parse_tokens();
+    });
+
+    REQUIRE_EQ(tokens.size(), clean_tokens.size());
+    for (size_t i = 0; i < tokens.size(); i++) {
+        CHECK_EQ(tokens[i], clean_tokens[i]);
+    }
+    CHECK_EQ(tokens.back(), Token(TokenType::END_OF_FILE, "", 20, 1));
+}
+
 TEST_CASE("Lexer syntax") {
     ErrorManager error_manager;
     Lexer lexer("(){}[],({[, ,,]}){\n}", &error_manager);
@@ -227,3 +367,37 @@ TEST_CASE("Lexer identifiers") {
     CHECK_EQ(tokens[11], Token(TokenType::END_OF_FILE, "", 2, 12));
     CHECK_FALSE(error_manager.check_error());
 }
+
+TEST_CASE("Lexer matches token regexes") {
+    // Edge cases of the token regexes
+    std::vector<std::string> programs = {
+        "a <- 1..10\nfor i in a {output(i * 2.5)}",
+        "12and 1.5or 3for x 4int",
+        "andx xand and_ _and 1.2.3 1..2 1. .5 ..",
+        "<-<=<>=>!=!= = ! !a @foo(1) a@b",
+        "\"abc\" \"a\\\"b\" \"unterminated \"esc\\\nline\" \"multi\nline\" \"\\",
+        "x \\  \n y \\ z \\\n\\",
+        "\"cr\\\r\" \"\\\\\" x\"",
+        "tab\there\r\nwindows\r\n\t\"\t\"",
+        "truefalse true false_ if2 \xc3\xa9t\xc3\xa9 f\xc3\xa9",
+        "",
+    };
+    for (const std::string &program : programs) {
+        check_matches_regex_tokens(program);
+    }
+
+    // Random code built from fragments of tokens
+    std::vector<std::string> fragments = {
+        "a", "_", "1", "0.", ".", "\"", "\\", " ", "\t", "\n", "\r", "<", "-", "=", "!", ">",
+        "and", "for", "in", "int", "true", "x2", "(", "]", ",", "@", "~", "|", "%", "\xff",
+    };
+    std::mt19937 random(42);
+    for (int i = 0; i < 500; i++) {
+        std::string program;
+        int length = (int)(random() % 40);
+        for (int j = 0; j < length; j++) {
+            program += fragments[random() % fragments.size()];
+        }
+        check_matches_regex_tokens(program);
+    }
+}
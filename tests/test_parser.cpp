@@ -727,3 +727,24 @@ TEST_CASE("Parser array indexing") {
 
     CHECK_FALSE(error_manager.check_error());
 }
+
+TEST_CASE("Parser array slicing") {
+    ErrorManager error_manager;
+    std::vector<Token> tokens = lex_tokens(&error_manager, "test_parser", "b <- a[1..n - 1][0]");
+    Parser parser(tokens, &error_manager);
+
+    ProgramNode *program = parser.parse_program();
+    REQUIRE_NE(program, nullptr);
+    REQUIRE_EQ(program->get_statements_size(), 1);
+
+    auto *assignment = try_cast<AssignmentNode>(program->get_statement(0));
+    auto *subscript = try_cast<SubscriptOpNode>(assignment->get_value());
+    auto *slice = try_cast<SliceOpNode>(subscript->get_identifier());
+    CHECK_EQ(try_cast<IdentifierNode>(slice->get_identifier())->get_name(), "a");
+    CHECK_EQ(try_cast<LiteralNode>(slice->get_start())->get_value(), "1");
+    auto *end = try_cast<BinOpNode>(slice->get_end());
+    CHECK_EQ(end->get_op(), SUBTRACTION_OPERATOR);
+    CHECK_EQ(try_cast<LiteralNode>(subscript->get_index())->get_value(), "0");
+
+    CHECK_FALSE(error_manager.check_error());
+}
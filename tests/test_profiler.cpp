@@ -0,0 +1,167 @@
+#include "error_manager.h"
+#include "profiler.h"
+#include "utils/shortcuts.h"
+#include "utils/stream_redirect.h"
+#include "visitor/interpreter_visitor.h"
+#include <doctest/doctest.h>
+#include <sstream>
+
+TEST_CASE("Profiler counts function calls and lines") {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "square <- function(x) {\n"
+                                        "    return x * x\n"
+                                        "}\n"
+                                        "total <- 0\n"
+                                        "for i in 1..10 {\n"
+                                        "    total <- total + square(i)\n"
+                                        "}\n"
+                                        "output(string(total))\n");
+    REQUIRE_FALSE(error_manager.check_error());
+
+    Profiler profiler;
+    InterpreterVisitor visitor(root, &error_manager);
+    visitor.set_profiler(&profiler);
+    stream_redirect.run([&]() { visitor.interpret(); });
+    profiler.finish();
+
+    // Each function is counted per call, including the top-level code and built-ins
+    auto &functions = profiler.get_functions();
+    REQUIRE_EQ(functions.count("square"), 1);
+    CHECK_EQ(functions.at("square").count, 10);
+    CHECK_EQ(functions.at(Profiler::MAIN_FUNCTION).count, 1);
+    CHECK_EQ(functions.at("output").count, 1);
+
+    // Inclusive time of the top-level code covers its callees
+    const Profiler::Entry &main_entry = functions.at(Profiler::MAIN_FUNCTION);
+    CHECK_GE(main_entry.inclusive_ns, main_entry.exclusive_ns);
+    CHECK_GE(main_entry.inclusive_ns, functions.at("square").inclusive_ns);
+
+    // Each line is counted per evaluated statement
+    auto &lines = profiler.get_lines();
+    CHECK_EQ(lines.at(1).count, 1);
+    CHECK_EQ(lines.at(2).count, 10);
+    CHECK_EQ(lines.at(6).count, 10);
+    CHECK_EQ(lines.at(8).count, 1);
+
+    // Ints are inline values, and strings are objects
+    CHECK_EQ(lines.at(4).allocations, 0);
+    CHECK_GT(lines.at(8).allocations, 0);
+
+    SourceBuffer source;
+    source.assign("square <- function(x) {\n    return x * x\n");
+    std::ostringstream report;
+    profiler.report(report, source);
+    CHECK_NE(report.str().find("2: return x * x"), std::string::npos);
+
+    delete root;
+}
+
+TEST_CASE("Profiler charges tail calls to the line of the call") {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "count <- function(n, total) {\n"
+                                        "    if n = 0 {\n"
+                                        "        return total\n"
+                                        "    }\n"
+                                        "    return count(n - 1, total + n)\n"
+                                        "}\n"
+                                        "x <- count(100000, 0)\n");
+    REQUIRE_FALSE(error_manager.check_error());
+
+    Profiler profiler;
+    InterpreterVisitor visitor(root, &error_manager);
+    visitor.set_profiler(&profiler);
+    stream_redirect.run([&]() { visitor.interpret(); });
+    profiler.finish();
+
+    // Each tail call replaces the call before it
+    auto &functions = profiler.get_functions();
+    CHECK_EQ(functions.at("count").count, 100001);
+    CHECK_GE(functions.at("count").exclusive_ns,
+             functions.at(Profiler::MAIN_FUNCTION).exclusive_ns);
+
+    // Starting each callee is charged to the tail call, not to the statement that started the
+    // chain or to the line the function is declared on (which is only run by the assignment)
+    auto &lines = profiler.get_lines();
+    CHECK_EQ(lines.at(1).count, 1);
+    CHECK_EQ(lines.at(2).count, 100001);
+    CHECK_EQ(lines.at(5).count, 100000);
+    CHECK_EQ(lines.at(7).count, 1);
+    CHECK_GE(lines.at(7).inclusive_ns, lines.at(5).inclusive_ns);
+    CHECK_LT(lines.at(7).exclusive_ns, lines.at(5).exclusive_ns);
+    CHECK_LT(lines.at(1).exclusive_ns, lines.at(5).exclusive_ns);
+
+    // Each table is labelled by its header alone
+    SourceBuffer source;
+    source.assign("count <- function(n, total) {\n");
+    std::ostringstream report;
+    profiler.report(report, source);
+    std::string text = report.str();
+    CHECK_NE(text.find("Allocs  Function\n"), std::string::npos);
+    CHECK_NE(text.find("Allocs  Line\n"), std::string::npos);
+    CHECK_EQ(text.find("\nFunction\n"), std::string::npos);
+    CHECK_EQ(text.find("\nLine\n"), std::string::npos);
+    CHECK_NE(text.rfind("Function\n", 0), 0);
+
+    delete root;
+}
+
+TEST_CASE("Profiler folded stacks") {
+    Profiler profiler;
+    profiler.enter_function(Profiler::MAIN_FUNCTION);
+    profiler.enter_function("f");
+    profiler.enter_function("g");
+
+    // Unfinished calls are ended by finish
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(2)) {
+    }
+    profiler.finish();
+
+    std::ostringstream folded;
+    profiler.write_folded_stacks(folded);
+    CHECK_NE(folded.str().find("<main>;f;g "), std::string::npos);
+    CHECK_EQ(profiler.get_functions().at("f").count, 1);
+    CHECK_LT(profiler.get_functions().at("f").exclusive_ns,
+             profiler.get_functions().at("f").inclusive_ns);
+}
+
+TEST_CASE("Profiler folded stacks of repeated and recursive calls") {
+    Profiler profiler;
+    auto busy = []() {
+        auto start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(1)) {
+        }
+    };
+
+    profiler.enter_function(Profiler::MAIN_FUNCTION);
+    for (int i = 0; i < 3; i++) {
+        profiler.enter_function("g");
+        busy();
+        profiler.exit_function();
+    }
+    for (int i = 0; i < 3; i++) {
+        profiler.enter_function("f");
+    }
+    busy();
+    profiler.finish();
+
+    // Repeated calls share their stack, and stacks are written in order of their names
+    std::ostringstream folded;
+    profiler.write_folded_stacks(folded);
+    std::string text = folded.str();
+    size_t recursive = text.find("<main>;f;f;f ");
+    size_t repeated = text.find("<main>;g ");
+    REQUIRE_NE(recursive, std::string::npos);
+    REQUIRE_NE(repeated, std::string::npos);
+    CHECK_LT(recursive, repeated);
+    CHECK_EQ(text.find("<main>;g ", repeated + 1), std::string::npos);
+    CHECK_GE(std::stoll(text.substr(text.find(' ', repeated) + 1)), 3000);
+}
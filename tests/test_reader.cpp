@@ -17,61 +17,28 @@ TEST_CASE("Reader invalid file") {
     CHECK_EQ(stream_redirect.get_string(), "Error: File '" + filename + "' does not exist\n");
 }
 
-TEST_CASE("Reader comments") {
+TEST_CASE("Reader contents") {
     ErrorManager error_manager;
     StreamRedirect stream_redirect;
 
-    std::string comments =
-        "# This is commented\n"
-        "# Comment\n"
-        "Single-line comments end after the line\n"
-        "## Multi-line comments\n"
-        "can span\n"
-        "multiple lines ##\n"
-        "They can also ## occur in the middle of a ## line\n"
-        "But \"## no comments\" ## should occur in uncommented \"string literals ##\"\"\n"
-        "Even \"# these ones\" # this works though\n"
-        "##\n"
-        "Multi-line comment\n"
-        "# Comment within multi-line comment\n"
-        "Still multi-line comment\n"
-        "##\n"
-        "# Comment ## Multi-line comment\n"
-        "Not a comment\n"
-        "## Tabs: \"	\", Spaces: \" \", and newlines: \"\n"
-        "\" are preserved in comments ##\n";
-
-    std::string comments_clean =
-        "                   \n"
-        "         \n"
-        "Single-line comments end after the line\n"
-        "                      \n"
-        "        \n"
-        "                 \n"
-        "They can also                                line\n"
-        "But \"## no comments\"                                                   \"\"\n"
-        "Even \"# these ones\"                    \n"
-        "  \n"
-        "                  \n"
-        "                                   \n"
-        "                        \n"
-        "  \n"
-        "                               \n"
-        "Not a comment\n"
-        "          	                               \n"
-        "                              \n";
-
-    std::string filepath = "temp_comments.txt";
-    TempFile temp_file(filepath, comments);
+    // The contents are the file as is, including comments
+    std::string file_contents = "a <- 1 # comment\n\"text\" ## multi-line\ncomment ##\r\n\t";
+    std::string filepath = "temp_contents.txt";
+    TempFile temp_file(filepath, file_contents);
 
-    // Load file without error
     Reader reader(filepath, &error_manager);
-    std::string contents;
+    std::string_view contents;
     stream_redirect.run([&]() { contents = reader.read_file(); });
     CHECK_FALSE(error_manager.check_error());
+    CHECK_EQ(contents, file_contents);
+    CHECK_EQ(reader.get_source().get_text().data(), contents.data());
 
-    // Check that the contents are as expected
-    CHECK_EQ(contents, comments_clean);
+    // Empty files have no contents
+    TempFile empty_file("temp_empty.txt", "");
+    Reader empty_reader("temp_empty.txt", &error_manager);
+    CHECK_EQ(empty_reader.read_file(), "");
+    CHECK_FALSE(error_manager.check_error());
+    CHECK_EQ(empty_reader.get_source().get_line_count(), 0);
 }
 
 TEST_CASE("Reader file lines") {
@@ -86,12 +53,12 @@ TEST_CASE("Reader file lines") {
                                 "line 6";
 
     std::vector<std::string> correct_lines = {
-        "line 1\n",
-        "line 2\n",
-        "line 3 # comments are in the lines too!\n",
-        "line 4 ## including\n",
-        "multi-line comments ##\n",
-        "line 6\n" // include a newline at EOF, even though it's not in the file
+        "line 1",
+        "line 2",
+        "line 3 # comments are in the lines too!",
+        "line 4 ## including",
+        "multi-line comments ##",
+        "line 6",
     };
 
     std::string filepath = "temp_lines.txt";
@@ -99,13 +66,15 @@ TEST_CASE("Reader file lines") {
 
     // Load file into lines
     Reader reader(filepath, &error_manager);
-    std::vector<std::string> lines;
-    stream_redirect.run([&]() {
-        reader.read_file();
-        lines = reader.get_lines();
-    });
+    stream_redirect.run([&]() { reader.read_file(); });
     CHECK_FALSE(error_manager.check_error());
 
-    // Check that the lines are as expected
-    CHECK_EQ(lines, correct_lines);
+    // Check that the lines are as expected (without their new lines)
+    const SourceBuffer &source = reader.get_source();
+    REQUIRE_EQ(source.get_line_count(), correct_lines.size());
+    for (size_t i = 0; i < correct_lines.size(); i++) {
+        CHECK_EQ(source.get_line((int)i + 1), correct_lines[i]);
+    }
+    CHECK_EQ(source.get_line(0), "");
+    CHECK_EQ(source.get_line(7), "");
 }
@@ -3,6 +3,8 @@
 #include "parser.h"
 #include "reader.h"
 #include "temp_file.h"
+#include "visitor/semantic_analysis_visitor.h"
+#include <memory>
 
 ProgramNode *parse_program(ErrorManager *error_manager, std::string file_path, std::string code) {
     TempFile temp_file(file_path, code);
@@ -12,11 +14,21 @@ ProgramNode *parse_program(ErrorManager *error_manager, std::string file_path, s
     return parser.parse_program();
 }
 
+ProgramNode *analyze_program(ErrorManager *error_manager, std::string file_path, std::string code) {
+    ProgramNode *program = parse_program(error_manager, file_path, code);
+    SemanticAnalysisVisitor semantic_analysis_visitor(program, error_manager);
+    semantic_analysis_visitor.analyze();
+    return program;
+}
+
 std::vector<Token>
 lex_tokens(ErrorManager *error_manager, std::string file_path, std::string code) {
+    // The tokens are views of the file contents, so the readers are kept until the tests end
+    static std::vector<std::unique_ptr<Reader>> readers;
+
     TempFile temp_file(file_path, code);
-    Reader reader(file_path, error_manager);
-    Lexer lexer(reader.read_file(), error_manager);
+    readers.push_back(std::make_unique<Reader>(file_path, error_manager));
+    Lexer lexer(readers.back()->read_file(), error_manager);
     std::vector<Token> tokens = lexer.parse_tokens();
     return tokens;
 }
@@ -19,12 +19,27 @@
  */
 ProgramNode *parse_program(ErrorManager *error_manager, std::string file_path, std::string code);
 
+/**
+ * @brief Parse the program and run semantic analysis on it.
+ * @param error_manager The error manager to use for error handling.
+ * @param file_path The path to the file to parse.
+ * @param code The code to parse.
+ * @return A pointer to the root node of the analyzed AST.
+ *
+ * @note
+ * The caller is responsible for deleting the returned node.
+ */
+ProgramNode *analyze_program(ErrorManager *error_manager, std::string file_path, std::string code);
+
 /**
  * @brief Lex the tokens of the code.
  * @param error_manager The error manager to use for error handling.
  * @param file_path The path of the file.
  * @param code The code to be lexed.
  * @return std::vector<Token> The lexed tokens.
+ *
+ * @note
+ * The values of the tokens remain valid until the end of the tests.
  */
 std::vector<Token> lex_tokens(ErrorManager *error_manager, std::string file_path, std::string code);
 
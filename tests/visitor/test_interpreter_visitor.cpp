@@ -2,16 +2,23 @@
 #include "utils/shortcuts.h"
 #include "utils/stream_redirect.h"
 #include "utils/temp_file.h"
+#include "visitor/closure_compiler_visitor.h"
 #include "visitor/interpreter_visitor.h"
+#include <cstdio>
 #include <doctest/doctest.h>
 #include <fstream>
 #include <sstream>
 
-TEST_CASE("Interpreter empty program") {
+/**
+ * @brief The engines that run the AST, which must give the same results.
+ */
+#define ENGINES InterpreterVisitor, ClosureCompilerVisitor
+
+TEST_CASE_TEMPLATE("Interpreter empty program", Engine, ENGINES) {
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager, "test.txt", "");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager, "test.txt", "");
+    Engine visitor(root, &error_manager);
 
     // Analyzes empty program without error
     visitor.interpret();
@@ -20,12 +27,12 @@ TEST_CASE("Interpreter empty program") {
     delete root;
 }
 
-TEST_CASE("Interpreter simple output") {
+TEST_CASE_TEMPLATE("Interpreter simple output", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager, "test.txt", "output(42)");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager, "test.txt", "output(42)");
+    Engine visitor(root, &error_manager);
 
     // Interprets simple output command without error
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -35,12 +42,12 @@ TEST_CASE("Interpreter simple output") {
     delete root;
 }
 
-TEST_CASE("Interpreter simple output with expression") {
+TEST_CASE_TEMPLATE("Interpreter simple output with expression", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager, "test.txt", "output(2 + 2)");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager, "test.txt", "output(2 + 2)");
+    Engine visitor(root, &error_manager);
 
     // Interprets simple output command with expression without error
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -50,17 +57,17 @@ TEST_CASE("Interpreter simple output with expression") {
     delete root;
 }
 
-TEST_CASE("Interpreter output with complex expressions") {
+TEST_CASE_TEMPLATE("Interpreter output with complex expressions", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "output(1 * (2 + 3 * 4) / 5 - 6 % 4)\n"
-                                      "output((((1 + 2) * 3) + 4) / 5)\n"
-                                      "output(1 + 2 * 3 - 4 / 5 + 6 % 7)"
-                                      "output(1 * 2 * 3 * 4 * 5 * 6 * 7)");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "output(1 * (2 + 3 * 4) / 5 - 6 % 4)\n"
+                                        "output((((1 + 2) * 3) + 4) / 5)\n"
+                                        "output(1 + 2 * 3 - 4 / 5 + 6 % 7)"
+                                        "output(1 * 2 * 3 * 4 * 5 * 6 * 7)");
+    Engine visitor(root, &error_manager);
 
     // Interprets output command with operations without error
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -70,17 +77,17 @@ TEST_CASE("Interpreter output with complex expressions") {
     delete root;
 }
 
-TEST_CASE("Interpreter output literals") {
+TEST_CASE_TEMPLATE("Interpreter output literals", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "output(127)\n"
-                                      "output(3.14159)\n"
-                                      "output(\"some string\")\n"
-                                      "output(true)");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "output(127)\n"
+                                        "output(3.14159)\n"
+                                        "output(\"some string\")\n"
+                                        "output(true)");
+    Engine visitor(root, &error_manager);
 
     // Interprets output command with literals without error
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -90,15 +97,15 @@ TEST_CASE("Interpreter output literals") {
     delete root;
 }
 
-TEST_CASE("Interpreter simple input") {
+TEST_CASE_TEMPLATE("Interpreter simple input", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "a <- input()\n"
-                                      "output(a)");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "a <- input()\n"
+                                        "output(a)");
+    Engine visitor(root, &error_manager);
 
     // Interprets input command without error
     stream_redirect.give_string("42\n");
@@ -109,15 +116,15 @@ TEST_CASE("Interpreter simple input") {
     delete root;
 }
 
-TEST_CASE("Interpreter casting string to int") {
+TEST_CASE_TEMPLATE("Interpreter casting string to int", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "a <- int(input())\n"
-                                      "output(a + 1)");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "a <- int(input())\n"
+                                        "output(a + 1)");
+    Engine visitor(root, &error_manager);
 
     // Casts input string to integer without error
     stream_redirect.give_string("41\n");
@@ -128,15 +135,15 @@ TEST_CASE("Interpreter casting string to int") {
     delete root;
 }
 
-TEST_CASE("Interpreter casting string to float") {
+TEST_CASE_TEMPLATE("Interpreter casting string to float", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "a <- float(input())\n"
-                                      "output(a + 1)");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "a <- float(input())\n"
+                                        "output(a + 1)");
+    Engine visitor(root, &error_manager);
 
     // Casts input string to float without error
     stream_redirect.give_string("2.14159\n");
@@ -147,23 +154,48 @@ TEST_CASE("Interpreter casting string to float") {
     delete root;
 }
 
-TEST_CASE("Interpreter boolean conditions") {
+TEST_CASE_TEMPLATE("Interpreter casting an invalid string error", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "a <- 3\n"
-                                      "b <- 5\n"
-                                      "c <- \"pancake\"\n"
-                                      "output(a = 3)\n"
-                                      "output(b != 5)\n"
-                                      "output(c = \"pancake\")\n"
-                                      "output(a < b)\n"
-                                      "output(a > b)\n"
-                                      "output(a <= b)\n"
-                                      "output(a >= b)\n");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "output(float(\"1.5\"))\n"
+                                        "a <- int(input())\n");
+    Engine visitor(root, &error_manager);
+
+    // A string that isn't a number is reported as an invalid cast
+    stream_redirect.give_string("abc\n");
+    stream_redirect.run([&]() {
+        try {
+            visitor.interpret();
+        } catch (std::runtime_error &e) {
+        }
+    });
+    CHECK(error_manager.check_error());
+    CHECK_EQ(stream_redirect.get_string(),
+             "1.5\nRuntime Error: Invalid cast from string to int (line 2, column 8)\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter boolean conditions", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "a <- 3\n"
+                                        "b <- 5\n"
+                                        "c <- \"pancake\"\n"
+                                        "output(a = 3)\n"
+                                        "output(b != 5)\n"
+                                        "output(c = \"pancake\")\n"
+                                        "output(a < b)\n"
+                                        "output(a > b)\n"
+                                        "output(a <= b)\n"
+                                        "output(a >= b)\n");
+    Engine visitor(root, &error_manager);
 
     // Interprets boolean condition without error
     stream_redirect.give_string("42\n");
@@ -174,20 +206,41 @@ TEST_CASE("Interpreter boolean conditions") {
     delete root;
 }
 
-TEST_CASE("Interpreter if statement") {
+TEST_CASE_TEMPLATE("Interpreter boolean literals", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "output(false)\n"
+                                        "output(true and not false)\n"
+                                        "output(false = false)\n"
+                                        "output([1, 2] = [1, 3])\n"
+                                        "output([1, 2] = [1, 2])\n");
+    Engine visitor(root, &error_manager);
+
+    // Interprets boolean literals and comparisons without error
+    stream_redirect.run([&]() { visitor.interpret(); });
+    CHECK_FALSE(error_manager.check_error());
+    CHECK_EQ(stream_redirect.get_string(), "false\ntrue\ntrue\nfalse\ntrue\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter if statement", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
     ProgramNode *root =
-        parse_program(&error_manager,
-                      "test.txt",
-                      "a <- 3\n"
-                      "if a = 3 {output(42)}\n"
-                      "if a = 4 {output(42)}\n"
-                      "if a = 3 {output(42)} else {output(17)}\n"
-                      "if a = 4 {output(42)} else if a = 3 {output(17)}\n"
-                      "if a = 4 {output(42)} else if a = 20 {output(17)} else {output(102)}\n");
-    InterpreterVisitor visitor(root, &error_manager);
+        analyze_program(&error_manager,
+                        "test.txt",
+                        "a <- 3\n"
+                        "if a = 3 {output(42)}\n"
+                        "if a = 4 {output(42)}\n"
+                        "if a = 3 {output(42)} else {output(17)}\n"
+                        "if a = 4 {output(42)} else if a = 3 {output(17)}\n"
+                        "if a = 4 {output(42)} else if a = 20 {output(17)} else {output(102)}\n");
+    Engine visitor(root, &error_manager);
 
     // Interprets if statement without error
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -197,15 +250,15 @@ TEST_CASE("Interpreter if statement") {
     delete root;
 }
 
-TEST_CASE("Interpreter while statement") {
+TEST_CASE_TEMPLATE("Interpreter while statement", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "a <- 0\n"
-                                      "while a < 5 {output(a)\na <- a + 1}");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "a <- 0\n"
+                                        "while a < 5 {output(a)\na <- a + 1}");
+    Engine visitor(root, &error_manager);
 
     // Interprets while statement without error
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -215,27 +268,27 @@ TEST_CASE("Interpreter while statement") {
     delete root;
 }
 
-TEST_CASE("Interpreter arrays") {
+TEST_CASE_TEMPLATE("Interpreter arrays", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "a <- [[1, 2, [3, 4, 5], 6, [7]], 8, [9, 10]]"
-                                      "output(a)\n"
-                                      "output(a[0])\n"
-                                      "output(a[1])\n"
-                                      "output(a[2][0])\n"
-                                      "output(a[0][1])\n"
-                                      "output(a[0][2][0])\n"
-                                      "a[0] <- [1, 2, [3]]\n"
-                                      "output(a)\n"
-                                      "output(a[0])\n"
-                                      "output(a[1])\n"
-                                      "output(a[2][0])\n"
-                                      "output(a[0][1])\n"
-                                      "output(a[0][2][0])\n");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "a <- [[1, 2, [3, 4, 5], 6, [7]], 8, [9, 10]]"
+                                        "output(a)\n"
+                                        "output(a[0])\n"
+                                        "output(a[1])\n"
+                                        "output(a[2][0])\n"
+                                        "output(a[0][1])\n"
+                                        "output(a[0][2][0])\n"
+                                        "a[0] <- [1, 2, [3]]\n"
+                                        "output(a)\n"
+                                        "output(a[0])\n"
+                                        "output(a[1])\n"
+                                        "output(a[2][0])\n"
+                                        "output(a[0][1])\n"
+                                        "output(a[0][2][0])\n");
+    Engine visitor(root, &error_manager);
 
     // Array shenanigans
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -257,19 +310,19 @@ TEST_CASE("Interpreter arrays") {
     delete root;
 }
 
-TEST_CASE("Interpreter strings") {
+TEST_CASE_TEMPLATE("Interpreter strings", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "a <- \"hello\"\n"
-                                      "output(a)\n"
-                                      "output(a + \" world\")\n"
-                                      "output(\"hello\" + \" world\")\n"
-                                      "output(\"hello\" + string(42))\n"
-                                      "output(\"42\" + \"hello\")\n");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "a <- \"hello\"\n"
+                                        "output(a)\n"
+                                        "output(a + \" world\")\n"
+                                        "output(\"hello\" + \" world\")\n"
+                                        "output(\"hello\" + string(42))\n"
+                                        "output(\"42\" + \"hello\")\n");
+    Engine visitor(root, &error_manager);
 
     // Interprets string operations without error
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -284,18 +337,18 @@ TEST_CASE("Interpreter strings") {
     delete root;
 }
 
-TEST_CASE("Interpreter range literal") {
+TEST_CASE_TEMPLATE("Interpreter range literal", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "output(1..10)\n"
-                                      "output(10..1)\n"
-                                      "output(-10..10)\n"
-                                      "output(10..-10)\n"
-                                      "output(1..1)\n");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "output(1..10)\n"
+                                        "output(10..1)\n"
+                                        "output(-10..10)\n"
+                                        "output(10..-10)\n"
+                                        "output(1..1)\n");
+    Engine visitor(root, &error_manager);
 
     // Interprets range literals
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -310,12 +363,12 @@ TEST_CASE("Interpreter range literal") {
     delete root;
 }
 
-TEST_CASE("Interpreter repeat loop") {
+TEST_CASE_TEMPLATE("Interpreter repeat loop", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager, "test.txt", "repeat 5 {output(42)}");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager, "test.txt", "repeat 5 {output(42)}");
+    Engine visitor(root, &error_manager);
 
     // Interprets repeat loop
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -325,12 +378,12 @@ TEST_CASE("Interpreter repeat loop") {
     delete root;
 }
 
-TEST_CASE("Interpreter for loop") {
+TEST_CASE_TEMPLATE("Interpreter for loop", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager, "test.txt", "for i in 1..10 {output(i)}");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager, "test.txt", "for i in 1..10 {output(i)}");
+    Engine visitor(root, &error_manager);
 
     // Interprets for loop
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -340,13 +393,39 @@ TEST_CASE("Interpreter for loop") {
     delete root;
 }
 
-TEST_CASE("Interpreter nested for loop") {
+TEST_CASE_TEMPLATE("Interpreter for loop over an array changed by its body", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root =
-        parse_program(&error_manager, "test.txt", "for i in 1..3 {for j in 1..3 {output(i + j)}}");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "a <- [1, 2, 3]\n"
+                                        "for x in a {\n"
+                                        "    push(a, x * 10)\n"
+                                        "}\n"
+                                        "output(a)\n"
+                                        "s <- \"ab\"\n"
+                                        "for c in s {\n"
+                                        "    s <- s + c\n"
+                                        "}\n"
+                                        "output(s)\n");
+    Engine visitor(root, &error_manager);
+
+    // The number of iterations is taken when the loop starts, so the loop ends
+    stream_redirect.run([&]() { visitor.interpret(); });
+    CHECK_FALSE(error_manager.check_error());
+    CHECK_EQ(stream_redirect.get_string(), "[1, 2, 3, 10, 20, 30]\nabab\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter nested for loop", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(
+        &error_manager, "test.txt", "for i in 1..3 {for j in 1..3 {output(i + j)}}");
+    Engine visitor(root, &error_manager);
 
     // Interprets nested for loop
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -356,35 +435,110 @@ TEST_CASE("Interpreter nested for loop") {
     delete root;
 }
 
-TEST_CASE("Interpreter string and array multiplication") {
+TEST_CASE_TEMPLATE("Interpreter string multiplication and array replication", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "output(\"hello\" * 3)\n"
-                                      "output([1, 2, 3] * 3)\n"
-                                      "output([1, 2, 3] * 2)\n");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "output(\"hello\" * 3)\n"
+                                        "output(replicate([1, 2, 3], 3))\n"
+                                        "output(replicate([1.5, 2.5], 2))\n"
+                                        "output(replicate([\"a\"], 0))\n"
+                                        "replicate([1], -1)\n");
+    Engine visitor(root, &error_manager);
 
-    // Interprets string and array multiplication
-    stream_redirect.run([&]() { visitor.interpret(); });
-    CHECK_FALSE(error_manager.check_error());
+    // Multiplying a string repeats it, and arrays are repeated by replicate
+    stream_redirect.run([&]() {
+        try {
+            visitor.interpret();
+        } catch (std::runtime_error &e) {
+        }
+    });
+    CHECK_EQ(error_manager.get_error_count(), 1);
     CHECK_EQ(stream_redirect.get_string(),
              "hellohellohello\n"
              "[1, 2, 3, 1, 2, 3, 1, 2, 3]\n"
-             "[1, 2, 3, 1, 2, 3]\n");
+             "[1.5, 2.5, 1.5, 2.5]\n"
+             "[]\n"
+             "Runtime Error: Count of built-in replicate must be non-negative (line 5, column "
+             "9)\n");
 
     delete root;
 }
 
-TEST_CASE("Interpreter print triangle") {
+TEST_CASE_TEMPLATE("Interpreter replication of functions and files", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    TempFile temp_file("text.txt", "line 1\nline 2\n");
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "square <- function(x) {return x * x}\n"
+                                        "file <- open(\"text.txt\")\n"
+                                        "copies <- replicate([square, file, [1]], 2)\n"
+                                        "f <- copies[3]\n"
+                                        "output(len(copies) + f(3))\n"
+                                        "output(read_line(copies[4]))\n"
+                                        "copies[2][0] <- 5\n"
+                                        "output(copies[5])\n"
+                                        "output(copies)\n");
+    Engine visitor(root, &error_manager);
+
+    // Functions and files are shared by the copies, and nested arrays are duplicated
+    stream_redirect.run([&]() {
+        try {
+            visitor.interpret();
+        } catch (std::runtime_error &e) {
+        }
+    });
+    CHECK_EQ(error_manager.get_error_count(), 1);
+    CHECK_EQ(stream_redirect.get_string(),
+             "15\nline 1\n\n[1]\n"
+             "Runtime Error: Invalid argument to built-in output of type array (line 9, column "
+             "6)\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter element-wise operators", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "output([1, 2] - 1)\n"
+                                        "output(1 - [1, 2])\n"
+                                        "output(10 / [2, 5])\n"
+                                        "output(2 < [1, 3])\n"
+                                        "output(3 * [1, 2])\n"
+                                        "output([1, 2] * 2)\n"
+                                        "output([1, 2] * 2.5)\n");
+    Engine visitor(root, &error_manager);
+
+    // Applies single values on either side of an array to every element, multiplying by an int
+    // or a float alike
+    stream_redirect.run([&]() { visitor.interpret(); });
+    CHECK_FALSE(error_manager.check_error());
+    CHECK_EQ(stream_redirect.get_string(),
+             "[0, 1]\n"
+             "[0, -1]\n"
+             "[5, 2]\n"
+             "[false, true]\n"
+             "[3, 6]\n"
+             "[2, 4]\n"
+             "[2.5, 5]\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter print triangle", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
     ProgramNode *root =
-        parse_program(&error_manager, "test.txt", "for i in 1..5 {output(\"*\" * i)}");
-    InterpreterVisitor visitor(root, &error_manager);
+        analyze_program(&error_manager, "test.txt", "for i in 1..5 {output(\"*\" * i)}");
+    Engine visitor(root, &error_manager);
 
     // Interprets print triangle program
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -394,15 +548,15 @@ TEST_CASE("Interpreter print triangle") {
     delete root;
 }
 
-TEST_CASE("Interpreter simple function") {
+TEST_CASE_TEMPLATE("Interpreter simple function", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "add <- function(a, b) {return a + b}\n"
-                                      "output(add(3, 4))");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "add <- function(a, b) {return a + b}\n"
+                                        "output(add(3, 4))");
+    Engine visitor(root, &error_manager);
 
     // Interprets simple function
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -412,22 +566,22 @@ TEST_CASE("Interpreter simple function") {
     delete root;
 }
 
-TEST_CASE("Interpreter swap functions") {
+TEST_CASE_TEMPLATE("Interpreter swap functions", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "add <- function(a, b) {return a + b}\n"
-                                      "sub <- function(a, b) {return a - b}\n"
-                                      "output(add(3, 4))\n"
-                                      "output(sub(3, 4))\n"
-                                      "temp <- add\n"
-                                      "add <- sub\n"
-                                      "sub <- temp\n"
-                                      "output(add(3, 4))\n"
-                                      "output(sub(3, 4))\n");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "add <- function(a, b) {return a + b}\n"
+                                        "sub <- function(a, b) {return a - b}\n"
+                                        "output(add(3, 4))\n"
+                                        "output(sub(3, 4))\n"
+                                        "temp <- add\n"
+                                        "add <- sub\n"
+                                        "sub <- temp\n"
+                                        "output(add(3, 4))\n"
+                                        "output(sub(3, 4))\n");
+    Engine visitor(root, &error_manager);
 
     // Interprets swap function
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -437,18 +591,18 @@ TEST_CASE("Interpreter swap functions") {
     delete root;
 }
 
-TEST_CASE("Interpreter nested function calls") {
+TEST_CASE_TEMPLATE("Interpreter nested function calls", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "add <- function(a, b) {return a + b}\n"
-                                      "sub <- function(a, b) {return a - b}\n"
-                                      "mul <- function(a, b) {return a * b}\n"
-                                      "div <- function(a, b) {return a / b}\n"
-                                      "output(add(3, mul(2, sub(5, div(10, 2)))) + 1)");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "add <- function(a, b) {return a + b}\n"
+                                        "sub <- function(a, b) {return a - b}\n"
+                                        "mul <- function(a, b) {return a * b}\n"
+                                        "div <- function(a, b) {return a / b}\n"
+                                        "output(add(3, mul(2, sub(5, div(10, 2)))) + 1)");
+    Engine visitor(root, &error_manager);
 
     // Interprets nested functions
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -458,16 +612,16 @@ TEST_CASE("Interpreter nested function calls") {
     delete root;
 }
 
-TEST_CASE("Interpreter recursive function") {
+TEST_CASE_TEMPLATE("Interpreter recursive function", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(
+    ProgramNode *root = analyze_program(
         &error_manager,
         "test.txt",
         "fib <- function(n) {if n <= 1 {return n} else {return fib(n - 1) + fib(n - 2)}}\n"
         "output(fib(10))");
-    InterpreterVisitor visitor(root, &error_manager);
+    Engine visitor(root, &error_manager);
 
     // Interprets recursive function
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -477,15 +631,15 @@ TEST_CASE("Interpreter recursive function") {
     delete root;
 }
 
-TEST_CASE("Interpreter function with no arguments") {
+TEST_CASE_TEMPLATE("Interpreter function with no arguments", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "hello <- function() {output(\"hello\")}\n"
-                                      "hello()");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "hello <- function() {output(\"hello\")}\n"
+                                        "hello()");
+    Engine visitor(root, &error_manager);
 
     // Interprets function with no arguments
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -495,15 +649,15 @@ TEST_CASE("Interpreter function with no arguments") {
     delete root;
 }
 
-TEST_CASE("Interpreter function return string") {
+TEST_CASE_TEMPLATE("Interpreter function return string", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "hello <- function() {return \"hello\"}\n"
-                                      "output(hello())");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "hello <- function() {return \"hello\"}\n"
+                                        "output(hello())");
+    Engine visitor(root, &error_manager);
 
     // Interprets function with return statement
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -513,13 +667,13 @@ TEST_CASE("Interpreter function return string") {
     delete root;
 }
 
-TEST_CASE("Interpreter function return void") {
+TEST_CASE_TEMPLATE("Interpreter function return void", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root =
-        parse_program(&error_manager, "test.txt", "hello <- function() {}\nhello()\na <- hello()");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(
+        &error_manager, "test.txt", "hello <- function() {}\nhello()\na <- hello()");
+    Engine visitor(root, &error_manager);
 
     // Interprets function with return statement
     stream_redirect.run([&]() {
@@ -536,21 +690,21 @@ TEST_CASE("Interpreter function return void") {
     delete root;
 }
 
-TEST_CASE("Interpreter compound statement scopes") {
+TEST_CASE_TEMPLATE("Interpreter compound statement scopes", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "a <- 1\n"
-                                      "b <- 1\n"
-                                      "c <- 1\n"
-                                      "{a <- 10 {b <- 10\nd <- 20\n{c <- "
-                                      "10\noutput(a+b+c+d)}\noutput(a+b+c+d)}\noutput(a+b+c)\n}\n"
-                                      "output(a)\n"
-                                      "output(b)\n"
-                                      "output(c)");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "a <- 1\n"
+                                        "b <- 1\n"
+                                        "c <- 1\n"
+                                        "{a <- 10 {b <- 10\nd <- 20\n{c <- "
+                                        "10\noutput(a+b+c+d)}\noutput(a+b+c+d)}\noutput(a+b+c)\n}\n"
+                                        "output(a)\n"
+                                        "output(b)\n"
+                                        "output(c)");
+    Engine visitor(root, &error_manager);
 
     // Interprets scopes
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -560,14 +714,14 @@ TEST_CASE("Interpreter compound statement scopes") {
     delete root;
 }
 
-TEST_CASE("Interpreter file read") {
+TEST_CASE_TEMPLATE("Interpreter file read", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
     TempFile temp_file("text.txt", "line 1\nline 2\nline 3");
-    ProgramNode *root = parse_program(
+    ProgramNode *root = analyze_program(
         &error_manager, "test.txt", "file_text <- read(\"text.txt\")\noutput(file_text)");
-    InterpreterVisitor visitor(root, &error_manager);
+    Engine visitor(root, &error_manager);
 
     // Interprets file io
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -577,14 +731,38 @@ TEST_CASE("Interpreter file read") {
     delete root;
 }
 
-TEST_CASE("Interpreter file write") {
+TEST_CASE_TEMPLATE("Interpreter large file read", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    // Files this large are mapped into memory
+    TempFile temp_file("text.txt", std::string(100000, 'a') + "bc");
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "text <- read(\"text.txt\")\n"
+                                        "output(len(text))\n"
+                                        "output(text[100001] + text[99999..100001])\n"
+                                        "output(len(text + \"d\") + len(text[0..9]))\n"
+                                        "write(\"text.txt\", \"\")\n"
+                                        "output(text[100000..100001])\n");
+    Engine visitor(root, &error_manager);
+
+    stream_redirect.run([&]() { visitor.interpret(); });
+    CHECK_FALSE(error_manager.check_error());
+    // Overwriting the file does not change the string read from it
+    CHECK_EQ(stream_redirect.get_string(), "100002\ncabc\n100013\nbc\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter file write", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
     TempFile temp_file("text.txt", "");
-    ProgramNode *root = parse_program(
+    ProgramNode *root = analyze_program(
         &error_manager, "test.txt", "write(\"text.txt\", \"line 1\nline 2\nline 3\")");
-    InterpreterVisitor visitor(root, &error_manager);
+    Engine visitor(root, &error_manager);
 
     // Interprets file io
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -598,14 +776,14 @@ TEST_CASE("Interpreter file write") {
     delete root;
 }
 
-TEST_CASE("Interpreter file append") {
+TEST_CASE_TEMPLATE("Interpreter file append", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
     TempFile temp_file("text.txt", "This is the ");
     ProgramNode *root =
-        parse_program(&error_manager, "test.txt", "append(\"text.txt\", \"first line.\")");
-    InterpreterVisitor visitor(root, &error_manager);
+        analyze_program(&error_manager, "test.txt", "append(\"text.txt\", \"first line.\")");
+    Engine visitor(root, &error_manager);
 
     // Interprets file io
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -619,17 +797,193 @@ TEST_CASE("Interpreter file append") {
     delete root;
 }
 
-TEST_CASE("Interpreter list functions") {
+TEST_CASE_TEMPLATE("Interpreter buffered appends", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "a <- [1, 2, 3, 4, 5]\n"
-                                      "output(len(a))\n"
-                                      "output(sum(a))\n"
-                                      "output(product(a))\n");
-    InterpreterVisitor visitor(root, &error_manager);
+    TempFile temp_file("text.txt", "");
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "for i in 1..3 {\n"
+                                        "    append(\"text.txt\", string(i))\n"
+                                        "}\n"
+                                        "output(read(\"text.txt\"))\n"
+                                        "write(\"text.txt\", \"a\")\n"
+                                        "append(\"text.txt\", \"b\")\n"
+                                        "flush()\n");
+    Engine visitor(root, &error_manager);
+
+    // Appends are buffered, but written before the file is read or overwritten
+    stream_redirect.run([&]() { visitor.interpret(); });
+    CHECK_FALSE(error_manager.check_error());
+    CHECK_EQ(stream_redirect.get_string(), "123\n");
+
+    std::ifstream stream("text.txt");
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    CHECK_EQ(buffer.str(), "ab");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter appends through paths to the same file", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    TempFile temp_file("text.txt", "");
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "append(\"./text.txt\", \"1\")\n"
+                                        "append(\"text.txt\", \"2\")\n"
+                                        "append(\"./text.txt\", \"3\")\n");
+    Engine visitor(root, &error_manager);
+
+    // Every spelling of the path appends through the same stream, in order
+    stream_redirect.run([&]() { visitor.interpret(); });
+    CHECK_FALSE(error_manager.check_error());
+
+    std::ifstream stream("text.txt");
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    CHECK_EQ(buffer.str(), "123");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter appends through paths to a new file", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    // The file doesn't exist until the first append creates it
+    TempFile temp_file("text.txt", "");
+    std::remove("text.txt");
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "append(\"text.txt\", \"1\")\n"
+                                        "append(\"./text.txt\", \"2\")\n"
+                                        "append(\"text.txt\", \"3\")\n");
+    Engine visitor(root, &error_manager);
+
+    stream_redirect.run([&]() { visitor.interpret(); });
+    CHECK_FALSE(error_manager.check_error());
+
+    std::ifstream stream("text.txt");
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    CHECK_EQ(buffer.str(), "123");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter flushes before a runtime error", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    TempFile temp_file("text.txt", "");
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "output(\"before\")\n"
+                                        "append(\"text.txt\", \"log\")\n"
+                                        "x <- 1 / 0\n");
+
+    // The output and appends made before the error are written when the program ends
+    stream_redirect.run([&]() {
+        try {
+            Engine visitor(root, &error_manager);
+            visitor.interpret();
+        } catch (std::runtime_error &e) {
+        }
+    });
+    CHECK(error_manager.check_error());
+    CHECK_EQ(stream_redirect.get_string(),
+             "before\nRuntime Error: Invalid operands to binary operator '/' (int and int) (line 3, "
+             "column 6)\n");
+
+    std::ifstream stream("text.txt");
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    CHECK_EQ(buffer.str(), "log");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter file streaming", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    TempFile temp_file("text.txt", "line 1\nline 2\n\nline 4");
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "for line in lines(\"text.txt\") {\n"
+                                        "    output(\"[\" + line + \"]\")\n"
+                                        "}\n"
+                                        "file <- open(\"text.txt\")\n"
+                                        "output(read_chunk(file, 3))\n"
+                                        "output(read_line(file) + read_line(file))\n"
+                                        "for line in file {\n"
+                                        "    output(len(line))\n"
+                                        "}\n"
+                                        "output(len(read_line(file)))\n"
+                                        "close(file)\n"
+                                        "read_line(file)\n");
+    Engine visitor(root, &error_manager);
+
+    // Lines are read without their newline when iterating, and with it by read_line
+    stream_redirect.run([&]() {
+        try {
+            visitor.interpret();
+        } catch (std::runtime_error &e) {
+        }
+    });
+    CHECK_EQ(error_manager.get_error_count(), 1);
+    CHECK_EQ(stream_redirect.get_string(),
+             "[line 1]\n[line 2]\n[]\n[line 4]\nlin\ne 1\nline 2\n\n0\n6\n0\n"
+             "Runtime Error: File 'text.txt' is closed (line 12, column 9)\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter file chunks", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    TempFile temp_file("text.txt", "line 1\nline 2");
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "file <- open(\"text.txt\")\n"
+                                        "output(read_chunk(file, 0))\n"
+                                        "output(read_chunk(file, 2000000000))\n"
+                                        "output(len(read_chunk(file, 2000000000)))\n"
+                                        "read_chunk(file, -1)\n");
+    Engine visitor(root, &error_manager);
+
+    // A chunk larger than the rest of the file is only as long as the rest of the file
+    stream_redirect.run([&]() {
+        try {
+            visitor.interpret();
+        } catch (std::runtime_error &e) {
+        }
+    });
+    CHECK_EQ(error_manager.get_error_count(), 1);
+    CHECK_EQ(stream_redirect.get_string(),
+             "\nline 1\nline 2\n0\n"
+             "Runtime Error: Size of built-in read_chunk must be non-negative (line 5, column "
+             "10)\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter list functions", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "a <- [1, 2, 3, 4, 5]\n"
+                                        "output(len(a))\n"
+                                        "output(sum(a))\n"
+                                        "output(product(a))\n");
+    Engine visitor(root, &error_manager);
 
     // Interprets list functions
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -637,15 +991,15 @@ TEST_CASE("Interpreter list functions") {
     CHECK_EQ(stream_redirect.get_string(), "5\n15\n120\n");
 }
 
-TEST_CASE("Interpreter string functions") {
+TEST_CASE_TEMPLATE("Interpreter string functions", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "a <- \"abcdef g\"\n"
-                                      "output(len(a))\n");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "a <- \"abcdef g\"\n"
+                                        "output(len(a))\n");
+    Engine visitor(root, &error_manager);
 
     // Interprets list functions
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -653,12 +1007,12 @@ TEST_CASE("Interpreter string functions") {
     CHECK_EQ(stream_redirect.get_string(), "8\n");
 }
 
-TEST_CASE("Interpreter if statement type error") {
+TEST_CASE_TEMPLATE("Interpreter if statement type error", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager, "test.txt", "if 1 {output(42)}");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager, "test.txt", "if 1 {output(42)}");
+    Engine visitor(root, &error_manager);
 
     // Runtime error when if statement condition is not of type bool
     stream_redirect.run([&]() {
@@ -674,12 +1028,12 @@ TEST_CASE("Interpreter if statement type error") {
              "column 4)\n");
 }
 
-TEST_CASE("Interpreter for statement type error") {
+TEST_CASE_TEMPLATE("Interpreter for statement type error", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager, "test.txt", "for i in 1 {output(i)}");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager, "test.txt", "for i in 1 {output(i)}");
+    Engine visitor(root, &error_manager);
 
     // Runtime error when for statement range is not of type range
     stream_redirect.run([&]() {
@@ -691,16 +1045,16 @@ TEST_CASE("Interpreter for statement type error") {
     CHECK(error_manager.check_error());
     CHECK_EQ(error_manager.get_error_count(), 1);
     CHECK_EQ(stream_redirect.get_string(),
-             "Runtime Error: Invalid type for iterable (expected array or string, got int) (line "
-             "1, column 10)\n");
+             "Runtime Error: Invalid type for iterable (expected array, string or file, got int) "
+             "(line 1, column 10)\n");
 }
 
-TEST_CASE("Interpreter while statement type error") {
+TEST_CASE_TEMPLATE("Interpreter while statement type error", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager, "test.txt", "while 1 {output(42)}");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager, "test.txt", "while 1 {output(42)}");
+    Engine visitor(root, &error_manager);
 
     // Runtime error when while statement condition is not of type bool
     stream_redirect.run([&]() {
@@ -716,12 +1070,12 @@ TEST_CASE("Interpreter while statement type error") {
              "column 7)\n");
 }
 
-TEST_CASE("Interpreter repeat statement type error") {
+TEST_CASE_TEMPLATE("Interpreter repeat statement type error", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager, "test.txt", "repeat true {output(42)}");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager, "test.txt", "repeat true {output(42)}");
+    Engine visitor(root, &error_manager);
 
     // Runtime error when repeat statement count is not of type int
     stream_redirect.run([&]() {
@@ -737,12 +1091,135 @@ TEST_CASE("Interpreter repeat statement type error") {
              "column 11)\n");
 }
 
-TEST_CASE("Interpreter built-in function argument count error") {
+TEST_CASE_TEMPLATE("Interpreter deep recursion", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(
+        &error_manager,
+        "test.txt",
+        "depth <- function(n) {if n = 0 {return 0}\nreturn depth(n - 1) + 1}\n"
+        "output(depth(99999))");
+    Engine visitor(root, &error_manager);
+
+    // Recursion up to the maximum depth, deeper than the native stack of the thread would hold
+    stream_redirect.run([&]() { visitor.interpret(); });
+    CHECK_FALSE(error_manager.check_error());
+    CHECK_EQ(stream_redirect.get_string(), "99999\n");
+
+    delete root;
+}
+
+/**
+ * @brief Make a recursive program whose calls each evaluate an argument nested 2000 expressions
+ * deep.
+ * @param depth The depth of the recursion.
+ * @return The code of the program.
+ */
+static std::string nested_argument_recursion(int depth) {
+    std::string argument = "n - 1";
+    for (int i = 0; i < 2000; i++) {
+        argument = "(0 + " + argument + ")";
+    }
+    return "depth <- function(n) {if n = 0 {return 0}\nreturn depth(" + argument +
+           ") + 1}\noutput(depth(" + std::to_string(depth) + "))";
+}
+
+TEST_CASE_TEMPLATE("Interpreter recursion with deeply nested arguments", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root =
+        analyze_program(&error_manager, "test.txt", nested_argument_recursion(50));
+    Engine visitor(root, &error_manager);
+
+    // Calls that take more stack than most still fit within the stack for the maximum depth
+    stream_redirect.run([&]() { visitor.interpret(); });
+    CHECK_FALSE(error_manager.check_error());
+    CHECK_EQ(stream_redirect.get_string(), "50\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter deeply nested arguments exhaust the stack", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root =
+        analyze_program(&error_manager, "test.txt", nested_argument_recursion(50));
+    Engine visitor(root, &error_manager);
+    visitor.set_max_call_depth(10);
+
+    // The calls need far more than the stack reserved for 10 calls, which is reported (wherever
+    // the stack runs out) rather than overflowed
+    stream_redirect.run([&]() {
+        try {
+            visitor.interpret();
+        } catch (std::runtime_error &e) {
+        }
+    });
+    CHECK_EQ(error_manager.get_error_count(), 1);
+    std::string output = stream_redirect.get_string();
+    CHECK_EQ(output.rfind("Runtime Error: Maximum recursion depth exceeded", 0), 0);
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter tail calls", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager, "test.txt", "output(42, 42)");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root =
+        analyze_program(&error_manager,
+                        "test.txt",
+                        "count <- function(n, total) {if n = 0 {return total}\n"
+                        "return count(n - 1, total + n)}\n"
+                        "odd <- false\n"
+                        "even <- function(n) {if n = 0 {return true}\nreturn odd(n - 1)}\n"
+                        "odd <- function(n) {if n = 0 {return false}\nreturn even(n - 1)}\n"
+                        "output(count(100000, 0))\noutput(even(100001))");
+    Engine visitor(root, &error_manager);
+    visitor.set_max_call_depth(10);
+
+    // Calls in tail position don't nest, so they run within the maximum depth
+    stream_redirect.run([&]() { visitor.interpret(); });
+    CHECK_FALSE(error_manager.check_error());
+    CHECK_EQ(stream_redirect.get_string(), "705082704\nfalse\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter recursion depth error", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(
+        &error_manager, "test.txt", "loop <- function(n) {return loop(n + 1) + 1}\nloop(0)");
+    Engine visitor(root, &error_manager);
+    visitor.set_max_call_depth(50);
+
+    // Runtime error when calls are nested deeper than the maximum depth
+    stream_redirect.run([&]() {
+        try {
+            visitor.interpret();
+        } catch (std::runtime_error &e) {
+        }
+    });
+    CHECK(error_manager.check_error());
+    CHECK_EQ(error_manager.get_error_count(), 1);
+    CHECK_EQ(stream_redirect.get_string(),
+             "Runtime Error: Maximum recursion depth exceeded (50 nested calls) (line 1, column "
+             "32)\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter built-in function argument count error", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(&error_manager, "test.txt", "output(42, 42)");
+    Engine visitor(root, &error_manager);
 
     // Runtime error when function call has too many arguments
     stream_redirect.run([&]() {
@@ -758,12 +1235,13 @@ TEST_CASE("Interpreter built-in function argument count error") {
              "2) (line 1, column 6)\n");
 }
 
-TEST_CASE("Interpreter function argument count error") {
+TEST_CASE_TEMPLATE("Interpreter function argument count error", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager, "test.txt", "a <- function(a) {}\na(42, 42)");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root =
+        analyze_program(&error_manager, "test.txt", "a <- function(a) {}\na(42, 42)");
+    Engine visitor(root, &error_manager);
 
     // Runtime error when function call has too many arguments
     stream_redirect.run([&]() {
@@ -779,16 +1257,16 @@ TEST_CASE("Interpreter function argument count error") {
              "(line 2, column 1)\n");
 }
 
-TEST_CASE("Interpreter stop statement") {
+TEST_CASE_TEMPLATE("Interpreter stop statement", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
-    ProgramNode *root = parse_program(&error_manager,
-                                      "test.txt",
-                                      "for i in 1..5 {if i = 3 {stop} output(i)}\n"
-                                      "while true {stop\noutput(42)}\n"
-                                      "repeat 5 {stop\noutput(42)}");
-    InterpreterVisitor visitor(root, &error_manager);
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "for i in 1..5 {if i = 3 {stop} output(i)}\n"
+                                        "while true {stop\noutput(42)}\n"
+                                        "repeat 5 {stop\noutput(42)}");
+    Engine visitor(root, &error_manager);
 
     // Interprets control statements
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -798,18 +1276,18 @@ TEST_CASE("Interpreter stop statement") {
     delete root;
 }
 
-TEST_CASE("Interpreter next statement") {
+TEST_CASE_TEMPLATE("Interpreter next statement", Engine, ENGINES) {
     StreamRedirect stream_redirect;
     ErrorManager error_manager;
 
     ProgramNode *root =
-        parse_program(&error_manager,
-                      "test.txt",
-                      "for i in 1..5 {if i = 3 {next} output(i)}\n"
-                      "i <- 0"
-                      "while true {i <- i + 1\nif i = 5 {stop}\nnext\noutput(42)}\n"
-                      "repeat 5 {next\noutput(42)}");
-    InterpreterVisitor visitor(root, &error_manager);
+        analyze_program(&error_manager,
+                        "test.txt",
+                        "for i in 1..5 {if i = 3 {next} output(i)}\n"
+                        "i <- 0"
+                        "while true {i <- i + 1\nif i = 5 {stop}\nnext\noutput(42)}\n"
+                        "repeat 5 {next\noutput(42)}");
+    Engine visitor(root, &error_manager);
 
     // Interprets control statements
     stream_redirect.run([&]() { visitor.interpret(); });
@@ -818,3 +1296,193 @@ TEST_CASE("Interpreter next statement") {
 
     delete root;
 }
+
+TEST_CASE_TEMPLATE("Interpreter function assigns global declared later", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "set <- function(value) {x <- value\nreturn x}\n"
+                                        "output(set(1))\n"
+                                        "x <- 2\n"
+                                        "output(set(3))\n"
+                                        "output(x)");
+    Engine visitor(root, &error_manager);
+
+    // Updates the global once it is declared, and a local variable before that
+    stream_redirect.run([&]() { visitor.interpret(); });
+    CHECK_FALSE(error_manager.check_error());
+    CHECK_EQ(stream_redirect.get_string(), "1\n3\n3\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter quickened operators deoptimize on other types", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "add <- function(a, b) {return a + b}\n"
+                                        "less <- function(a, b) {return a < b}\n"
+                                        "get <- function(a, i) {return a[i]}\n"
+                                        "half <- function(x) {return float(x) / 2.0}\n"
+                                        "output(add(1, 2))\n"
+                                        "output(add(1.5, 2.0))\n"
+                                        "output(add(\"a\", \"b\"))\n"
+                                        "output(add(1, 2.5))\n"
+                                        "output(less(\"a\", \"b\"))\n"
+                                        "output(less(2, 1))\n"
+                                        "output(get([1, 2, 3], 2))\n"
+                                        "output(get(\"abc\", 1))\n"
+                                        "output(get([4, 5], 0))\n"
+                                        "output(half(3))\n"
+                                        "output(half(5.0))\n"
+                                        "output(half(\"7\"))");
+    Engine visitor(root, &error_manager);
+
+    // Each site is specialized for its first types, and still handles the others
+    stream_redirect.run([&]() { visitor.interpret(); });
+    CHECK_FALSE(error_manager.check_error());
+    CHECK_EQ(stream_redirect.get_string(),
+             "3\n3.5\nab\n3.5\ntrue\nfalse\n3\nb\n4\n1.5\n2.5\n3.5\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter range too long error", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "output(len(-5..2147483641))\n"
+                                        "for i in 0..2147483647 {output(i)}");
+    Engine visitor(root, &error_manager);
+
+    // A range with more elements than an array can hold is an error
+    stream_redirect.run([&]() {
+        try {
+            visitor.interpret();
+        } catch (std::runtime_error &e) {
+        }
+    });
+    CHECK_EQ(error_manager.get_error_count(), 1);
+    CHECK_EQ(stream_redirect.get_string(),
+             "2147483647\nRuntime Error: Range too long (more than 2147483647 elements) (line 2, "
+             "column 10)\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter subscript assignment errors", Engine, ENGINES) {
+    // Only arrays can be assigned to at an index, and only within their bounds
+    std::pair<const char *, const char *> programs[] = {
+        {"s <- \"abc\"\ns[0] <- \"x\"",
+         "Runtime Error: Invalid subscript operation on string (line 2, column 3)\n"},
+        {"a <- [1]\na[0] <- 2\noutput(a)\na[1] <- 3",
+         "[2]\nRuntime Error: Invalid subscript operation on array (line 4, column 3)\n"},
+    };
+    for (const auto &[code, expected] : programs) {
+        StreamRedirect stream_redirect;
+        ErrorManager error_manager;
+
+        ProgramNode *root = analyze_program(&error_manager, "test.txt", code);
+        Engine visitor(root, &error_manager);
+        stream_redirect.run([&]() {
+            try {
+                visitor.interpret();
+            } catch (std::runtime_error &e) {
+            }
+        });
+        CHECK_EQ(error_manager.get_error_count(), 1);
+        CHECK_EQ(stream_redirect.get_string(), expected);
+
+        delete root;
+    }
+}
+
+TEST_CASE_TEMPLATE("Interpreter quickened int operators wrap around", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "add <- function(a, b) {return a + b}\n"
+                                        "sub <- function(a, b) {return a - b}\n"
+                                        "mul <- function(a, b) {return a * b}\n"
+                                        "output(add(1, 2))\n"
+                                        "output(add(2147483647, 1))\n"
+                                        "output(add([2147483647, 1], 1))\n"
+                                        "output(sub(1, 2))\n"
+                                        "output(sub(-2147483647, 2))\n"
+                                        "output(sub([-2147483647, 1], 2))\n"
+                                        "output(mul(2, 3))\n"
+                                        "output(mul(65536, 32768))\n"
+                                        "output(mul([65536, 2], 32768))\n");
+    Engine visitor(root, &error_manager);
+
+    // Overflow of a specialized int operator matches the packed array kernels
+    stream_redirect.run([&]() { visitor.interpret(); });
+    CHECK_FALSE(error_manager.check_error());
+    CHECK_EQ(stream_redirect.get_string(),
+             "3\n-2147483648\n[-2147483648, 2]\n"
+             "-1\n2147483647\n[2147483647, -1]\n"
+             "6\n-2147483648\n[-2147483648, 65536]\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter quickened operator guard error", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "get <- function(a, i) {return a[i] + 1}\n"
+                                        "output(get([1, 2], 1))\n"
+                                        "output(get([1, 2], 2))");
+    Engine visitor(root, &error_manager);
+
+    // An index out of bounds fails the specialized subscript like the generic one
+    stream_redirect.run([&]() {
+        try {
+            visitor.interpret();
+        } catch (std::runtime_error &e) {
+        }
+    });
+    CHECK(error_manager.check_error());
+    CHECK_EQ(error_manager.get_error_count(), 1);
+    CHECK_EQ(stream_redirect.get_string(),
+             "3\nRuntime Error: Invalid subscript operation on array (line 1, column 33)\n");
+
+    delete root;
+}
+
+TEST_CASE_TEMPLATE("Interpreter int division by zero error", Engine, ENGINES) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(&error_manager,
+                                        "test.txt",
+                                        "div <- function(a, b) {return a / b}\n"
+                                        "output(div(7, 2))\n"
+                                        "output(div(7, 0))");
+    Engine visitor(root, &error_manager);
+
+    // A division that would trap is an invalid operation, on the quickened int path too
+    stream_redirect.run([&]() {
+        try {
+            visitor.interpret();
+        } catch (std::runtime_error &e) {
+        }
+    });
+    CHECK(error_manager.check_error());
+    CHECK_EQ(error_manager.get_error_count(), 1);
+    CHECK_EQ(stream_redirect.get_string(),
+             "3\nRuntime Error: Invalid operands to binary operator '/' (int and int) (line 1, "
+             "column 31)\n");
+
+    delete root;
+}
@@ -0,0 +1,191 @@
+#include "AST/AST_nodes.h"
+#include "error_manager.h"
+#include "object/string_object.h"
+#include "utils/shortcuts.h"
+#include "utils/stream_redirect.h"
+#include "visitor/compiler_visitor.h"
+#include "visitor/interpreter_visitor.h"
+#include "visitor/optimizer_visitor.h"
+#include "vm/virtual_machine.h"
+#include <doctest/doctest.h>
+#include <memory>
+
+/**
+ * @brief Analyze and optimize a program.
+ * @param error_manager The error manager to use for error handling.
+ * @param code The code of the program.
+ * @return The root node of the optimized AST (the caller deletes it).
+ */
+static ProgramNode *optimize_program(ErrorManager *error_manager, const std::string &code) {
+    ProgramNode *root = analyze_program(error_manager, "test.txt", code);
+    OptimizerVisitor optimizer_visitor(root, error_manager);
+    optimizer_visitor.optimize();
+    return root;
+}
+
+/**
+ * @brief Run a program on both engines, with or without optimization.
+ * @param code The code of the program.
+ * @param optimize If the program is optimized before running it.
+ * @return The output of the interpreter followed by the output of the virtual machine.
+ */
+static std::string run_both_engines(const std::string &code, bool optimize) {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+    ProgramNode *root = optimize ? optimize_program(&error_manager, code)
+                                 : analyze_program(&error_manager, "test.txt", code);
+
+    stream_redirect.run([&]() {
+        try {
+            InterpreterVisitor interpreter_visitor(root, &error_manager);
+            interpreter_visitor.interpret();
+        } catch (std::runtime_error &e) {
+        }
+        try {
+            CompilerVisitor compiler_visitor(root, &error_manager);
+            std::unique_ptr<BytecodeProgram> program(compiler_visitor.compile());
+            VirtualMachine virtual_machine(program.get(), &error_manager);
+            virtual_machine.run();
+        } catch (std::runtime_error &e) {
+        }
+    });
+
+    delete root;
+    return stream_redirect.get_string();
+}
+
+TEST_CASE("Optimizer folds constant expressions") {
+    ErrorManager error_manager;
+    ProgramNode *root = optimize_program(&error_manager,
+                                         "a <- 1 + 2 * 3\n"
+                                         "b <- -(2.5 * 2)\n"
+                                         "c <- string(4) + \"2\"\n"
+                                         "d <- not (1 < 2)\n"
+                                         "e <- a + 1\n");
+    REQUIRE_FALSE(error_manager.check_error());
+    REQUIRE_EQ(root->get_statements_size(), 5);
+
+    auto value_of = [&](size_t index) {
+        auto *assignment = dynamic_cast<AssignmentNode *>(root->get_statement(index));
+        REQUIRE(assignment != nullptr);
+        return assignment->get_value();
+    };
+
+    auto *a = dynamic_cast<LiteralNode *>(value_of(0));
+    REQUIRE(a != nullptr);
+    CHECK_EQ(a->get_constant().get_int(), 7);
+    CHECK_EQ(a->get_value(), "7");
+
+    auto *b = dynamic_cast<LiteralNode *>(value_of(1));
+    REQUIRE(b != nullptr);
+    CHECK_EQ(b->get_constant().get_float(), -5.0f);
+
+    auto *c = dynamic_cast<LiteralNode *>(value_of(2));
+    REQUIRE(c != nullptr);
+    REQUIRE_EQ(c->get_type(), TYPE_STRING);
+    CHECK_EQ(c->get_constant().as<StringObject>()->get_value(), "42");
+    CHECK_EQ(c->get_value(), "\"42\"");
+
+    auto *d = dynamic_cast<LiteralNode *>(value_of(3));
+    REQUIRE(d != nullptr);
+    CHECK_FALSE(d->get_constant().get_bool());
+
+    // Variables are not constants, but the literals in the expression are materialized
+    auto *e = dynamic_cast<BinOpNode *>(value_of(4));
+    REQUIRE(e != nullptr);
+    auto *one = dynamic_cast<LiteralNode *>(e->get_right_node());
+    REQUIRE(one != nullptr);
+    CHECK(one->has_constant());
+
+    delete root;
+}
+
+TEST_CASE("Optimizer leaves runtime errors to the runtime") {
+    ErrorManager error_manager;
+    ProgramNode *root = optimize_program(&error_manager,
+                                         "a <- 1 / 0\n"
+                                         "b <- int(\"abc\")\n"
+                                         "c <- 1 + \"a\"\n"
+                                         "d <- 99999999999\n"
+                                         "if 1 {\n"
+                                         "}\n");
+    REQUIRE_FALSE(error_manager.check_error());
+    REQUIRE_EQ(root->get_statements_size(), 5);
+
+    for (size_t i = 0; i < 3; i++) {
+        auto *assignment = dynamic_cast<AssignmentNode *>(root->get_statement(i));
+        REQUIRE(assignment != nullptr);
+        CHECK_NE(assignment->get_value()->get_node_type(), LITERAL_NODE);
+    }
+
+    auto *out_of_range = dynamic_cast<AssignmentNode *>(root->get_statement(3));
+    REQUIRE(out_of_range != nullptr);
+    CHECK_FALSE(static_cast<LiteralNode *>(out_of_range->get_value())->has_constant());
+
+    CHECK_EQ(root->get_statement(4)->get_node_type(), IF_STATEMENT_NODE);
+
+    delete root;
+}
+
+TEST_CASE("Optimizer prunes constant branches") {
+    ErrorManager error_manager;
+    ProgramNode *root = optimize_program(&error_manager,
+                                         "if 1 < 2 {\n"
+                                         "    output(1)\n"
+                                         "} else {\n"
+                                         "    output(2)\n"
+                                         "}\n"
+                                         "if false {\n"
+                                         "    output(3)\n"
+                                         "}\n"
+                                         "if false {\n"
+                                         "} else if true {\n"
+                                         "    output(4)\n"
+                                         "}\n");
+    REQUIRE_FALSE(error_manager.check_error());
+
+    // The taken branches are kept in a block (for their scope), and the others are removed
+    REQUIRE_EQ(root->get_statements_size(), 2);
+    CHECK_EQ(root->get_statement(0)->get_node_type(), COMPOUND_STATEMENT_NODE);
+    CHECK_EQ(root->get_statement(1)->get_node_type(), COMPOUND_STATEMENT_NODE);
+
+    delete root;
+}
+
+TEST_CASE("Optimized programs match unoptimized programs") {
+    std::vector<std::string> programs = {
+        "x <- 10\n"
+        "if 2 * 3 = 6 {\n"
+        "    y <- x + 1\n"
+        "    if not true {\n"
+        "        output(0)\n"
+        "    } else {\n"
+        "        z <- y * 2\n"
+        "        output(z)\n"
+        "    }\n"
+        "}\n"
+        "output(x)\n",
+
+        "f <- function(n) {\n"
+        "    if true {\n"
+        "        return n * (2 + 3)\n"
+        "    }\n"
+        "    return 0\n"
+        "}\n"
+        "s <- \"\"\n"
+        "for i in 1..(2 + 1) {\n"
+        "    s <- s + string(f(i)) + \" \" + (\"a\" + \"b\")\n"
+        "}\n"
+        "output(s)\n",
+
+        "a <- 7 % 3 + 2.0 / 4.0\n"
+        "output(a)\n"
+        "output(int(\"12\") + 1)\n"
+        "output(1 + true)\n",
+    };
+
+    for (const std::string &program : programs) {
+        CAPTURE(program);
+        CHECK_EQ(run_both_engines(program, true), run_both_engines(program, false));
+    }
+}
@@ -1,3 +1,5 @@
+#include "AST/AST_nodes.h"
+#include "built_in_functions.h"
 #include "error_manager.h"
 #include "lexer.h"
 #include "parser.h"
@@ -522,3 +524,112 @@ TEST_CASE("Semantic Analysis scopes") {
 
     delete root;
 }
+
+TEST_CASE("Semantic Analysis variable slots") {
+    ErrorManager error_manager;
+
+    ProgramNode *root = parse_program(&error_manager,
+                                      "test.txt",
+                                      "a <- 1\n"
+                                      "{b <- a\n{b <- 2}}\n"
+                                      "if c <- false {} else {c}\n"
+                                      "set <- function(n) {n\nd <- n}\n"
+                                      "d <- 0");
+    SemanticAnalysisVisitor visitor(root, &error_manager);
+
+    // Analyzes code without error (the else body is in the scope of the condition)
+    visitor.analyze();
+    CHECK_FALSE(error_manager.check_error());
+
+    // Globals are resolved to their slot in the global scope
+    auto *assignment = static_cast<AssignmentNode *>(root->get_statement(0));
+    const std::vector<std::string> &global_names = root->get_global_names();
+    CHECK(assignment->get_slot().is_global());
+    REQUIRE(assignment->get_slot().slot < (int)global_names.size());
+    CHECK_EQ(global_names[assignment->get_slot().slot], "a");
+
+    // Block variables are resolved relative to the scope they are used in
+    auto *block = static_cast<CompoundStatementNode *>(root->get_statement(1));
+    auto *declaration = static_cast<AssignmentNode *>(block->get_statement(0));
+    CHECK_EQ(declaration->get_slot().depth, 0);
+    CHECK_EQ(declaration->get_slot().slot, 0);
+    CHECK(static_cast<IdentifierNode *>(declaration->get_value())->get_slot().is_global());
+
+    auto *inner_block = static_cast<CompoundStatementNode *>(block->get_statement(1));
+    auto *update = static_cast<AssignmentNode *>(inner_block->get_statement(0));
+    CHECK_EQ(update->get_slot().depth, 1);
+    CHECK_EQ(update->get_slot().slot, 0);
+
+    // Function variables fall back to globals that are declared after the function
+    auto *function_assignment = static_cast<AssignmentNode *>(root->get_statement(3));
+    auto *function = static_cast<FunctionDeclarationNode *>(function_assignment->get_value());
+    auto *body = static_cast<CompoundStatementNode *>(function->get_body());
+    auto *parameter = static_cast<IdentifierNode *>(body->get_statement(0));
+    auto *local = static_cast<AssignmentNode *>(body->get_statement(1));
+    CHECK_EQ(parameter->get_slot().depth, 1);
+    CHECK_EQ(parameter->get_slot().slot, 0);
+    CHECK_FALSE(parameter->get_slot().has_global_fallback());
+    CHECK_EQ(local->get_slot().depth, 0);
+    REQUIRE(local->get_slot().has_global_fallback());
+    CHECK_EQ(global_names[local->get_slot().global_slot], "d");
+
+    delete root;
+}
+
+TEST_CASE("Semantic Analysis built-in function calls") {
+    ErrorManager error_manager;
+
+    ProgramNode *root = parse_program(&error_manager,
+                                      "test.txt",
+                                      "a <- [1]\n"
+                                      "output(len(a))\n"
+                                      "f <- function() {}\n"
+                                      "f()");
+    SemanticAnalysisVisitor visitor(root, &error_manager);
+
+    visitor.analyze();
+    CHECK_FALSE(error_manager.check_error());
+
+    // Calls to built-in functions are bound to the id of the function
+    auto *output_call = static_cast<CallOpNode *>(root->get_statement(1));
+    auto *len_call = static_cast<CallOpNode *>(output_call->get_argument(0));
+    REQUIRE(output_call->get_built_in_id() >= 0);
+    REQUIRE(len_call->get_built_in_id() >= 0);
+    CHECK_EQ(std::string(BuiltInFunctions::get(output_call->get_built_in_id()).name), "output");
+    CHECK_EQ(std::string(BuiltInFunctions::get(len_call->get_built_in_id()).name), "len");
+
+    // Calls to user functions are not
+    auto *user_call = static_cast<CallOpNode *>(root->get_statement(3));
+    CHECK_EQ(user_call->get_built_in_id(), -1);
+
+    delete root;
+}
+
+TEST_CASE("Semantic Analysis tail calls") {
+    ErrorManager error_manager;
+
+    ProgramNode *root = parse_program(&error_manager,
+                                      "test.txt",
+                                      "f <- function(n) {return f(n)}\n"
+                                      "g <- function(n) {return f(n) + 1}\n"
+                                      "h <- function(a) {return len(a)}");
+    SemanticAnalysisVisitor visitor(root, &error_manager);
+
+    visitor.analyze();
+    CHECK_FALSE(error_manager.check_error());
+
+    auto return_value = [&](int statement) {
+        auto *assignment = static_cast<AssignmentNode *>(root->get_statement(statement));
+        auto *function = static_cast<FunctionDeclarationNode *>(assignment->get_value());
+        auto *body = static_cast<CompoundStatementNode *>(function->get_body());
+        return static_cast<ReturnStatementNode *>(body->get_statement(0))->get_value();
+    };
+
+    // Only calls to functions of the program whose result is returned directly are tail calls
+    CHECK(static_cast<CallOpNode *>(return_value(0))->is_tail_call());
+    auto *addition = static_cast<BinOpNode *>(return_value(1));
+    CHECK_FALSE(static_cast<CallOpNode *>(addition->get_left_node())->is_tail_call());
+    CHECK_FALSE(static_cast<CallOpNode *>(return_value(2))->is_tail_call());
+
+    delete root;
+}
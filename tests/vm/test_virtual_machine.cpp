@@ -0,0 +1,447 @@
+#include "error_manager.h"
+#include "utils/shortcuts.h"
+#include "utils/stream_redirect.h"
+#include "visitor/compiler_visitor.h"
+#include "visitor/interpreter_visitor.h"
+#include "vm/virtual_machine.h"
+#include <doctest/doctest.h>
+#include <memory>
+
+/**
+ * @brief Compile and run a program on the virtual machine.
+ * @param error_manager The error manager to use for error handling.
+ * @param code The code of the program.
+ * @param input The standard input given to the program.
+ * @return The output of the program.
+ */
+static std::string
+run_program(ErrorManager *error_manager, const std::string &code, const std::string &input = "") {
+    StreamRedirect stream_redirect;
+    stream_redirect.give_string(input);
+
+    ProgramNode *root = analyze_program(error_manager, "test.txt", code);
+    CompilerVisitor compiler_visitor(root, error_manager);
+    std::unique_ptr<BytecodeProgram> program(compiler_visitor.compile());
+    VirtualMachine virtual_machine(program.get(), error_manager);
+
+    stream_redirect.run([&]() {
+        try {
+            virtual_machine.run();
+        } catch (std::runtime_error &e) {
+        }
+    });
+
+    delete root;
+    return stream_redirect.get_string();
+}
+
+/**
+ * @brief Run a program on the tree-walking interpreter.
+ * @param error_manager The error manager to use for error handling.
+ * @param code The code of the program.
+ * @return The output of the program.
+ */
+static std::string interpret_program(ErrorManager *error_manager, const std::string &code) {
+    StreamRedirect stream_redirect;
+
+    ProgramNode *root = analyze_program(error_manager, "test.txt", code);
+    InterpreterVisitor interpreter_visitor(root, error_manager);
+
+    stream_redirect.run([&]() {
+        try {
+            interpreter_visitor.interpret();
+        } catch (std::runtime_error &e) {
+        }
+    });
+
+    delete root;
+    return stream_redirect.get_string();
+}
+
+TEST_CASE("Virtual machine empty program") {
+    ErrorManager error_manager;
+
+    // Runs empty program without error
+    CHECK_EQ(run_program(&error_manager, ""), "");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine output with complex expressions") {
+    ErrorManager error_manager;
+
+    // Runs output command with operations without error
+    CHECK_EQ(run_program(&error_manager,
+                         "output(1 * (2 + 3 * 4) / 5 - 6 % 4)\n"
+                         "output((((1 + 2) * 3) + 4) / 5)\n"
+                         "output(1 + 2 * 3 - 4 / 5 + 6 % 7)"
+                         "output(1 * 2 * 3 * 4 * 5 * 6 * 7)"),
+             "0\n2\n13\n5040\n");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine output literals") {
+    ErrorManager error_manager;
+
+    // Runs output command with literals without error
+    CHECK_EQ(run_program(&error_manager,
+                         "output(127)\n"
+                         "output(3.14159)\n"
+                         "output(\"some string\")\n"
+                         "output(true)"),
+             "127\n3.14159\nsome string\ntrue\n");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine casting input") {
+    ErrorManager error_manager;
+
+    // Casts input string to integer without error
+    CHECK_EQ(run_program(&error_manager, "a <- int(input())\noutput(a + 1)", "41\n"), "42\n");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine casting an invalid string error") {
+    ErrorManager error_manager;
+
+    // A string that isn't a number is reported as an invalid cast
+    CHECK_EQ(run_program(&error_manager, "a <- float(input())", "1e99\n"),
+             "Runtime Error: Invalid cast from string to float (line 1, column 10)\n");
+    CHECK(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine boolean conditions") {
+    ErrorManager error_manager;
+
+    // Runs boolean conditions without error
+    CHECK_EQ(run_program(&error_manager,
+                         "a <- 3\n"
+                         "b <- 5\n"
+                         "c <- \"pancake\"\n"
+                         "output(a = 3)\n"
+                         "output(b != 5)\n"
+                         "output(c = \"pancake\")\n"
+                         "output(a < b)\n"
+                         "output(a > b)\n"
+                         "output(a <= b)\n"
+                         "output(a >= b)\n"),
+             "true\nfalse\ntrue\ntrue\nfalse\ntrue\nfalse\n");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine if statement") {
+    ErrorManager error_manager;
+
+    // Runs if statements without error
+    CHECK_EQ(run_program(&error_manager,
+                         "a <- 3\n"
+                         "if a = 3 {output(42)}\n"
+                         "if a = 4 {output(42)}\n"
+                         "if a = 3 {output(42)} else {output(17)}\n"
+                         "if a = 4 {output(42)} else if a = 3 {output(17)}\n"
+                         "if a = 4 {output(42)} else if a = 20 {output(17)} else {output(102)}\n"),
+             "42\n42\n17\n102\n");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine loops") {
+    ErrorManager error_manager;
+
+    // Runs while, repeat and for loops without error
+    CHECK_EQ(run_program(&error_manager,
+                         "a <- 0\n"
+                         "while a < 3 {output(a)\na <- a + 1}\n"
+                         "repeat 2 {output(42)}\n"
+                         "for i in 1..3 {for j in 1..2 {output(i * j)}}\n"
+                         "for c in \"ab\" {output(c)}\n"
+                         "b <- [1, 2]\n"
+                         "for x in b {push(b, x)}\n"
+                         "output(b)\n"),
+             "0\n1\n2\n42\n42\n1\n2\n2\n4\n3\n6\na\nb\n[1, 2, 1, 2]\n");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine arrays") {
+    ErrorManager error_manager;
+
+    // Array shenanigans
+    CHECK_EQ(run_program(&error_manager,
+                         "a <- [[1, 2, [3, 4, 5], 6, [7]], 8, [9, 10]]"
+                         "output(a[0][2][0])\n"
+                         "a[0] <- [1, 2, [3]]\n"
+                         "output(a)\n"
+                         "b <- a\n"
+                         "b[1] <- 80\n"
+                         "output(a[1])\n"
+                         "output([1, 2] * 2)\n"
+                         "output(3 * [1, 2.5])\n"
+                         "output(replicate([1, 2], 2))\n"
+                         "output(10..8)\n"
+                         "square <- function(x) {return x * x}\n"
+                         "copies <- replicate([square, [1]], 2)\n"
+                         "f <- copies[2]\n"
+                         "output(f(3))\n"),
+             "3\n[[1, 2, [3]], 8, [9, 10]]\n80\n[2, 4]\n[3, 7.5]\n[1, 2, 1, 2]\n[10, 9, 8]\n9\n");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine int overflow") {
+    ErrorManager error_manager;
+
+    // Int operators wrap around on overflow, like the packed array kernels
+    CHECK_EQ(run_program(&error_manager,
+                         "a <- 2147483647\n"
+                         "b <- -2147483647 - 1\n"
+                         "output(a + 1)\n"
+                         "output(b - 1)\n"
+                         "output(a * 2)\n"
+                         "output(-b)\n"
+                         "output([a] + 1)\n"),
+             "-2147483648\n2147483647\n-2\n-2147483648\n[-2147483648]\n");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine functions") {
+    ErrorManager error_manager;
+
+    // Runs user defined functions without error
+    CHECK_EQ(run_program(&error_manager,
+                         "add <- function(a, b) {return a + b}\n"
+                         "sub <- function(a, b) {return a - b}\n"
+                         "mul <- function(a, b) {return a * b}\n"
+                         "div <- function(a, b) {return a / b}\n"
+                         "output(add(3, mul(2, sub(5, div(10, 2)))) + 1)\n"
+                         "temp <- add\n"
+                         "add <- sub\n"
+                         "sub <- temp\n"
+                         "output(add(3, 4))\n"
+                         "hello <- function() {output(\"hello\")}\n"
+                         "hello()"),
+             "4\n-1\nhello\n");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine recursive function") {
+    ErrorManager error_manager;
+
+    // Runs recursive function without error
+    CHECK_EQ(run_program(&error_manager,
+                         "fib <- function(n) {if n <= 1 {return n} else {return fib(n - 1) + "
+                         "fib(n - 2)}}\n"
+                         "output(fib(15))"),
+             "610\n");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine compound statement scopes") {
+    ErrorManager error_manager;
+
+    // Runs scopes
+    CHECK_EQ(run_program(&error_manager,
+                         "a <- 1\n"
+                         "b <- 1\n"
+                         "c <- 1\n"
+                         "{a <- 10 {b <- 10\nd <- 20\n{c <- "
+                         "10\noutput(a+b+c+d)}\noutput(a+b+c+d)}\noutput(a+b+c)\n}\n"
+                         "output(a)\n"
+                         "output(b)\n"
+                         "output(c)"),
+             "50\n50\n30\n10\n10\n10\n");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine function scopes") {
+    ErrorManager error_manager;
+
+    // Functions see the globals that exist when they are called, but not the caller's variables
+    CHECK_EQ(run_program(&error_manager,
+                         "set <- function() {g <- 5\nl <- 1}\n"
+                         "g <- 1\n"
+                         "set()\n"
+                         "output(g)\n"
+                         "get <- function() {return g}\n"
+                         "{g <- 7\nx <- get()\noutput(x)}\n"
+                         "f <- function(n) {n <- n + 1\nreturn n}\n"
+                         "n <- 1\n"
+                         "output(f(n))\n"
+                         "output(n)"),
+             "5\n7\n2\n1\n");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine control statements") {
+    ErrorManager error_manager;
+
+    // Runs stop and next statements, and returns from inside loops
+    CHECK_EQ(run_program(&error_manager,
+                         "for i in 1..5 {if i = 3 {next} output(i)}\n"
+                         "for i in 1..5 {if i = 3 {stop} output(i)}\n"
+                         "i <- 0\n"
+                         "while true {i <- i + 1\nif i = 3 {stop}\nnext\noutput(42)}\n"
+                         "repeat 5 {next\noutput(42)}\n"
+                         "find <- function(a, x) {for i in 0..len(a) - 1 {if a[i] = x "
+                         "{return i}}\nreturn -1}\n"
+                         "output(find([4, 5, 6], 5))\n"
+                         "forever <- function() {while true {return 1}}\n"
+                         "output(forever())"),
+             "1\n2\n4\n5\n1\n2\n1\n1\n");
+    CHECK_FALSE(error_manager.check_error());
+}
+
+TEST_CASE("Virtual machine assignment to void error") {
+    ErrorManager error_manager;
+
+    // Runtime error when assigning the result of a void function
+    CHECK_EQ(run_program(&error_manager, "hello <- function() {}\nhello()\na <- hello()"),
+             "Runtime Error: Invalid assignment to void (line 3, column 1)\n");
+    CHECK_EQ(error_manager.get_error_count(), 1);
+}
+
+TEST_CASE("Virtual machine subscript assignment error") {
+    ErrorManager error_manager;
+
+    // Runtime error when assigning to an array out of its bounds
+    CHECK_EQ(run_program(&error_manager, "a <- [1]\na[1] <- 2"),
+             "Runtime Error: Invalid subscript operation on array (line 2, column 3)\n");
+    CHECK_EQ(error_manager.get_error_count(), 1);
+}
+
+TEST_CASE("Virtual machine range too long error") {
+    ErrorManager error_manager;
+
+    // Runtime error when a range has more elements than an array can hold
+    CHECK_EQ(run_program(&error_manager, "r <- -5..2147483647"),
+             "Runtime Error: Range too long (more than 2147483647 elements) (line 1, column 6)\n");
+    CHECK_EQ(error_manager.get_error_count(), 1);
+}
+
+TEST_CASE("Virtual machine if statement type error") {
+    ErrorManager error_manager;
+
+    // Runtime error when if statement condition is not of type bool
+    CHECK_EQ(run_program(&error_manager, "if 1 {output(42)}"),
+             "Runtime Error: Invalid type for if condition (expected bool, got int) (line 1, "
+             "column 4)\n");
+    CHECK_EQ(error_manager.get_error_count(), 1);
+}
+
+TEST_CASE("Virtual machine for statement type error") {
+    ErrorManager error_manager;
+
+    // Runtime error when for statement iterable is not an array or string
+    CHECK_EQ(run_program(&error_manager, "for i in 1 {output(i)}"),
+             "Runtime Error: Invalid type for iterable (expected array, string or file, got int) "
+             "(line 1, column 10)\n");
+    CHECK_EQ(error_manager.get_error_count(), 1);
+}
+
+TEST_CASE("Virtual machine while statement type error") {
+    ErrorManager error_manager;
+
+    // Runtime error when while statement condition is not of type bool
+    CHECK_EQ(run_program(&error_manager, "while 1 {output(42)}"),
+             "Runtime Error: Invalid type for while condition (expected bool, got int) (line 1, "
+             "column 7)\n");
+    CHECK_EQ(error_manager.get_error_count(), 1);
+}
+
+TEST_CASE("Virtual machine repeat statement type error") {
+    ErrorManager error_manager;
+
+    // Runtime error when repeat statement count is not of type int
+    CHECK_EQ(run_program(&error_manager, "repeat true {output(42)}"),
+             "Runtime Error: Invalid type for repeat count (expected int, got bool) (line 1, "
+             "column 11)\n");
+    CHECK_EQ(error_manager.get_error_count(), 1);
+}
+
+TEST_CASE("Virtual machine built-in function argument count error") {
+    ErrorManager error_manager;
+
+    // Runtime error when function call has too many arguments
+    CHECK_EQ(run_program(&error_manager, "output(42, 42)"),
+             "Runtime Error: Incorrect number of arguments to function 'output' (expected 1, given "
+             "2) (line 1, column 6)\n");
+    CHECK_EQ(error_manager.get_error_count(), 1);
+}
+
+TEST_CASE("Virtual machine function argument count error") {
+    ErrorManager error_manager;
+
+    // Runtime error when function call has too many arguments
+    CHECK_EQ(run_program(&error_manager, "a <- function(a) {}\na(42, 42)"),
+             "Runtime Error: Incorrect number of arguments to function 'a' (expected 1, given 2) "
+             "(line 2, column 1)\n");
+    CHECK_EQ(error_manager.get_error_count(), 1);
+}
+
+TEST_CASE("Virtual machine recursion depth error") {
+    StreamRedirect stream_redirect;
+    ErrorManager error_manager;
+
+    ProgramNode *root = analyze_program(
+        &error_manager, "test.txt", "loop <- function(n) {return loop(n + 1) + 1}\nloop(0)");
+    CompilerVisitor compiler_visitor(root, &error_manager);
+    std::unique_ptr<BytecodeProgram> program(compiler_visitor.compile());
+    VirtualMachine virtual_machine(program.get(), &error_manager);
+    virtual_machine.set_max_call_depth(50);
+
+    // Runtime error when calls are nested deeper than the maximum depth
+    stream_redirect.run([&]() {
+        try {
+            virtual_machine.run();
+        } catch (std::runtime_error &e) {
+        }
+    });
+    CHECK_EQ(error_manager.get_error_count(), 1);
+    CHECK_EQ(stream_redirect.get_string(),
+             "Runtime Error: Maximum recursion depth exceeded (50 nested calls) (line 1, column "
+             "32)\n");
+
+    delete root;
+}
+
+TEST_CASE("Virtual machine matches interpreter") {
+    // Programs produce the same output (and errors) on both engines
+    std::vector<std::string> programs = {
+        "a <- [1, 2, 3]\nfor x in a {a[0] <- a[0] + x}\noutput(a)",
+        "s <- \"\"\nrepeat 3 {s <- s + \"ab\"}\noutput(s)\noutput(s[1])",
+        "x <- 1\noutput((x <- 2) + x)\noutput(x + (x <- 3))",
+        "f <- function(n) {if n = 0 {return 0}\nreturn n + f(n - 1)}\noutput(f(50))",
+        "output(1 + true)",
+        "output(-\"a\")",
+        "output(1..\"a\")",
+        "a <- [1]\noutput(a[3])",
+        "i <- 0\nwhile i < 5 {i <- i + 1\nif i % 2 = 0 {next}\noutput(i)}",
+        "f <- function() {while true {repeat 2 {return 1}}}\noutput(f())\nfor i in 1..2 {next}\n"
+        "repeat 2 {output(42)}",
+        "set <- function(v) {x <- v\nreturn x}\noutput(set(1))\nx <- 2\noutput(set(3))\noutput(x)",
+        "if c <- false {} else {output(c)}\ni <- 0\nwhile (n <- i) < 3 {i <- n + 1}\noutput(i)",
+        "x <- x + 1",
+        "output(false)\noutput(not false and true)\noutput([1, 2] = [1, 3])\noutput([1] != [1])",
+        "output(true and 1)",
+        "r <- 1..5\nq <- r\nq[0] <- 7\noutput(r)\noutput(len(r) + sum(r) + product(3..1))",
+        "r <- 5..1\nfor i in r {if i = 3 {r[0] <- 0}\noutput(i)}\noutput(r + (0..1))\noutput(r[5])",
+        "output(sum(-3..3) = 0 and 0..2 = [0, 1, 2] and [0..1] != [[0, 1]])",
+        "a <- []\nfor i in 1..5 {push(a, i * 2)}\nb <- a\npush(b, 0)\noutput(a)\noutput(a[1..3])\n"
+        "output(a[5..0])\ns <- \"abcdef\"\noutput(s[1..3] + s[2..0])\noutput(a[0..6])",
+        "i <- 0\na <- [1, 2, 3]\noutput(a[i..(i <- 2)])\noutput(push(1, 2))",
+        "s <- \"abc\"\noutput(s[0..1])\noutput(s[0..\"1\"])",
+        "a <- [1, 2, 3]\nb <- [0.5, 2.0, 4.0]\noutput(a - 1)\noutput(a * b)\noutput(b >= 2)\n"
+        "output((1..3) ^ a)\noutput([\"x\", 1] + 1)\noutput(a % [2, 0, 1])",
+        "odd <- false\neven <- function(n) {if n = 0 {return true}\nreturn odd(n - 1)}\n"
+        "odd <- function(n) {if n = 0 {return false}\nreturn even(n - 1)}\noutput(even(7))",
+        "f <- function(n, a) {while true {if n = 0 {return a}\nreturn f(n - 1, a + [n])}}\n"
+        "output(f(4, []))",
+        "g <- function(n) {if n = 0 {return 10}\nreturn g(n - 1)}\n"
+        "f <- function(a, b) {if a = 0 {return b}\nreturn f(a - 1, g(a) + b)}\noutput(f(3, 0))",
+        "f <- function(n) {return f(n, 1)}\noutput(f(1))",
+    };
+
+    for (const std::string &program : programs) {
+        ErrorManager vm_error_manager;
+        ErrorManager tree_error_manager;
+        CHECK_EQ(run_program(&vm_error_manager, program),
+                 interpret_program(&tree_error_manager, program));
+        CHECK_EQ(vm_error_manager.get_error_count(), tree_error_manager.get_error_count());
+    }
+}